@@ -0,0 +1,177 @@
+#include "allocationCounter.hpp"
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace AllocationCounter
+{
+	std::atomic<bool> isCounting = false;
+	std::atomic<std::uint64_t> count = 0;
+
+	void setEnabled(bool isEnabled)
+	{
+		isCounting.store(isEnabled, std::memory_order_relaxed);
+	}
+
+	bool isEnabled()
+	{
+		return isCounting.load(std::memory_order_relaxed);
+	}
+
+	std::uint64_t getCount()
+	{
+		return count.load(std::memory_order_relaxed);
+	}
+
+	void* allocate(std::size_t size) noexcept
+	{
+		if (isCounting.load(std::memory_order_relaxed))
+		{
+			count.fetch_add(1, std::memory_order_relaxed);
+		}
+		return std::malloc(size != 0 ? size : 1);
+	}
+
+	void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept
+	{
+		if (isCounting.load(std::memory_order_relaxed))
+		{
+			count.fetch_add(1, std::memory_order_relaxed);
+		}
+		std::size_t alignmentBytes = static_cast<std::size_t>(alignment);
+		std::size_t alignedSize = (std::max<std::size_t>(size, 1) + alignmentBytes - 1) /
+			alignmentBytes * alignmentBytes;
+#ifdef _WIN32
+		return _aligned_malloc(alignedSize, alignmentBytes);
+#else
+		return std::aligned_alloc(alignmentBytes, alignedSize);
+#endif
+	}
+
+	void freeAligned(void* pointer) noexcept
+	{
+#ifdef _WIN32
+		_aligned_free(pointer);
+#else
+		std::free(pointer);
+#endif
+	}
+}
+
+void* operator new(std::size_t size)
+{
+	void* pointer = AllocationCounter::allocate(size);
+	if (pointer == nullptr)
+	{
+		throw std::bad_alloc{};
+	}
+	return pointer;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return AllocationCounter::allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return AllocationCounter::allocate(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+	std::free(pointer);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	void* pointer = AllocationCounter::allocateAligned(size, alignment);
+	if (pointer == nullptr)
+	{
+		throw std::bad_alloc{};
+	}
+	return pointer;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+	return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return AllocationCounter::allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment,
+	const std::nothrow_t&) noexcept
+{
+	return AllocationCounter::allocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+	AllocationCounter::freeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+	AllocationCounter::freeAligned(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept
+{
+	AllocationCounter::freeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept
+{
+	AllocationCounter::freeAligned(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	AllocationCounter::freeAligned(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	AllocationCounter::freeAligned(pointer);
+}
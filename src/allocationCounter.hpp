@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+
+namespace AllocationCounter
+{
+	void setEnabled(bool isEnabled);
+	bool isEnabled();
+	std::uint64_t getCount();
+}
@@ -0,0 +1,117 @@
+#include "animation/animation.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+template <typename T>
+T interpolate(const T& start, const T& end, float t)
+{
+	return start + (end - start) * t;
+}
+
+Animation::Animation(const RenderSettings& baseSettings) :
+	m_baseSettings{baseSettings}
+{ }
+
+void Animation::addKeyframe(const Keyframe& keyframe)
+{
+	auto position = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), keyframe.time,
+		[] (float time, const Keyframe& other)
+		{
+			return time < other.time;
+		}
+	);
+	m_keyframes.insert(position, keyframe);
+}
+
+float Animation::getDuration() const
+{
+	return m_keyframes.empty() ? 0 : m_keyframes.back().time;
+}
+
+RenderSettings Animation::getFrame(float time) const
+{
+	RenderSettings settings = m_baseSettings;
+	if (m_keyframes.empty())
+	{
+		return settings;
+	}
+
+	auto next = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), time,
+		[] (float time, const Keyframe& keyframe)
+		{
+			return time < keyframe.time;
+		}
+	);
+	const Keyframe& end = next == m_keyframes.end() ? m_keyframes.back() : *next;
+	const Keyframe& start = next == m_keyframes.begin() ? m_keyframes.front() : *(next - 1);
+
+	float span = end.time - start.time;
+	float t = span > 0 ? std::clamp((time - start.time) / span, 0.0f, 1.0f) : 0;
+	settings.camera.targetPos = interpolate(start.camera.targetPos, end.camera.targetPos, t);
+	settings.camera.pitchRad = interpolate(start.camera.pitchRad, end.camera.pitchRad, t);
+	settings.camera.yawRad = interpolate(start.camera.yawRad, end.camera.yawRad, t);
+	settings.camera.viewWidth = interpolate(start.camera.viewWidth, end.camera.viewWidth, t);
+	settings.radii = interpolate(start.radii, end.radii, t);
+	return settings;
+}
+
+std::optional<Animation> Animation::load(const std::filesystem::path& path,
+	const RenderSettings& baseSettings)
+{
+	std::ifstream file{path};
+	if (!file)
+	{
+		std::cerr << "Cannot open " << path << '\n';
+		return std::nullopt;
+	}
+
+	Animation animation{baseSettings};
+	std::string line{};
+	for (int lineNumber = 1; std::getline(file, line); ++lineNumber)
+	{
+		if (line.empty() || line[0] == '#')
+		{
+			continue;
+		}
+
+		std::istringstream values{line};
+		Keyframe keyframe{};
+		if (!(values >> keyframe.time >> keyframe.camera.targetPos.x >>
+			keyframe.camera.targetPos.y >> keyframe.camera.targetPos.z >>
+			keyframe.camera.pitchRad >> keyframe.camera.yawRad >> keyframe.camera.viewWidth >>
+			keyframe.radii.x >> keyframe.radii.y >> keyframe.radii.z))
+		{
+			std::cerr << path.string() << ':' << lineNumber << ": expected time, target x/y/z, "
+				"pitch, yaw, view width and a/b/c\n";
+			return std::nullopt;
+		}
+		animation.addKeyframe(keyframe);
+	}
+	return animation;
+}
+
+Animation Animation::createTurntable(const RenderSettings& baseSettings, float duration)
+{
+	constexpr float pi = glm::pi<float>();
+
+	Animation animation{baseSettings};
+	Keyframe keyframe{0, baseSettings.camera, baseSettings.radii};
+	animation.addKeyframe(keyframe);
+
+	keyframe.time = duration / 2;
+	keyframe.camera.yawRad += pi;
+	keyframe.radii = {baseSettings.radii.y, baseSettings.radii.z, baseSettings.radii.x};
+	animation.addKeyframe(keyframe);
+
+	keyframe.time = duration;
+	keyframe.camera.yawRad += pi;
+	keyframe.radii = baseSettings.radii;
+	animation.addKeyframe(keyframe);
+	return animation;
+}
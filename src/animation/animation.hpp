@@ -0,0 +1,35 @@
+#pragma once
+
+#include "camera.hpp"
+#include "renderSettings.hpp"
+
+#include <glm/glm.hpp>
+
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+class Animation
+{
+public:
+	struct Keyframe
+	{
+		float time{};
+		CameraState camera{};
+		glm::vec3 radii{};
+	};
+
+	Animation(const RenderSettings& baseSettings);
+
+	void addKeyframe(const Keyframe& keyframe);
+	float getDuration() const;
+	RenderSettings getFrame(float time) const;
+
+	static std::optional<Animation> load(const std::filesystem::path& path,
+		const RenderSettings& baseSettings);
+	static Animation createTurntable(const RenderSettings& baseSettings, float duration);
+
+private:
+	RenderSettings m_baseSettings{};
+	std::vector<Keyframe> m_keyframes{};
+};
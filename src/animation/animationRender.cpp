@@ -0,0 +1,292 @@
+#include "animation/animationRender.hpp"
+
+#include "raycaster.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+constexpr std::string_view frameMarker = "FRAME\n";
+constexpr std::array<glm::ivec2, 2> benchmarkResolutions{{{1920, 1080}, {3840, 2160}}};
+
+AnimationRender::AnimationRender(const Animation& animation, const glm::ivec2& resolution,
+	ThreadPool& threadPool) :
+	m_animation{animation},
+	m_resolution{resolution},
+	m_threadPool{threadPool},
+	m_camera{m_resolution, Camera::defaultNearPlane, Camera::defaultFarPlane,
+		Camera::defaultViewWidth},
+	m_renderer{m_resolution}
+{ }
+
+bool AnimationRender::render(std::FILE* output, Format format, int frameCount,
+	int framesPerSecond)
+{
+	using Clock = std::chrono::steady_clock;
+
+	if (output != nullptr && !writeHeader(output, format, framesPerSecond))
+	{
+		return false;
+	}
+
+	m_stats = {};
+	m_stats.frameCount = frameCount;
+	m_isWriteFailed = false;
+	for (FrameSlot& slot : m_slots)
+	{
+		slot.isFull = false;
+	}
+
+	Clock::time_point start = Clock::now();
+	std::thread writer{[this, output, format, frameCount] ()
+		{
+			writeFrames(output, format, frameCount);
+		}
+	};
+
+	double raycastSeconds = 0;
+	std::optional<RenderSettings> previousSettings{};
+	for (int frame = 0; frame < frameCount; ++frame)
+	{
+		RenderSettings settings =
+			m_animation.getFrame(static_cast<float>(frame) / framesPerSecond);
+		settings.resolution = m_resolution;
+		if (settings != previousSettings)
+		{
+			Clock::time_point raycastStart = Clock::now();
+			settings.apply(m_camera, m_ellipsoid);
+			Raycaster raycaster{m_camera, m_ellipsoid};
+			m_renderer.drawPass(raycaster, 1, true, m_threadPool);
+			if (settings.antialiasingSamples > 1)
+			{
+				m_renderer.antialias(raycaster, settings.antialiasingSamples, m_threadPool);
+			}
+			raycastSeconds += std::chrono::duration<double>(Clock::now() - raycastStart).count();
+			previousSettings = settings;
+		}
+		else
+		{
+			++m_stats.reusedFrameCount;
+		}
+
+		FrameSlot& slot = m_slots[frame % m_slots.size()];
+		std::unique_lock<std::mutex> lock{m_slotMutex};
+		m_slotCondition.wait(lock, [this, &slot] ()
+			{
+				return !slot.isFull || m_isWriteFailed;
+			}
+		);
+		if (m_isWriteFailed)
+		{
+			break;
+		}
+		lock.unlock();
+
+		std::span<const unsigned char> cpuTexture = m_renderer.getCpuTexture();
+		slot.pixels.assign(cpuTexture.begin(), cpuTexture.end());
+
+		lock.lock();
+		slot.isFull = true;
+		m_slotCondition.notify_all();
+	}
+	writer.join();
+
+	m_stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	m_stats.framesPerSecond = m_stats.seconds > 0 ? frameCount / m_stats.seconds : 0;
+	m_stats.raycastMsPerFrame = frameCount > 0 ? raycastSeconds * 1000 / frameCount : 0;
+	return !m_isWriteFailed;
+}
+
+const AnimationRender::Stats& AnimationRender::getStats() const
+{
+	return m_stats;
+}
+
+int AnimationRender::run(const CommandLine& commandLine)
+{
+	RenderSettings baseSettings = RenderSettings::fromCommandLine(commandLine);
+	if (commandLine.hasOption("benchmark"))
+	{
+		return benchmark(commandLine, baseSettings);
+	}
+
+	int framesPerSecond = std::max(commandLine.getInt("fps", 30), 1);
+	std::optional<Animation> animation = commandLine.hasOption("path") ?
+		Animation::load(commandLine.getString("path", ""), baseSettings) :
+		Animation::createTurntable(baseSettings, commandLine.getFloat("duration", 4.0f));
+	if (!animation)
+	{
+		return 1;
+	}
+	int frameCount = commandLine.getInt("frames",
+		std::max(static_cast<int>(std::ceil(animation->getDuration() * framesPerSecond)), 1));
+	Format format = commandLine.getString("format", "y4m") == "rgb" ? Format::rgb : Format::y4m;
+
+	std::string outputPath = commandLine.getString("output", "-");
+	std::FILE* output = stdout;
+	if (outputPath == "-")
+	{
+#ifdef _WIN32
+		_setmode(_fileno(stdout), _O_BINARY);
+#endif
+	}
+	else
+	{
+		output = std::fopen(outputPath.c_str(), "wb");
+		if (output == nullptr)
+		{
+			std::cerr << "Cannot open " << outputPath << '\n';
+			return 1;
+		}
+	}
+
+	ThreadPool threadPool{commandLine.getInt("threads", ThreadPool::defaultThreadCount())};
+	AnimationRender animationRender{*animation, baseSettings.resolution, threadPool};
+	bool isRendered = animationRender.render(output, format, frameCount, framesPerSecond);
+	if (output != stdout)
+	{
+		isRendered = std::fclose(output) == 0 && isRendered;
+	}
+	if (!isRendered)
+	{
+		std::cerr << "Cannot write " << outputPath << '\n';
+		return 1;
+	}
+
+	const Stats& stats = animationRender.getStats();
+	std::ostream& report = output == stdout ? std::cerr : std::cout;
+	report << stats.frameCount << " frames at " << baseSettings.resolution.x << 'x' <<
+		baseSettings.resolution.y << ", " << stats.reusedFrameCount << " reused\n";
+	report << "time: " << stats.seconds << " s, " << stats.framesPerSecond << " frames/s\n";
+	report << "raycast: " << stats.raycastMsPerFrame << " ms/frame, convert and write: " <<
+		stats.writeMsPerFrame << " ms/frame\n";
+	return 0;
+}
+
+void AnimationRender::writeFrames(std::FILE* output, Format format, int frameCount)
+{
+	using Clock = std::chrono::steady_clock;
+
+	double writeSeconds = 0;
+	for (int frame = 0; frame < frameCount; ++frame)
+	{
+		FrameSlot& slot = m_slots[frame % m_slots.size()];
+		{
+			std::unique_lock<std::mutex> lock{m_slotMutex};
+			m_slotCondition.wait(lock, [&slot] ()
+				{
+					return slot.isFull;
+				}
+			);
+		}
+
+		Clock::time_point writeStart = Clock::now();
+		convertFrame(slot.pixels, format);
+		bool isWritten = output == nullptr ||
+			std::fwrite(m_outputBuffer.data(), 1, m_outputBuffer.size(), output) ==
+			m_outputBuffer.size();
+		writeSeconds += std::chrono::duration<double>(Clock::now() - writeStart).count();
+
+		std::lock_guard<std::mutex> lock{m_slotMutex};
+		slot.isFull = false;
+		m_isWriteFailed = !isWritten;
+		m_slotCondition.notify_all();
+		if (m_isWriteFailed)
+		{
+			break;
+		}
+	}
+	m_stats.writeMsPerFrame = frameCount > 0 ? writeSeconds * 1000 / frameCount : 0;
+}
+
+void AnimationRender::convertFrame(const std::vector<unsigned char>& pixels, Format format)
+{
+	const std::size_t width = m_resolution.x;
+	const std::size_t height = m_resolution.y;
+	const std::size_t rowSize = width * Renderer::numOfChannels;
+	if (format == Format::rgb)
+	{
+		m_outputBuffer.resize(pixels.size());
+		for (std::size_t y = 0; y < height; ++y)
+		{
+			std::memcpy(m_outputBuffer.data() + (height - 1 - y) * rowSize,
+				pixels.data() + y * rowSize, rowSize);
+		}
+		return;
+	}
+
+	const std::size_t pixelCount = width * height;
+	m_outputBuffer.assign(frameMarker.begin(), frameMarker.end());
+	m_outputBuffer.resize(frameMarker.size() + 3 * pixelCount);
+	unsigned char* lumaPlane = m_outputBuffer.data() + frameMarker.size();
+	unsigned char* blueChromaPlane = lumaPlane + pixelCount;
+	unsigned char* redChromaPlane = blueChromaPlane + pixelCount;
+	for (std::size_t y = 0; y < height; ++y)
+	{
+		const unsigned char* source = pixels.data() + y * rowSize;
+		std::size_t destination = (height - 1 - y) * width;
+		for (std::size_t x = 0; x < width; ++x)
+		{
+			int red = source[x * Renderer::numOfChannels];
+			int green = source[x * Renderer::numOfChannels + 1];
+			int blue = source[x * Renderer::numOfChannels + 2];
+			int luma = ((66 * red + 129 * green + 25 * blue + 128) >> 8) + 16;
+			int blueChroma = ((-38 * red - 74 * green + 112 * blue + 128) >> 8) + 128;
+			int redChroma = ((112 * red - 94 * green - 18 * blue + 128) >> 8) + 128;
+			lumaPlane[destination + x] = static_cast<unsigned char>(luma);
+			blueChromaPlane[destination + x] = static_cast<unsigned char>(blueChroma);
+			redChromaPlane[destination + x] = static_cast<unsigned char>(redChroma);
+		}
+	}
+}
+
+bool AnimationRender::writeHeader(std::FILE* output, Format format, int framesPerSecond) const
+{
+	if (format == Format::rgb)
+	{
+		return true;
+	}
+
+	std::string header = "YUV4MPEG2 W" + std::to_string(m_resolution.x) + " H" +
+		std::to_string(m_resolution.y) + " F" + std::to_string(framesPerSecond) +
+		":1 Ip A1:1 C444\n";
+	return std::fwrite(header.data(), 1, header.size(), output) == header.size();
+}
+
+int AnimationRender::benchmark(const CommandLine& commandLine, const RenderSettings& baseSettings)
+{
+	int framesPerSecond = std::max(commandLine.getInt("fps", 30), 1);
+	int frameCount = std::max(commandLine.getInt("frames", 60), 1);
+	ThreadPool threadPool{commandLine.getInt("threads", ThreadPool::defaultThreadCount())};
+
+	for (const glm::ivec2& resolution : benchmarkResolutions)
+	{
+		RenderSettings settings = baseSettings;
+		settings.resolution = resolution;
+		Animation animation = Animation::createTurntable(settings,
+			static_cast<float>(frameCount) / framesPerSecond);
+		AnimationRender animationRender{animation, resolution, threadPool};
+		animationRender.render(nullptr, Format::y4m, frameCount, framesPerSecond);
+
+		const Stats& stats = animationRender.getStats();
+		std::cout << resolution.x << 'x' << resolution.y << ": " << stats.framesPerSecond <<
+			" frames/s sustained over " << stats.frameCount << " frames (raycast " <<
+			stats.raycastMsPerFrame << " ms/frame, convert " << stats.writeMsPerFrame <<
+			" ms/frame)\n";
+	}
+	return 0;
+}
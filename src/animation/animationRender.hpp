@@ -0,0 +1,71 @@
+#pragma once
+
+#include "animation/animation.hpp"
+#include "camera.hpp"
+#include "commandLine.hpp"
+#include "ellipsoid.hpp"
+#include "renderer.hpp"
+#include "threadPool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+class AnimationRender
+{
+public:
+	enum class Format
+	{
+		y4m,
+		rgb
+	};
+
+	struct Stats
+	{
+		int frameCount{};
+		int reusedFrameCount{};
+		double seconds{};
+		double framesPerSecond{};
+		double raycastMsPerFrame{};
+		double writeMsPerFrame{};
+	};
+
+	AnimationRender(const Animation& animation, const glm::ivec2& resolution,
+		ThreadPool& threadPool);
+
+	bool render(std::FILE* output, Format format, int frameCount, int framesPerSecond);
+	const Stats& getStats() const;
+
+	static int run(const CommandLine& commandLine);
+
+private:
+	struct FrameSlot
+	{
+		std::vector<unsigned char> pixels{};
+		bool isFull = false;
+	};
+
+	const Animation& m_animation;
+	glm::ivec2 m_resolution{};
+	ThreadPool& m_threadPool;
+	Camera m_camera;
+	Ellipsoid m_ellipsoid{1, 1, 1};
+	Renderer m_renderer;
+
+	std::array<FrameSlot, 2> m_slots{};
+	std::mutex m_slotMutex{};
+	std::condition_variable m_slotCondition{};
+	bool m_isWriteFailed = false;
+	std::vector<unsigned char> m_outputBuffer{};
+	Stats m_stats{};
+
+	void writeFrames(std::FILE* output, Format format, int frameCount);
+	void convertFrame(const std::vector<unsigned char>& pixels, Format format);
+	bool writeHeader(std::FILE* output, Format format, int framesPerSecond) const;
+
+	static int benchmark(const CommandLine& commandLine, const RenderSettings& baseSettings);
+};
@@ -0,0 +1,172 @@
+#include "backends/backendComparison.hpp"
+
+#include "backends/glslRenderBackend.hpp"
+#include "camera.hpp"
+#include "ellipsoid.hpp"
+#include "quad.hpp"
+#include "raycaster.hpp"
+#include "renderer.hpp"
+#include "shaderPrograms.hpp"
+
+#include <glad/glad.h>
+#include <glfw/glfw3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <span>
+
+BackendComparison::BackendComparison(const RenderSettings& settings, ThreadPool& threadPool) :
+	m_settings{settings},
+	m_threadPool{threadPool}
+{
+	glGenRenderbuffers(1, &m_colorBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, m_settings.resolution.x,
+		m_settings.resolution.y);
+
+	glGenFramebuffers(1, &m_framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER,
+		m_colorBuffer);
+}
+
+BackendComparison::~BackendComparison()
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glDeleteFramebuffers(1, &m_framebuffer);
+	glDeleteRenderbuffers(1, &m_colorBuffer);
+}
+
+bool BackendComparison::compare(int frameCount)
+{
+	std::vector<unsigned char> cpuPixels = renderCpu(frameCount);
+	std::vector<unsigned char> glslPixels = renderGlsl(frameCount);
+
+	m_stats.maxChannelDifference = 0;
+	m_stats.mismatchedPixelCount = 0;
+	for (std::size_t i = 0; i < cpuPixels.size(); i += Renderer::numOfChannels)
+	{
+		int pixelDifference = 0;
+		for (int channel = 0; channel < Renderer::numOfChannels; ++channel)
+		{
+			pixelDifference = std::max(pixelDifference,
+				std::abs(cpuPixels[i + channel] - glslPixels[i + channel]));
+		}
+		m_stats.maxChannelDifference = std::max(m_stats.maxChannelDifference, pixelDifference);
+		if (pixelDifference > channelTolerance)
+		{
+			++m_stats.mismatchedPixelCount;
+		}
+	}
+
+	std::size_t pixelCount = cpuPixels.size() / Renderer::numOfChannels;
+	m_stats.mismatchedPixelFraction =
+		pixelCount > 0 ? static_cast<double>(m_stats.mismatchedPixelCount) / pixelCount : 0;
+	return m_stats.mismatchedPixelFraction <= maxMismatchedPixelFraction;
+}
+
+const BackendComparison::Stats& BackendComparison::getStats() const
+{
+	return m_stats;
+}
+
+int BackendComparison::run(const CommandLine& commandLine)
+{
+	RenderSettings settings = RenderSettings::fromCommandLine(commandLine);
+	int frameCount = std::max(commandLine.getInt("frames", 10), 1);
+
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 2);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	GLFWwindow* window = glfwCreateWindow(1, 1, "ellipsoid-raycasting", nullptr, nullptr);
+	if (window == nullptr)
+	{
+		std::cerr << "Cannot create an OpenGL 4.2 context\n";
+		glfwTerminate();
+		return 1;
+	}
+	glfwMakeContextCurrent(window);
+	gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress));
+	ShaderPrograms::init();
+
+	bool isMatching{};
+	{
+		ThreadPool threadPool{commandLine.getInt("threads", ThreadPool::defaultThreadCount())};
+		BackendComparison comparison{settings, threadPool};
+		isMatching = comparison.compare(frameCount);
+
+		const Stats& stats = comparison.getStats();
+		std::cout << "renderer: " << glGetString(GL_RENDERER) << '\n';
+		std::cout << "resolution: " << settings.resolution.x << 'x' << settings.resolution.y <<
+			", " << frameCount << " frames\n";
+		std::cout << "max channel difference: " << stats.maxChannelDifference <<
+			", pixels above tolerance: " << stats.mismatchedPixelCount << " (" <<
+			stats.mismatchedPixelFraction * 100 << "%)\n";
+		std::cout << "cpu: " << stats.cpuFrameTimeMs << " ms/frame, glsl: " <<
+			stats.glslFrameTimeMs << " ms/frame\n";
+		std::cout << (isMatching ? "backends match\n" : "backends differ\n");
+	}
+
+	glfwTerminate();
+	return isMatching ? 0 : 1;
+}
+
+std::vector<unsigned char> BackendComparison::renderCpu(int frameCount)
+{
+	using Clock = std::chrono::steady_clock;
+
+	glm::ivec2 viewportSize = m_settings.resolution;
+	Camera camera{viewportSize, Camera::defaultNearPlane, Camera::defaultFarPlane,
+		m_settings.camera.viewWidth};
+	Ellipsoid ellipsoid{m_settings.radii.x, m_settings.radii.y, m_settings.radii.z};
+	m_settings.apply(camera, ellipsoid);
+	Renderer renderer{viewportSize};
+
+	Clock::time_point start = Clock::now();
+	for (int frame = 0; frame < frameCount; ++frame)
+	{
+		renderer.drawPass(Raycaster{camera, ellipsoid}, 1, true, m_threadPool);
+	}
+	m_stats.cpuFrameTimeMs =
+		std::chrono::duration<double, std::milli>(Clock::now() - start).count() / frameCount;
+	std::span<const unsigned char> cpuTexture = renderer.getCpuTexture();
+	return {cpuTexture.begin(), cpuTexture.end()};
+}
+
+std::vector<unsigned char> BackendComparison::renderGlsl(int frameCount)
+{
+	using Clock = std::chrono::steady_clock;
+
+	glm::ivec2 viewportSize = m_settings.resolution;
+	Camera camera{viewportSize, Camera::defaultNearPlane, Camera::defaultFarPlane,
+		m_settings.camera.viewWidth};
+	Ellipsoid ellipsoid{m_settings.radii.x, m_settings.radii.y, m_settings.radii.z};
+	m_settings.apply(camera, ellipsoid);
+	Quad quad{};
+	GlslRenderBackend backend{viewportSize, quad};
+
+	glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+	glViewport(0, 0, viewportSize.x, viewportSize.y);
+	backend.render(Raycaster{camera, ellipsoid});
+	glFinish();
+
+	Clock::time_point start = Clock::now();
+	for (int frame = 0; frame < frameCount; ++frame)
+	{
+		backend.render(Raycaster{camera, ellipsoid});
+	}
+	glFinish();
+	m_stats.glslFrameTimeMs =
+		std::chrono::duration<double, std::milli>(Clock::now() - start).count() / frameCount;
+
+	std::vector<unsigned char> pixels(static_cast<std::size_t>(viewportSize.x) * viewportSize.y *
+		Renderer::numOfChannels);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, viewportSize.x, viewportSize.y, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+	return pixels;
+}
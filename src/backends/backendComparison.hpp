@@ -0,0 +1,46 @@
+#pragma once
+
+#include "commandLine.hpp"
+#include "renderSettings.hpp"
+#include "threadPool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+class BackendComparison
+{
+public:
+	struct Stats
+	{
+		int maxChannelDifference{};
+		int mismatchedPixelCount{};
+		double mismatchedPixelFraction{};
+		double cpuFrameTimeMs{};
+		double glslFrameTimeMs{};
+	};
+
+	static constexpr int channelTolerance = 2;
+	static constexpr double maxMismatchedPixelFraction = 0.001;
+
+	BackendComparison(const RenderSettings& settings, ThreadPool& threadPool);
+	BackendComparison(const BackendComparison&) = delete;
+	~BackendComparison();
+
+	BackendComparison& operator=(const BackendComparison&) = delete;
+
+	bool compare(int frameCount);
+	const Stats& getStats() const;
+
+	static int run(const CommandLine& commandLine);
+
+private:
+	RenderSettings m_settings{};
+	ThreadPool& m_threadPool;
+	unsigned int m_framebuffer{};
+	unsigned int m_colorBuffer{};
+	Stats m_stats{};
+
+	std::vector<unsigned char> renderCpu(int frameCount);
+	std::vector<unsigned char> renderGlsl(int frameCount);
+};
@@ -0,0 +1,404 @@
+#include "backends/cpuRenderBackend.hpp"
+
+#include "sampleOrder.hpp"
+#include "shaderPrograms.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <span>
+
+CpuRenderBackend::CpuRenderBackend(const glm::ivec2& viewportSize, Quad& quad,
+	ThreadPool& threadPool) :
+	m_viewportSize{viewportSize},
+	m_quad{quad},
+	m_texture{viewportSize},
+	m_threadPool{threadPool},
+	m_renderer{viewportSize},
+	m_speculativeRenderer{viewportSize}
+{ }
+
+void CpuRenderBackend::render(const Raycaster& raycaster)
+{
+	using Clock = std::chrono::steady_clock;
+
+	if (m_isResizePending)
+	{
+		if (Clock::now() - m_resizeTime < resizeSettleTime)
+		{
+			present();
+			return;
+		}
+		applyViewportSize();
+	}
+
+	if (m_isCacheLookupPending)
+	{
+		m_isCacheLookupPending = false;
+		if (loadCachedFrame(raycaster))
+		{
+			present();
+			return;
+		}
+		loadSpeculativeFrame();
+	}
+	else if (m_isCacheLoadPending && !m_frameCache->isLoading(*m_cacheKey))
+	{
+		m_isCacheLoadPending = false;
+		if (loadCachedFrame(raycaster))
+		{
+			present();
+			return;
+		}
+	}
+
+	bool isCounting = m_threadPool.areCountersEnabled() && !isConverged();
+	if (isCounting)
+	{
+		startCounters();
+	}
+
+	if (m_refinement == Refinement::blueNoise && m_sampleRank < SampleOrder::rankCount)
+	{
+		Clock::time_point start = Clock::now();
+		int endRank = std::min(m_sampleRank + std::max(m_sampleBatch, m_sampleRank),
+			SampleOrder::rankCount);
+		m_renderer.drawSamples(raycaster, m_sampleRank, endRank, m_threadPool);
+		m_frameTimeMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+		m_texture.overwrite(m_renderer.getCpuTexture());
+		m_sampleRank = endRank;
+	}
+	else if (m_refinement == Refinement::grid && m_pixelSize > 0)
+	{
+		Clock::time_point start = Clock::now();
+		m_renderer.drawPass(raycaster, m_pixelSize, m_pixelSize == getMaxPixelSize(),
+			m_threadPool);
+		if (m_pixelSize == 1)
+		{
+			m_frameTimeMs =
+				std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+		}
+		if (m_speculativePixelSize == 0 || m_pixelSize <= m_speculativePixelSize)
+		{
+			m_texture.overwrite(m_renderer.getCpuTexture());
+			m_speculativePixelSize = 0;
+		}
+		m_pixelSize /= 2;
+	}
+	else if (!m_isAntialiased && m_antialiasingSamples > 1)
+	{
+		m_renderer.antialias(raycaster, m_antialiasingSamples, m_threadPool);
+		m_texture.overwrite(m_renderer.getCpuTexture());
+		m_isAntialiased = true;
+	}
+
+	if (isCounting)
+	{
+		stopCounters();
+	}
+	if (m_cacheKey.has_value() && isConverged())
+	{
+		storeCachedFrame();
+	}
+	present();
+}
+
+void CpuRenderBackend::updateViewportSize()
+{
+	m_isResizePending = true;
+	m_resizeTime = std::chrono::steady_clock::now();
+	m_reservedSize = glm::max(m_reservedSize, m_viewportSize);
+}
+
+void CpuRenderBackend::refresh()
+{
+	m_pixelSize = getMaxPixelSize();
+	m_sampleRank = 0;
+	m_isAntialiased = false;
+	m_isCacheLookupPending = true;
+	m_isCacheLoadPending = false;
+	m_cacheKey.reset();
+	m_speculativePixelSize = 0;
+}
+
+float CpuRenderBackend::getFrameTimeMs() const
+{
+	return m_frameTimeMs;
+}
+
+bool CpuRenderBackend::isConverged() const
+{
+	bool isRefined = m_refinement == Refinement::blueNoise ?
+		m_sampleRank >= SampleOrder::rankCount : m_pixelSize == 0;
+	return !m_isResizePending && isRefined && (m_isAntialiased || m_antialiasingSamples <= 1);
+}
+
+void CpuRenderBackend::present()
+{
+	m_texture.use();
+	ShaderPrograms::quad->use();
+	ShaderPrograms::quad->setUniform("textureScale", m_texture.getScale());
+	m_quad.render();
+}
+
+int CpuRenderBackend::getAccuracy() const
+{
+	return m_maxPixelSizeExponent;
+}
+
+void CpuRenderBackend::setAccuracy(int maxPixelSizeExponent)
+{
+	m_maxPixelSizeExponent = maxPixelSizeExponent;
+	refresh();
+}
+
+int CpuRenderBackend::getAntialiasing() const
+{
+	return m_antialiasingSamples;
+}
+
+void CpuRenderBackend::setAntialiasing(int antialiasingSamples)
+{
+	m_antialiasingSamples = antialiasingSamples;
+	refresh();
+}
+
+CpuRenderBackend::Refinement CpuRenderBackend::getRefinement() const
+{
+	return m_refinement;
+}
+
+void CpuRenderBackend::setRefinement(Refinement refinement)
+{
+	m_refinement = refinement;
+	refresh();
+}
+
+int CpuRenderBackend::getSampleBatch() const
+{
+	return m_sampleBatch;
+}
+
+void CpuRenderBackend::setSampleBatch(int sampleBatch)
+{
+	m_sampleBatch = sampleBatch;
+	refresh();
+}
+
+void CpuRenderBackend::setTraversal(Renderer::Traversal traversal, int tileSize)
+{
+	m_renderer.setTraversal(traversal);
+	m_renderer.setTileSize(tileSize);
+	refresh();
+}
+
+bool CpuRenderBackend::isResizePending() const
+{
+	return m_isResizePending;
+}
+
+float CpuRenderBackend::getMeanTileLightCount() const
+{
+	return m_renderer.getMeanTileLightCount();
+}
+
+bool CpuRenderBackend::isLightCullingEnabled() const
+{
+	return m_renderer.isLightCullingEnabled();
+}
+
+void CpuRenderBackend::setFrameCache(FrameCache* frameCache)
+{
+	m_frameCache = frameCache;
+	m_isCacheLookupPending = true;
+	m_isCacheLoadPending = false;
+}
+
+const PerfCounters::Sample& CpuRenderBackend::getFrameCounters() const
+{
+	return m_frameCounters;
+}
+
+void CpuRenderBackend::setPose(const CameraState& pose, std::uint64_t sceneKey,
+	float poseToleranceRad)
+{
+	m_pose = pose;
+	m_sceneKey = sceneKey;
+	m_poseToleranceRad = poseToleranceRad;
+}
+
+bool CpuRenderBackend::speculate(const Raycaster& raycaster, const CameraState& pose,
+	std::chrono::steady_clock::time_point deadline)
+{
+	using Clock = std::chrono::steady_clock;
+
+	if (m_isResizePending || m_refinement != Refinement::grid)
+	{
+		return false;
+	}
+
+	SpeculativeFramePool::Frame* frame = m_speculativePool.find(pose, m_sceneKey);
+	if (frame == nullptr)
+	{
+		frame = &m_speculativePool.acquire(pose, m_sceneKey, m_viewportSize);
+	}
+	if (frame != m_speculativeFrame)
+	{
+		if (frame->pixelSize > 0)
+		{
+			m_speculativeRenderer.load(frame->pixels, frame->hitMask, m_threadPool);
+		}
+		m_speculativeFrame = frame;
+	}
+
+	while (frame->pixelSize != 1 && Clock::now() < deadline)
+	{
+		int pixelSize = frame->pixelSize > 0 ? frame->pixelSize / 2 : getMaxPixelSize();
+		Clock::time_point start = Clock::now();
+		m_speculativeRenderer.drawPass(raycaster, pixelSize, pixelSize == getMaxPixelSize(),
+			m_threadPool);
+		m_speculativePool.store(*frame, m_speculativeRenderer.getCpuTexture(),
+			m_speculativeRenderer.getHitMask(), pixelSize,
+			std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+	}
+	return frame->pixelSize == 1;
+}
+
+void CpuRenderBackend::clearSpeculativeFrames()
+{
+	m_speculativePool.clear();
+}
+
+const SpeculativeFramePool& CpuRenderBackend::getSpeculativeFramePool() const
+{
+	return m_speculativePool;
+}
+
+void CpuRenderBackend::resetSpeculationStats()
+{
+	m_speculativePool.resetStats();
+}
+
+void CpuRenderBackend::applyViewportSize()
+{
+	m_texture.rescale(m_viewportSize);
+	m_renderer.reserve(m_reservedSize);
+	m_renderer.updateViewportSize();
+	m_speculativeRenderer.reserve(m_reservedSize);
+	m_speculativeRenderer.updateViewportSize();
+	m_speculativePool.clear();
+	m_speculativeFrame = nullptr;
+	m_isResizePending = false;
+	refresh();
+}
+
+bool CpuRenderBackend::loadCachedFrame(const Raycaster& raycaster)
+{
+	if (m_frameCache == nullptr)
+	{
+		return false;
+	}
+
+	std::uint64_t key = FrameCache::calcKey(raycaster, m_viewportSize, m_antialiasingSamples,
+		m_renderer.isLightCullingEnabled());
+	std::shared_ptr<const FrameCache::Entry> entry = m_frameCache->find(key);
+	if (entry == nullptr || entry->size != m_viewportSize)
+	{
+		m_cacheKey = key;
+		m_isCacheLoadPending = entry == nullptr && m_frameCache->isLoading(key);
+		return false;
+	}
+
+	m_cacheKey.reset();
+	m_renderer.load(entry->pixels, entry->hitMask, m_threadPool);
+	m_texture.overwrite(m_renderer.getCpuTexture());
+	m_pixelSize = 0;
+	m_sampleRank = SampleOrder::rankCount;
+	m_isAntialiased = true;
+	return true;
+}
+
+void CpuRenderBackend::storeCachedFrame()
+{
+	m_frameCache->insert(*m_cacheKey, m_viewportSize, m_renderer.getCpuTexture(),
+		m_renderer.getHitMask());
+	m_cacheKey.reset();
+	m_isCacheLoadPending = false;
+}
+
+bool CpuRenderBackend::loadSpeculativeFrame()
+{
+	if (m_refinement != Refinement::grid)
+	{
+		return false;
+	}
+
+	const SpeculativeFramePool::Frame* frame =
+		m_speculativePool.findNearest(m_pose, m_sceneKey, m_poseToleranceRad);
+	if (frame == nullptr || frame->size != m_viewportSize)
+	{
+		return false;
+	}
+
+	reproject(*frame);
+	m_texture.overwrite(m_reprojectedPixels);
+	m_speculativePixelSize = frame->pixelSize;
+	return true;
+}
+
+void CpuRenderBackend::reproject(const SpeculativeFramePool::Frame& frame)
+{
+	const float scale = m_pose.viewWidth / frame.pose.viewWidth;
+	const glm::vec2 center = glm::vec2{m_viewportSize} / 2.0f;
+	m_reprojectedPixels.resize(frame.pixels.size());
+	m_threadPool.parallelFor(m_viewportSize.y,
+		[this, &frame, scale, center] (int y)
+		{
+			int sourceY = static_cast<int>(std::floor((y + 0.5f - center.y) * scale + center.y));
+			for (int x = 0; x < m_viewportSize.x; ++x)
+			{
+				int sourceX =
+					static_cast<int>(std::floor((x + 0.5f - center.x) * scale + center.x));
+				unsigned char* pixel =
+					&m_reprojectedPixels[Renderer::numOfChannels * (y * m_viewportSize.x + x)];
+				if (sourceX < 0 || sourceY < 0 || sourceX >= m_viewportSize.x ||
+					sourceY >= m_viewportSize.y)
+				{
+					for (int channel = 0; channel < Renderer::numOfChannels; ++channel)
+					{
+						pixel[channel] = static_cast<unsigned char>(
+							Renderer::backgroundColor[channel]);
+					}
+					continue;
+				}
+				std::copy_n(&frame.pixels[Renderer::numOfChannels *
+					(sourceY * m_viewportSize.x + sourceX)], Renderer::numOfChannels, pixel);
+			}
+		}
+	);
+}
+
+void CpuRenderBackend::startCounters()
+{
+	if (!m_passCounters.has_value())
+	{
+		m_passCounters.emplace();
+	}
+	m_threadPool.resetCounters();
+	m_passCounters->start();
+}
+
+void CpuRenderBackend::stopCounters()
+{
+	m_frameCounters = m_passCounters->stop();
+	for (const PerfCounters::Sample& workerCounters : m_threadPool.getWorkerCounters())
+	{
+		m_frameCounters.add(workerCounters);
+	}
+}
+
+int CpuRenderBackend::getMaxPixelSize() const
+{
+	return 1 << m_maxPixelSizeExponent;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "backends/renderBackend.hpp"
+#include "camera.hpp"
+#include "frameCache.hpp"
+#include "perfCounters.hpp"
+#include "quad.hpp"
+#include "raycaster.hpp"
+#include "renderer.hpp"
+#include "speculativeFramePool.hpp"
+#include "texture.hpp"
+#include "threadPool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+class CpuRenderBackend : public RenderBackend
+{
+public:
+	enum class Refinement
+	{
+		grid,
+		blueNoise
+	};
+
+	static constexpr std::chrono::milliseconds resizeSettleTime{150};
+
+	CpuRenderBackend(const glm::ivec2& viewportSize, Quad& quad, ThreadPool& threadPool);
+
+	void render(const Raycaster& raycaster) override;
+	void updateViewportSize() override;
+	void refresh() override;
+	float getFrameTimeMs() const override;
+	bool isConverged() const override;
+	void present();
+
+	int getAccuracy() const;
+	void setAccuracy(int maxPixelSizeExponent);
+	int getAntialiasing() const;
+	void setAntialiasing(int antialiasingSamples);
+	Refinement getRefinement() const;
+	void setRefinement(Refinement refinement);
+	int getSampleBatch() const;
+	void setSampleBatch(int sampleBatch);
+	void setTraversal(Renderer::Traversal traversal, int tileSize);
+	bool isResizePending() const;
+	float getMeanTileLightCount() const;
+	bool isLightCullingEnabled() const;
+	void setFrameCache(FrameCache* frameCache);
+	const PerfCounters::Sample& getFrameCounters() const;
+	void setPose(const CameraState& pose, std::uint64_t sceneKey, float poseToleranceRad);
+	bool speculate(const Raycaster& raycaster, const CameraState& pose,
+		std::chrono::steady_clock::time_point deadline);
+	void clearSpeculativeFrames();
+	const SpeculativeFramePool& getSpeculativeFramePool() const;
+	void resetSpeculationStats();
+
+private:
+	const glm::ivec2& m_viewportSize;
+	Quad& m_quad;
+	Texture m_texture;
+	ThreadPool& m_threadPool;
+	Renderer m_renderer;
+	Renderer m_speculativeRenderer;
+
+	int m_maxPixelSizeExponent = 4;
+	int m_pixelSize = getMaxPixelSize();
+	int m_antialiasingSamples = 3;
+	bool m_isAntialiased = false;
+	Refinement m_refinement = Refinement::grid;
+	int m_sampleBatch = 16;
+	int m_sampleRank = 0;
+	float m_frameTimeMs{};
+
+	bool m_isResizePending = false;
+	std::chrono::steady_clock::time_point m_resizeTime{};
+	glm::ivec2 m_reservedSize{};
+
+	FrameCache* m_frameCache{};
+	bool m_isCacheLookupPending = true;
+	bool m_isCacheLoadPending = false;
+	std::optional<std::uint64_t> m_cacheKey{};
+
+	std::optional<PerfCounters> m_passCounters{};
+	PerfCounters::Sample m_frameCounters{};
+
+	SpeculativeFramePool m_speculativePool{};
+	SpeculativeFramePool::Frame* m_speculativeFrame{};
+	CameraState m_pose{};
+	std::uint64_t m_sceneKey{};
+	float m_poseToleranceRad{};
+	int m_speculativePixelSize{};
+	std::vector<unsigned char> m_reprojectedPixels{};
+
+	void applyViewportSize();
+	bool loadCachedFrame(const Raycaster& raycaster);
+	void storeCachedFrame();
+	bool loadSpeculativeFrame();
+	void reproject(const SpeculativeFramePool::Frame& frame);
+	void startCounters();
+	void stopCounters();
+	int getMaxPixelSize() const;
+};
@@ -0,0 +1,112 @@
+#include "backends/glslRenderBackend.hpp"
+
+#include "renderer.hpp"
+#include "shaderPrograms.hpp"
+
+#include <glad/glad.h>
+
+GlslRenderBackend::GlslRenderBackend(const glm::ivec2& viewportSize, Quad& quad) :
+	m_viewportSize{viewportSize},
+	m_quad{quad}
+{
+	glGenQueries(1, &m_timerQuery);
+}
+
+GlslRenderBackend::~GlslRenderBackend()
+{
+	glDeleteQueries(1, &m_timerQuery);
+}
+
+void GlslRenderBackend::render(const Raycaster& raycaster)
+{
+	readTimerQuery();
+	bool isTimed = !m_isTimerQueryPending;
+	if (isTimed)
+	{
+		glBeginQuery(GL_TIME_ELAPSED, m_timerQuery);
+	}
+
+	const Material material = raycaster.getEllipsoid().getMaterial();
+	const ShaderProgram& program = *ShaderPrograms::raycast;
+	program.use();
+	program.setUniform("cameraEllipsoidMatrix", raycaster.getCameraEllipsoidMatrix());
+	program.setUniform("cameraMatrix", raycaster.getCameraMatrix());
+	program.setUniform("ellipsoidMatrix", raycaster.getEllipsoid().getMatrix());
+	program.setUniform("viewVector", raycaster.getViewVector());
+	program.setUniform("viewportSize", glm::vec2{m_viewportSize});
+	program.setUniform("backgroundColor", glm::vec3{Renderer::backgroundColor});
+	program.setUniform("material.color", glm::vec3{material.color});
+	program.setUniform("material.ambientCoef", material.ambientCoef);
+	program.setUniform("material.diffuseCoef", material.diffuseCoef);
+	program.setUniform("material.specularCoef", material.specularCoef);
+	program.setUniform("material.shininess", material.shininess);
+	setLightUniforms(raycaster);
+	m_quad.render();
+
+	if (isTimed)
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		m_isTimerQueryPending = true;
+	}
+}
+
+void GlslRenderBackend::updateViewportSize()
+{ }
+
+void GlslRenderBackend::refresh()
+{ }
+
+float GlslRenderBackend::getFrameTimeMs() const
+{
+	return m_frameTimeMs;
+}
+
+bool GlslRenderBackend::isConverged() const
+{
+	return true;
+}
+
+void GlslRenderBackend::readTimerQuery()
+{
+	if (!m_isTimerQueryPending)
+	{
+		return;
+	}
+
+	int isAvailable{};
+	glGetQueryObjectiv(m_timerQuery, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+	if (!isAvailable)
+	{
+		return;
+	}
+
+	GLuint64 elapsedNs{};
+	glGetQueryObjectui64v(m_timerQuery, GL_QUERY_RESULT, &elapsedNs);
+	m_frameTimeMs = static_cast<float>(elapsedNs) / 1e6f;
+	m_isTimerQueryPending = false;
+}
+
+void GlslRenderBackend::setLightUniforms(const Raycaster& raycaster)
+{
+	const ShaderProgram& program = *ShaderPrograms::raycast;
+	if (!raycaster.hasLights())
+	{
+		program.setUniform("lightCount", 0);
+		return;
+	}
+
+	const LightList::Components& lights = raycaster.getLights().getComponents();
+	int lightCount = raycaster.getLights().getCount();
+	m_lightVectors.resize(lightCount);
+	m_lightColors.resize(lightCount);
+	for (int light = 0; light < lightCount; ++light)
+	{
+		m_lightVectors[light] =
+			{lights.x[light], lights.y[light], lights.z[light], lights.w[light]};
+		m_lightColors[light] = {lights.red[light], lights.green[light], lights.blue[light],
+			lights.invRangeSquared[light]};
+	}
+	program.setUniform("lightCount", lightCount);
+	program.setUniform("lightVectors", m_lightVectors);
+	program.setUniform("lightColors", m_lightColors);
+}
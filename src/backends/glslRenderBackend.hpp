@@ -0,0 +1,37 @@
+#pragma once
+
+#include "backends/renderBackend.hpp"
+#include "quad.hpp"
+#include "raycaster.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+class GlslRenderBackend : public RenderBackend
+{
+public:
+	GlslRenderBackend(const glm::ivec2& viewportSize, Quad& quad);
+	GlslRenderBackend(const GlslRenderBackend&) = delete;
+	~GlslRenderBackend();
+
+	GlslRenderBackend& operator=(const GlslRenderBackend&) = delete;
+
+	void render(const Raycaster& raycaster) override;
+	void updateViewportSize() override;
+	void refresh() override;
+	float getFrameTimeMs() const override;
+	bool isConverged() const override;
+
+private:
+	const glm::ivec2& m_viewportSize;
+	Quad& m_quad;
+	unsigned int m_timerQuery{};
+	bool m_isTimerQueryPending = false;
+	float m_frameTimeMs{};
+	std::vector<glm::vec4> m_lightVectors{};
+	std::vector<glm::vec4> m_lightColors{};
+
+	void readTimerQuery();
+	void setLightUniforms(const Raycaster& raycaster);
+};
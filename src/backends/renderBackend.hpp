@@ -0,0 +1,21 @@
+#pragma once
+
+#include "raycaster.hpp"
+
+class RenderBackend
+{
+public:
+	enum class Type
+	{
+		cpu,
+		glsl
+	};
+
+	virtual ~RenderBackend() = default;
+
+	virtual void render(const Raycaster& raycaster) = 0;
+	virtual void updateViewportSize() = 0;
+	virtual void refresh() = 0;
+	virtual float getFrameTimeMs() const = 0;
+	virtual bool isConverged() const = 0;
+};
@@ -0,0 +1,97 @@
+#include "benchmark/lightBenchmark.hpp"
+
+#include "camera.hpp"
+#include "ellipsoid.hpp"
+#include "raycaster.hpp"
+#include "renderer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <span>
+
+constexpr std::array<int, 5> benchmarkLightCounts{4, 8, 16, 32, 64};
+constexpr int maxChannelTolerance = 2;
+
+int LightBenchmark::run(const CommandLine& commandLine)
+{
+	RenderSettings settings = RenderSettings::fromCommandLine(commandLine);
+	int repeatCount = std::max(commandLine.getInt("repeat", 3), 1);
+	float ringRadius = commandLine.getFloat("ring-radius", LightList::defaultRingRadius);
+	ThreadPool threadPool{commandLine.getInt("threads", ThreadPool::defaultThreadCount())};
+
+	std::vector<int> lightCounts(benchmarkLightCounts.begin(), benchmarkLightCounts.end());
+	if (commandLine.hasOption("lights"))
+	{
+		lightCounts = {std::clamp(commandLine.getInt("lights", 0), 1, LightList::maxLightCount)};
+	}
+
+	Result headlight = measure(settings, LightList{}, false, repeatCount, threadPool);
+	std::cout << "resolution: " << settings.resolution.x << 'x' << settings.resolution.y <<
+		", " << threadPool.getThreadCount() << " threads\n";
+	std::cout << "headlight: " << headlight.frameMs << " ms\n";
+	std::cout << "lights  all-lights ms  culled ms  speedup  lights/tile  max difference\n";
+
+	bool isMatching = true;
+	for (int lightCount : lightCounts)
+	{
+		LightList lights = LightList::createRing(lightCount, ringRadius);
+		Result all = measure(settings, lights, false, repeatCount, threadPool);
+		Result culled = measure(settings, lights, true, repeatCount, threadPool);
+		int maxDifference = calcMaxChannelDifference(all.frame, culled.frame);
+		isMatching = isMatching && maxDifference <= maxChannelTolerance;
+		std::cout << lightCount << "  " << all.frameMs << "  " << culled.frameMs << "  " <<
+			all.frameMs / culled.frameMs << "x  " << culled.meanTileLightCount << "  " <<
+			maxDifference << '\n';
+	}
+
+	if (!isMatching)
+	{
+		std::cerr << "Culled lighting differs by more than " << maxChannelTolerance <<
+			" levels\n";
+	}
+	return isMatching ? 0 : 1;
+}
+
+LightBenchmark::Result LightBenchmark::measure(const RenderSettings& settings,
+	const LightList& lights, bool isCullingEnabled, int repeatCount, ThreadPool& threadPool)
+{
+	using Clock = std::chrono::steady_clock;
+
+	glm::ivec2 viewportSize = settings.resolution;
+	Camera camera{viewportSize, Camera::defaultNearPlane, Camera::defaultFarPlane,
+		settings.camera.viewWidth};
+	Ellipsoid ellipsoid{settings.radii.x, settings.radii.y, settings.radii.z};
+	settings.apply(camera, ellipsoid);
+	Raycaster raycaster{camera, ellipsoid, &lights};
+	Renderer renderer{viewportSize};
+	renderer.setLightCullingEnabled(isCullingEnabled);
+	renderer.drawPass(raycaster, 1, true, threadPool);
+
+	Result result{};
+	Clock::time_point start = Clock::now();
+	for (int repeat = 0; repeat < repeatCount; ++repeat)
+	{
+		renderer.drawPass(raycaster, 1, true, threadPool);
+	}
+	result.frameMs =
+		std::chrono::duration<double, std::milli>(Clock::now() - start).count() / repeatCount;
+	result.meanTileLightCount = renderer.getMeanTileLightCount();
+	std::span<const unsigned char> frame = renderer.getCpuTexture();
+	result.frame.assign(frame.begin(), frame.end());
+	return result;
+}
+
+int LightBenchmark::calcMaxChannelDifference(const std::vector<unsigned char>& left,
+	const std::vector<unsigned char>& right)
+{
+	int maxDifference = 0;
+	for (std::size_t i = 0; i < left.size(); ++i)
+	{
+		maxDifference = std::max(maxDifference, std::abs(left[i] - right[i]));
+	}
+	return maxDifference;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "commandLine.hpp"
+#include "lightList.hpp"
+#include "renderSettings.hpp"
+#include "threadPool.hpp"
+
+#include <vector>
+
+class LightBenchmark
+{
+public:
+	struct Result
+	{
+		double frameMs{};
+		float meanTileLightCount{};
+		std::vector<unsigned char> frame{};
+	};
+
+	static int run(const CommandLine& commandLine);
+
+private:
+	static Result measure(const RenderSettings& settings, const LightList& lights,
+		bool isCullingEnabled, int repeatCount, ThreadPool& threadPool);
+	static int calcMaxChannelDifference(const std::vector<unsigned char>& left,
+		const std::vector<unsigned char>& right);
+};
@@ -0,0 +1,168 @@
+#include "benchmark/numaBenchmark.hpp"
+
+#include "camera.hpp"
+#include "ellipsoid.hpp"
+#include "raycaster.hpp"
+#include "renderer.hpp"
+#include "threadPool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string>
+#include <utility>
+
+constexpr glm::ivec2 benchmarkResolution{7680, 4320};
+constexpr double bytesPerMiB = 1024.0 * 1024.0;
+
+int NumaBenchmark::run(const CommandLine& commandLine)
+{
+	RenderSettings settings = RenderSettings::fromCommandLine(commandLine);
+	if (!commandLine.hasOption("width") && !commandLine.hasOption("height"))
+	{
+		settings.resolution = benchmarkResolution;
+	}
+	int maxPixelSizeExponent = std::clamp(commandLine.getInt("accuracy", 4), 0, 8);
+	int repeatCount = std::max(commandLine.getInt("repeat", 3), 1);
+	int threadCount = std::max(commandLine.getInt("threads", ThreadPool::defaultThreadCount()), 1);
+	std::string pageModeName = commandLine.getString("page-mode", "transparent");
+	std::optional<PageAllocator::PageMode> pageMode = PageAllocator::parsePageMode(pageModeName);
+	if (!pageMode.has_value())
+	{
+		std::cerr << "Invalid value of --page-mode: " << pageModeName << '\n';
+		return 1;
+	}
+
+	NumaTopology topology = NumaTopology::detect();
+	std::cout << "resolution: " << settings.resolution.x << 'x' << settings.resolution.y <<
+		", " << threadCount << " threads, " << topology.getNodeCount() << " NUMA nodes (";
+	for (int node = 0; node < topology.getNodeCount(); ++node)
+	{
+		std::cout << (node > 0 ? ", " : "") << topology.getNodeCpus(node).size() << " cpus";
+	}
+	std::cout << ")\n";
+	std::cout << "layout  pages  alloc ms  first refinement ms  refinement ms  speedup  " <<
+		"huge MiB  pinned\n";
+
+	const std::array<Layout, 3> layouts{{
+		{"default", PageAllocator::PageMode::standard, false},
+		{"huge-pages", *pageMode, false},
+		{"numa-aware", *pageMode, true}
+	}};
+	std::optional<Result> baseline{};
+	bool isMatching = true;
+	for (const Layout& layout : layouts)
+	{
+		std::uint64_t fallbackCount = PageAllocator::getHugeFallbackCount();
+		Result result = measure(settings, layout, topology, threadCount, maxPixelSizeExponent,
+			repeatCount);
+		std::cout << layout.name << "  " << PageAllocator::getPageModeName(layout.pageMode) <<
+			(PageAllocator::getHugeFallbackCount() != fallbackCount ? " (fallback)" : "") <<
+			"  " << result.allocationMs << "  " << result.firstRefinementMs << "  " <<
+			result.refinementMs << "  " <<
+			(baseline.has_value() ? baseline->refinementMs / result.refinementMs : 1.0) << "x  ";
+		if (result.hugePageBytes.has_value())
+		{
+			std::cout << *result.hugePageBytes / bytesPerMiB;
+		}
+		else
+		{
+			std::cout << "n/a";
+		}
+		std::cout << "  " << (layout.isNumaAware ? (result.isPinned ? "yes" : "failed") : "no") <<
+			'\n';
+
+		if (!baseline.has_value())
+		{
+			baseline = std::move(result);
+		}
+		else if (result.frame != baseline->frame)
+		{
+			std::cerr << "Output of the " << layout.name << " layout differs from default\n";
+			isMatching = false;
+		}
+	}
+
+	PageAllocator::setPageMode(PageAllocator::PageMode::standard);
+	PageAllocator::setFirstTouchDistributed(false);
+	return isMatching ? 0 : 1;
+}
+
+NumaBenchmark::Result NumaBenchmark::measure(const RenderSettings& settings,
+	const Layout& layout, const NumaTopology& topology, int threadCount,
+	int maxPixelSizeExponent, int repeatCount)
+{
+	using Clock = std::chrono::steady_clock;
+
+	PageAllocator::setPageMode(layout.pageMode);
+	PageAllocator::setFirstTouchDistributed(layout.isNumaAware);
+	ThreadPool threadPool{threadCount};
+	Result result{};
+	if (layout.isNumaAware)
+	{
+		threadPool.setScheduling(ThreadPool::Scheduling::affinity);
+		result.isPinned = threadPool.pinToNodes(topology);
+	}
+
+	glm::ivec2 viewportSize = settings.resolution;
+	Camera camera{viewportSize, Camera::defaultNearPlane, Camera::defaultFarPlane,
+		settings.camera.viewWidth};
+	Ellipsoid ellipsoid{settings.radii.x, settings.radii.y, settings.radii.z};
+	settings.apply(camera, ellipsoid);
+	Raycaster raycaster{camera, ellipsoid};
+
+	std::optional<std::size_t> initialHugePageBytes = readHugePageBytes();
+	Clock::time_point start = Clock::now();
+	Renderer renderer{viewportSize};
+	renderer.touchPages(threadPool);
+	result.allocationMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+	for (int repeat = 0; repeat <= repeatCount; ++repeat)
+	{
+		start = Clock::now();
+		for (int exponent = maxPixelSizeExponent; exponent >= 0; --exponent)
+		{
+			renderer.drawPass(raycaster, 1 << exponent, exponent == maxPixelSizeExponent,
+				threadPool);
+		}
+		double refinementMs =
+			std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		if (repeat == 0)
+		{
+			result.firstRefinementMs = refinementMs;
+			continue;
+		}
+		result.refinementMs += refinementMs / repeatCount;
+	}
+
+	std::optional<std::size_t> hugePageBytes = readHugePageBytes();
+	if (initialHugePageBytes.has_value() && hugePageBytes.has_value())
+	{
+		result.hugePageBytes = *hugePageBytes - std::min(*hugePageBytes, *initialHugePageBytes);
+	}
+	std::span<const unsigned char> cpuTexture = renderer.getCpuTexture();
+	result.frame.assign(cpuTexture.begin(), cpuTexture.end());
+	return result;
+}
+
+std::optional<std::size_t> NumaBenchmark::readHugePageBytes()
+{
+	std::ifstream file{"/proc/self/smaps_rollup"};
+	std::string key{};
+	while (file >> key)
+	{
+		if (key == "AnonHugePages:")
+		{
+			std::size_t kilobytes = 0;
+			file >> kilobytes;
+			return kilobytes * 1024;
+		}
+		file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+	}
+	return std::nullopt;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "commandLine.hpp"
+#include "framebufferAllocator.hpp"
+#include "numaTopology.hpp"
+#include "renderSettings.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+class NumaBenchmark
+{
+public:
+	struct Layout
+	{
+		const char* name{};
+		PageAllocator::PageMode pageMode{};
+		bool isNumaAware{};
+	};
+
+	struct Result
+	{
+		double allocationMs{};
+		double firstRefinementMs{};
+		double refinementMs{};
+		std::optional<std::size_t> hugePageBytes{};
+		bool isPinned{};
+		std::vector<unsigned char> frame{};
+	};
+
+	static int run(const CommandLine& commandLine);
+
+private:
+	static Result measure(const RenderSettings& settings, const Layout& layout,
+		const NumaTopology& topology, int threadCount, int maxPixelSizeExponent,
+		int repeatCount);
+	static std::optional<std::size_t> readHugePageBytes();
+};
@@ -0,0 +1,155 @@
+#include "benchmark/precisionBenchmark.hpp"
+
+#include "camera.hpp"
+#include "ellipsoid.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+constexpr std::array<Raycaster::Precision, 3> benchmarkPrecisions{Raycaster::Precision::fp32,
+	Raycaster::Precision::adaptive, Raycaster::Precision::fp64};
+constexpr std::array<const char*, 3> precisionNames{"fp32", "adaptive", "fp64"};
+constexpr glm::vec3 extremeRadii{0.1f, 2.0f, 1000.0f};
+constexpr float extremeYaw = 1.5f;
+constexpr float extremePitch = 0.3f;
+constexpr float extremeViewWidth = 2000.0f;
+constexpr float heavyZoom = 1e5f;
+
+int PrecisionBenchmark::run(const CommandLine& commandLine)
+{
+	int repeatCount = std::max(commandLine.getInt("repeat", 3), 1);
+
+	bool isAdaptiveExact = true;
+	std::cout << "case  precision  ns/ray  cost  fallback  hit mismatches  max depth error\n";
+	for (const Case& benchmarkCase : createCases(commandLine))
+	{
+		const RenderSettings& settings = benchmarkCase.settings;
+		Camera camera{settings.resolution, Camera::defaultNearPlane, Camera::defaultFarPlane,
+			settings.camera.viewWidth};
+		Ellipsoid ellipsoid{settings.radii.x, settings.radii.y, settings.radii.z};
+		settings.apply(camera, ellipsoid);
+		Raycaster raycaster{camera, ellipsoid};
+
+		std::vector<std::optional<float>> reference{};
+		raycaster.setPrecision(Raycaster::Precision::fp64);
+		calcDepths(raycaster, settings.resolution, reference);
+
+		double fp32NsPerRay = 0;
+		for (std::size_t i = 0; i < benchmarkPrecisions.size(); ++i)
+		{
+			Result result = measure(raycaster, settings.resolution, benchmarkPrecisions[i],
+				repeatCount, reference);
+			if (benchmarkPrecisions[i] == Raycaster::Precision::fp32)
+			{
+				fp32NsPerRay = result.nsPerRay;
+			}
+			if (benchmarkPrecisions[i] == Raycaster::Precision::adaptive)
+			{
+				isAdaptiveExact = isAdaptiveExact && result.hitMismatchCount == 0;
+			}
+			std::cout << benchmarkCase.name << "  " << precisionNames[i] << "  " <<
+				result.nsPerRay << "  " << result.nsPerRay / fp32NsPerRay << "x  " <<
+				100 * result.fallbackFraction << "%  " << result.hitMismatchCount << "  " <<
+				result.maxDepthError << '\n';
+		}
+	}
+
+	if (!isAdaptiveExact)
+	{
+		std::cerr << "Adaptive precision misclassifies rays compared to fp64\n";
+	}
+	return isAdaptiveExact ? 0 : 1;
+}
+
+std::vector<PrecisionBenchmark::Case> PrecisionBenchmark::createCases(
+	const CommandLine& commandLine)
+{
+	RenderSettings settings = RenderSettings::fromCommandLine(commandLine);
+	if (commandLine.hasOption("a") || commandLine.hasOption("b") || commandLine.hasOption("c") ||
+		commandLine.hasOption("view-width"))
+	{
+		return {{"custom", settings}};
+	}
+
+	Case extreme{"extreme-radii", settings};
+	extreme.settings.radii = extremeRadii;
+	extreme.settings.camera.yawRad = extremeYaw;
+	extreme.settings.camera.pitchRad = extremePitch;
+	extreme.settings.camera.viewWidth = extremeViewWidth;
+	Case zoomed{"heavy-zoom", settings};
+	zoomed.settings.camera.targetPos = {settings.radii.x, 0, 0};
+	zoomed.settings.camera.viewWidth /= heavyZoom;
+	return {{"default", settings}, extreme, zoomed};
+}
+
+PrecisionBenchmark::Result PrecisionBenchmark::measure(Raycaster raycaster,
+	const glm::ivec2& viewportSize, Raycaster::Precision precision, int repeatCount,
+	const std::vector<std::optional<float>>& reference)
+{
+	using Clock = std::chrono::steady_clock;
+
+	raycaster.setPrecision(precision);
+	std::vector<std::optional<float>> depths{};
+	calcDepths(raycaster, viewportSize, depths);
+	Clock::time_point start = Clock::now();
+	for (int repeat = 0; repeat < repeatCount; ++repeat)
+	{
+		calcDepths(raycaster, viewportSize, depths);
+	}
+	double rayCount = static_cast<double>(depths.size()) * repeatCount;
+
+	Result result{};
+	result.nsPerRay =
+		std::chrono::duration<double, std::nano>(Clock::now() - start).count() / rayCount;
+	int fallbackCount = 0;
+	for (int y = 0; y < viewportSize.y; ++y)
+	{
+		for (int x = 0; x < viewportSize.x; ++x)
+		{
+			std::size_t pixel = static_cast<std::size_t>(y) * viewportSize.x + x;
+			glm::vec2 ndc = toNDC({x, y}, viewportSize);
+			bool isFallback = precision == Raycaster::Precision::fp64 ||
+				(precision == Raycaster::Precision::adaptive &&
+					raycaster.isIllConditioned(ndc.x, ndc.y));
+			if (isFallback)
+			{
+				++fallbackCount;
+			}
+			if (depths[pixel].has_value() != reference[pixel].has_value())
+			{
+				++result.hitMismatchCount;
+			}
+			else if (depths[pixel].has_value())
+			{
+				result.maxDepthError = std::max(result.maxDepthError,
+					static_cast<double>(std::abs(*depths[pixel] - *reference[pixel])));
+			}
+		}
+	}
+	result.fallbackFraction = fallbackCount / static_cast<double>(depths.size());
+	return result;
+}
+
+void PrecisionBenchmark::calcDepths(const Raycaster& raycaster, const glm::ivec2& viewportSize,
+	std::vector<std::optional<float>>& depths)
+{
+	depths.resize(static_cast<std::size_t>(viewportSize.x) * viewportSize.y);
+	for (int y = 0; y < viewportSize.y; ++y)
+	{
+		for (int x = 0; x < viewportSize.x; ++x)
+		{
+			glm::vec2 ndc = toNDC({x, y}, viewportSize);
+			depths[static_cast<std::size_t>(y) * viewportSize.x + x] =
+				raycaster.calcIntersection(ndc.x, ndc.y);
+		}
+	}
+}
+
+glm::vec2 PrecisionBenchmark::toNDC(const glm::ivec2& pixel, const glm::ivec2& viewportSize)
+{
+	return (glm::vec2{pixel} + 0.5f) / glm::vec2{viewportSize} * 2.0f - 1.0f;
+}
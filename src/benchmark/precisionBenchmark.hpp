@@ -0,0 +1,40 @@
+#pragma once
+
+#include "commandLine.hpp"
+#include "raycaster.hpp"
+#include "renderSettings.hpp"
+
+#include <glm/glm.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+class PrecisionBenchmark
+{
+public:
+	struct Case
+	{
+		std::string name{};
+		RenderSettings settings{};
+	};
+
+	struct Result
+	{
+		double nsPerRay{};
+		double fallbackFraction{};
+		int hitMismatchCount{};
+		double maxDepthError{};
+	};
+
+	static int run(const CommandLine& commandLine);
+
+private:
+	static std::vector<Case> createCases(const CommandLine& commandLine);
+	static Result measure(Raycaster raycaster, const glm::ivec2& viewportSize,
+		Raycaster::Precision precision, int repeatCount,
+		const std::vector<std::optional<float>>& reference);
+	static void calcDepths(const Raycaster& raycaster, const glm::ivec2& viewportSize,
+		std::vector<std::optional<float>>& depths);
+	static glm::vec2 toNDC(const glm::ivec2& pixel, const glm::ivec2& viewportSize);
+};
@@ -0,0 +1,108 @@
+#include "benchmark/refinementBenchmark.hpp"
+
+#include "camera.hpp"
+#include "ellipsoid.hpp"
+#include "raycaster.hpp"
+#include "renderSettings.hpp"
+#include "renderer.hpp"
+#include "sampleOrder.hpp"
+#include "threadPool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+
+int RefinementBenchmark::run(const CommandLine& commandLine)
+{
+	using Clock = std::chrono::steady_clock;
+
+	RenderSettings settings = RenderSettings::fromCommandLine(commandLine);
+	int maxPixelSizeExponent = std::clamp(commandLine.getInt("accuracy", 4), 0, 8);
+	ThreadPool threadPool{commandLine.getInt("threads", ThreadPool::defaultThreadCount())};
+
+	glm::ivec2 viewportSize = settings.resolution;
+	Camera camera{viewportSize, Camera::defaultNearPlane, Camera::defaultFarPlane,
+		settings.camera.viewWidth};
+	Ellipsoid ellipsoid{settings.radii.x, settings.radii.y, settings.radii.z};
+	settings.apply(camera, ellipsoid);
+	Raycaster raycaster{camera, ellipsoid};
+
+	Renderer reference{viewportSize};
+	reference.drawPass(raycaster, 1, true, threadPool);
+	Renderer grid{viewportSize};
+	Renderer blueNoise{viewportSize};
+	SampleOrder::getBlueNoise();
+
+	double pixelCount = static_cast<double>(viewportSize.x) * viewportSize.y;
+	std::int64_t gridRays = 0;
+	std::int64_t blueNoiseRays = 0;
+	int rank = 0;
+	double gridMs = 0;
+	double blueNoiseMs = 0;
+	std::cout << "resolution: " << viewportSize.x << 'x' << viewportSize.y << '\n';
+	std::cout << "pass  grid rays  grid PSNR  blue-noise rays  blue-noise PSNR\n";
+	for (int exponent = maxPixelSizeExponent; exponent >= 0; --exponent)
+	{
+		int pixelSize = 1 << exponent;
+		bool isFirstPass = exponent == maxPixelSizeExponent;
+		Clock::time_point start = Clock::now();
+		grid.drawPass(raycaster, pixelSize, isFirstPass, threadPool);
+		gridMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		gridRays += countGridRays(viewportSize, pixelSize, isFirstPass);
+
+		int endRank = exponent == 0 ? SampleOrder::rankCount :
+			std::clamp(static_cast<int>(std::lround(gridRays * SampleOrder::rankCount /
+				pixelCount)), rank + 1, SampleOrder::rankCount);
+		start = Clock::now();
+		blueNoiseRays += blueNoise.drawSamples(raycaster, rank, endRank, threadPool);
+		blueNoiseMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		rank = endRank;
+
+		std::cout << pixelSize << "px  " << gridRays << "  " <<
+			calcPsnr(grid.getCpuTexture(), reference.getCpuTexture()) << " dB  " <<
+			blueNoiseRays << "  " <<
+			calcPsnr(blueNoise.getCpuTexture(), reference.getCpuTexture()) << " dB\n";
+	}
+	std::cout << "total time: grid " << gridMs << " ms, blue noise " << blueNoiseMs << " ms\n";
+
+	bool isConverged = std::ranges::equal(grid.getCpuTexture(), reference.getCpuTexture()) &&
+		std::ranges::equal(blueNoise.getCpuTexture(), reference.getCpuTexture());
+	if (!isConverged)
+	{
+		std::cerr << "Refinement did not converge to the reference image\n";
+	}
+	return isConverged ? 0 : 1;
+}
+
+std::int64_t RefinementBenchmark::countGridRays(const glm::ivec2& viewportSize, int pixelSize,
+	bool isFirstPass)
+{
+	std::int64_t columnCount = (viewportSize.x + pixelSize / 2 + pixelSize - 1) / pixelSize;
+	std::int64_t rowCount = (viewportSize.y + pixelSize / 2 + pixelSize - 1) / pixelSize;
+	if (isFirstPass)
+	{
+		return columnCount * rowCount;
+	}
+	std::int64_t evenRowCount = (rowCount + 1) / 2;
+	return evenRowCount * (columnCount / 2) + (rowCount - evenRowCount) * columnCount;
+}
+
+double RefinementBenchmark::calcPsnr(std::span<const unsigned char> image,
+	std::span<const unsigned char> reference)
+{
+	double squaredErrorSum = 0;
+	for (std::size_t i = 0; i < image.size(); ++i)
+	{
+		double difference = static_cast<double>(image[i]) - reference[i];
+		squaredErrorSum += difference * difference;
+	}
+	if (squaredErrorSum == 0)
+	{
+		return std::numeric_limits<double>::infinity();
+	}
+	double meanSquaredError = squaredErrorSum / static_cast<double>(image.size());
+	return 10 * std::log10(255.0 * 255.0 / meanSquaredError);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "commandLine.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <span>
+
+class RefinementBenchmark
+{
+public:
+	static int run(const CommandLine& commandLine);
+
+private:
+	static std::int64_t countGridRays(const glm::ivec2& viewportSize, int pixelSize,
+		bool isFirstPass);
+	static double calcPsnr(std::span<const unsigned char> image,
+		std::span<const unsigned char> reference);
+};
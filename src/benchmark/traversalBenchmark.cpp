@@ -0,0 +1,228 @@
+#include "benchmark/traversalBenchmark.hpp"
+
+#include "camera.hpp"
+#include "ellipsoid.hpp"
+#include "raycaster.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <string>
+
+constexpr std::array<glm::ivec2, 2> benchmarkResolutions{{{3840, 2160}, {7680, 4320}}};
+
+int TraversalBenchmark::run(const CommandLine& commandLine)
+{
+	RenderSettings settings = RenderSettings::fromCommandLine(commandLine);
+	int maxPixelSizeExponent = std::clamp(commandLine.getInt("accuracy", 4), 0, 8);
+	int repeatCount = std::max(commandLine.getInt("repeat", 3), 1);
+	std::string traversalName = commandLine.getString("traversal", "both");
+	ThreadPool threadPool{commandLine.getInt("threads", ThreadPool::defaultThreadCount())};
+	PerfCounters counters{};
+	threadPool.setCountersEnabled(counters.isAvailable());
+	if (!counters.isAvailable())
+	{
+		std::cout << "hardware counters unavailable\n";
+	}
+
+	std::optional<std::ofstream> jsonFile{};
+	if (commandLine.hasOption("json"))
+	{
+		std::string jsonPath = commandLine.getString("json", "traversal-benchmark.json");
+		jsonFile.emplace(jsonPath, std::ios::trunc);
+		if (!jsonFile->is_open())
+		{
+			std::cerr << "Cannot write " << jsonPath << '\n';
+			return 1;
+		}
+		*jsonFile << "{\n  \"threads\": " << threadPool.getThreadCount() <<
+			",\n  \"countersAvailable\": " << (counters.isAvailable() ? "true" : "false") <<
+			",\n  \"runs\": [";
+	}
+
+	std::vector<Renderer::Traversal> traversals{};
+	if (traversalName != "morton")
+	{
+		traversals.push_back(Renderer::Traversal::rowMajor);
+	}
+	if (traversalName != "row")
+	{
+		traversals.push_back(Renderer::Traversal::morton);
+	}
+
+	std::vector<glm::ivec2> resolutions(benchmarkResolutions.begin(),
+		benchmarkResolutions.end());
+	if (commandLine.hasOption("width") || commandLine.hasOption("height"))
+	{
+		resolutions = {settings.resolution};
+	}
+
+	bool isMatching = true;
+	bool isFirstRun = true;
+	for (const glm::ivec2& resolution : resolutions)
+	{
+		settings.resolution = resolution;
+		std::vector<unsigned char> referenceFrame{};
+		std::vector<unsigned char> frame{};
+		std::optional<Result> baseline{};
+		for (Renderer::Traversal traversal : traversals)
+		{
+			Result result = measure(settings, traversal, maxPixelSizeExponent, repeatCount,
+				threadPool, counters, frame);
+			std::cout << resolution.x << 'x' << resolution.y << ' ' <<
+				(traversal == Renderer::Traversal::morton ? "morton" : "row-major") << ": " <<
+				result.totalMs << " ms per refinement";
+			if (baseline.has_value())
+			{
+				std::cout << " (" << baseline->totalMs / result.totalMs << "x)";
+			}
+			std::cout << "\n  pass ms:";
+			for (std::size_t pass = 0; pass < result.passMs.size(); ++pass)
+			{
+				std::cout << ' ' << (1 << (maxPixelSizeExponent - pass)) << "px " <<
+					result.passMs[pass];
+			}
+			std::cout << '\n';
+			if (counters.isAvailable())
+			{
+				std::cout << "  pass IPC:";
+				for (std::size_t pass = 0; pass < result.passCounters.size(); ++pass)
+				{
+					std::cout << ' ' << (1 << (maxPixelSizeExponent - pass)) << "px " <<
+						result.passCounters[pass].getInstructionsPerCycle();
+				}
+				std::cout << '\n';
+			}
+			if (jsonFile.has_value())
+			{
+				*jsonFile << (isFirstRun ? "\n" : ",\n");
+				writeJson(*jsonFile, resolution, traversal, maxPixelSizeExponent, repeatCount,
+					result);
+				isFirstRun = false;
+			}
+
+			if (referenceFrame.empty())
+			{
+				referenceFrame.swap(frame);
+				baseline = result;
+			}
+			else if (frame != referenceFrame)
+			{
+				std::cerr << "Traversal output differs at " << resolution.x << 'x' <<
+					resolution.y << '\n';
+				isMatching = false;
+			}
+		}
+	}
+
+	if (jsonFile.has_value())
+	{
+		*jsonFile << "\n  ]\n}\n";
+	}
+	return isMatching ? 0 : 1;
+}
+
+TraversalBenchmark::Result TraversalBenchmark::measure(const RenderSettings& settings,
+	Renderer::Traversal traversal, int maxPixelSizeExponent, int repeatCount,
+	ThreadPool& threadPool, PerfCounters& counters, std::vector<unsigned char>& frame)
+{
+	using Clock = std::chrono::steady_clock;
+
+	glm::ivec2 viewportSize = settings.resolution;
+	Camera camera{viewportSize, Camera::defaultNearPlane, Camera::defaultFarPlane,
+		settings.camera.viewWidth};
+	Ellipsoid ellipsoid{settings.radii.x, settings.radii.y, settings.radii.z};
+	settings.apply(camera, ellipsoid);
+	Raycaster raycaster{camera, ellipsoid};
+	Renderer renderer{viewportSize};
+	renderer.setTraversal(traversal);
+
+	Result result{};
+	result.passMs.assign(maxPixelSizeExponent + 1, 0);
+	result.passCounters.resize(maxPixelSizeExponent + 1);
+	result.threadCounters.resize(threadPool.getThreadCount());
+	for (int repeat = 0; repeat < repeatCount; ++repeat)
+	{
+		for (int exponent = maxPixelSizeExponent; exponent >= 0; --exponent)
+		{
+			int pass = maxPixelSizeExponent - exponent;
+			threadPool.resetCounters();
+			counters.start();
+			Clock::time_point start = Clock::now();
+			renderer.drawPass(raycaster, 1 << exponent, exponent == maxPixelSizeExponent,
+				threadPool);
+			double passMs =
+				std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+			PerfCounters::Sample mainCounters = counters.stop();
+			result.passMs[pass] += passMs / repeatCount;
+			result.totalMs += passMs / repeatCount;
+
+			result.passCounters[pass].add(mainCounters);
+			result.threadCounters[0].add(mainCounters);
+			const std::vector<PerfCounters::Sample>& workerCounters =
+				threadPool.getWorkerCounters();
+			for (std::size_t worker = 0; worker < workerCounters.size(); ++worker)
+			{
+				result.passCounters[pass].add(workerCounters[worker]);
+				result.threadCounters[worker + 1].add(workerCounters[worker]);
+			}
+		}
+	}
+	std::span<const unsigned char> cpuTexture = renderer.getCpuTexture();
+	frame.assign(cpuTexture.begin(), cpuTexture.end());
+	return result;
+}
+
+void TraversalBenchmark::writeJson(std::ostream& output, const glm::ivec2& resolution,
+	Renderer::Traversal traversal, int maxPixelSizeExponent, int repeatCount,
+	const Result& result)
+{
+	output << "    {\n      \"resolution\": [" << resolution.x << ", " << resolution.y <<
+		"],\n      \"traversal\": \"" <<
+		(traversal == Renderer::Traversal::morton ? "morton" : "row-major") <<
+		"\",\n      \"totalMs\": " << result.totalMs << ",\n      \"passes\": [";
+	for (std::size_t pass = 0; pass < result.passMs.size(); ++pass)
+	{
+		output << (pass > 0 ? ",\n" : "\n") << "        {\"pixelSize\": " <<
+			(1 << (maxPixelSizeExponent - pass)) << ", \"ms\": " << result.passMs[pass] <<
+			", \"counters\": ";
+		writeCounters(output, result.passCounters[pass], repeatCount);
+		output << '}';
+	}
+	output << "\n      ],\n      \"threads\": [";
+	for (std::size_t thread = 0; thread < result.threadCounters.size(); ++thread)
+	{
+		output << (thread > 0 ? ",\n" : "\n") << "        ";
+		writeCounters(output, result.threadCounters[thread], repeatCount);
+	}
+	output << "\n      ]\n    }";
+}
+
+void TraversalBenchmark::writeCounters(std::ostream& output,
+	const PerfCounters::Sample& counters, int repeatCount)
+{
+	if (counters.count == 0)
+	{
+		output << "null";
+		return;
+	}
+
+	output << '{';
+	bool isFirst = true;
+	for (int event = 0; event < PerfCounters::eventCount; ++event)
+	{
+		if (!counters.hasEvent(static_cast<PerfCounters::Event>(event)))
+		{
+			continue;
+		}
+		output << (isFirst ? "" : ", ") << '"' << PerfCounters::eventNames[event] << "\": " <<
+			counters.values[event] / repeatCount;
+		isFirst = false;
+	}
+	output << '}';
+}
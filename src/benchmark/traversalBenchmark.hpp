@@ -0,0 +1,36 @@
+#pragma once
+
+#include "commandLine.hpp"
+#include "perfCounters.hpp"
+#include "renderSettings.hpp"
+#include "renderer.hpp"
+#include "threadPool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <ostream>
+#include <vector>
+
+class TraversalBenchmark
+{
+public:
+	struct Result
+	{
+		std::vector<double> passMs{};
+		double totalMs{};
+		std::vector<PerfCounters::Sample> passCounters{};
+		std::vector<PerfCounters::Sample> threadCounters{};
+	};
+
+	static int run(const CommandLine& commandLine);
+
+private:
+	static Result measure(const RenderSettings& settings, Renderer::Traversal traversal,
+		int maxPixelSizeExponent, int repeatCount, ThreadPool& threadPool,
+		PerfCounters& counters, std::vector<unsigned char>& frame);
+	static void writeJson(std::ostream& output, const glm::ivec2& resolution,
+		Renderer::Traversal traversal, int maxPixelSizeExponent, int repeatCount,
+		const Result& result);
+	static void writeCounters(std::ostream& output, const PerfCounters::Sample& counters,
+		int repeatCount);
+};
@@ -36,6 +36,21 @@ void Camera::setViewWidth(float viewWidth)
 	updateProjectionMatrix();
 }
 
+CameraState Camera::getState() const
+{
+	return {m_targetPos, m_pitchRad, m_yawRad, m_viewWidth};
+}
+
+void Camera::setState(const CameraState& state)
+{
+	m_targetPos = state.targetPos;
+	m_viewWidth = state.viewWidth;
+	setPitch(state.pitchRad);
+	setYaw(state.yawRad);
+
+	updateProjectionMatrix();
+}
+
 glm::vec3 Camera::getPos() const
 {
 	return m_targetPos + m_radius *
@@ -47,23 +62,26 @@ glm::vec3 Camera::getPos() const
 		};
 }
 
-void Camera::moveX(float x)
+glm::vec3 Camera::getTargetPos() const
 {
-	m_targetPos += m_viewWidth * glm::mat3{m_viewMatrixInverse} * glm::vec3{x, 0, 0};
-
-	updateViewMatrix();
+	return m_targetPos;
 }
 
-void Camera::moveY(float y)
+void Camera::setTargetPos(const glm::vec3& targetPos)
 {
-	m_targetPos += m_viewWidth * glm::mat3{m_viewMatrixInverse} * glm::vec3{0, y, 0};
+	m_targetPos = targetPos;
 
 	updateViewMatrix();
 }
 
-void Camera::addPitch(float pitchRad)
+float Camera::getPitch() const
 {
-	m_pitchRad += pitchRad;
+	return m_pitchRad;
+}
+
+void Camera::setPitch(float pitchRad)
+{
+	m_pitchRad = pitchRad;
 
 	constexpr float bound = glm::radians(89.0f);
 	if (m_pitchRad < -bound)
@@ -78,9 +96,14 @@ void Camera::addPitch(float pitchRad)
 	updateViewMatrix();
 }
 
-void Camera::addYaw(float yawRad)
+float Camera::getYaw() const
+{
+	return m_yawRad;
+}
+
+void Camera::setYaw(float yawRad)
 {
-	m_yawRad += yawRad;
+	m_yawRad = yawRad;
 
 	constexpr float pi = glm::pi<float>();
 	while (m_yawRad < -pi)
@@ -95,6 +118,30 @@ void Camera::addYaw(float yawRad)
 	updateViewMatrix();
 }
 
+void Camera::moveX(float x)
+{
+	m_targetPos += m_viewWidth * glm::mat3{m_viewMatrixInverse} * glm::vec3{x, 0, 0};
+
+	updateViewMatrix();
+}
+
+void Camera::moveY(float y)
+{
+	m_targetPos += m_viewWidth * glm::mat3{m_viewMatrixInverse} * glm::vec3{0, y, 0};
+
+	updateViewMatrix();
+}
+
+void Camera::addPitch(float pitchRad)
+{
+	setPitch(m_pitchRad + pitchRad);
+}
+
+void Camera::addYaw(float yawRad)
+{
+	setYaw(m_yawRad + yawRad);
+}
+
 void Camera::zoom(float zoom)
 {
 	m_viewWidth /= zoom;
@@ -2,9 +2,15 @@
 
 #include <glm/glm.hpp>
 
+struct CameraState;
+
 class Camera
 {
 public:
+	static constexpr float defaultNearPlane = 0.0f;
+	static constexpr float defaultFarPlane = 1000.0f;
+	static constexpr float defaultViewWidth = 20.0f;
+
 	Camera(const glm::ivec2& viewportSize, float nearPlane, float farPlane, float viewWidth);
 
 	glm::mat4 getMatrixInverse() const;
@@ -12,7 +18,17 @@ public:
 	float getViewWidth() const;
 	void setViewWidth(float viewWidth);
 
+	CameraState getState() const;
+	void setState(const CameraState& state);
+
 	glm::vec3 getPos() const;
+	glm::vec3 getTargetPos() const;
+	void setTargetPos(const glm::vec3& targetPos);
+	float getPitch() const;
+	void setPitch(float pitchRad);
+	float getYaw() const;
+	void setYaw(float yawRad);
+
 	void moveX(float x);
 	void moveY(float y);
 	void addPitch(float pitchRad);
@@ -36,3 +52,13 @@ private:
 	void updateViewMatrix();
 	void updateProjectionMatrix();
 };
+
+struct CameraState
+{
+	glm::vec3 targetPos{0, 0, 0};
+	float pitchRad = 0;
+	float yawRad = 0;
+	float viewWidth = Camera::defaultViewWidth;
+
+	bool operator==(const CameraState& state) const = default;
+};
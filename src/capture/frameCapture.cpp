@@ -0,0 +1,54 @@
+#include "capture/frameCapture.hpp"
+
+#include <glad/glad.h>
+
+FrameCapture::FrameCapture(const std::filesystem::path& directory,
+	FrameExporter::Format format) :
+	m_exporter{directory, format}
+{ }
+
+void FrameCapture::update(const glm::ivec2& offset, const glm::ivec2& size, bool isConverged,
+	std::uint64_t revision)
+{
+	m_readback.collect(m_exporter);
+
+	bool isNewConvergedFrame = m_isCapturingConverged && isConverged &&
+		revision != m_capturedRevision;
+	if ((!m_isScreenshotRequested && !isNewConvergedFrame) || !m_readback.request(offset, size))
+	{
+		return;
+	}
+
+	m_isScreenshotRequested = false;
+	if (isConverged)
+	{
+		m_capturedRevision = revision;
+	}
+}
+
+void FrameCapture::flush()
+{
+	glFinish();
+	m_readback.collect(m_exporter);
+	m_exporter.flush();
+}
+
+void FrameCapture::requestScreenshot()
+{
+	m_isScreenshotRequested = true;
+}
+
+bool FrameCapture::isCapturingConverged() const
+{
+	return m_isCapturingConverged;
+}
+
+void FrameCapture::setCapturingConverged(bool isCapturingConverged)
+{
+	m_isCapturingConverged = isCapturingConverged;
+}
+
+const FrameExporter& FrameCapture::getExporter() const
+{
+	return m_exporter;
+}
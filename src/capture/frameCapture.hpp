@@ -0,0 +1,33 @@
+#pragma once
+
+#include "capture/frameExporter.hpp"
+#include "capture/framebufferReadback.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+
+class FrameCapture
+{
+public:
+	static constexpr const char* defaultDirectory = "captures";
+
+	FrameCapture(const std::filesystem::path& directory, FrameExporter::Format format);
+
+	void update(const glm::ivec2& offset, const glm::ivec2& size, bool isConverged,
+		std::uint64_t revision);
+	void flush();
+	void requestScreenshot();
+	bool isCapturingConverged() const;
+	void setCapturingConverged(bool isCapturingConverged);
+	const FrameExporter& getExporter() const;
+
+private:
+	FramebufferReadback m_readback{};
+	FrameExporter m_exporter;
+	bool m_isScreenshotRequested = false;
+	bool m_isCapturingConverged = false;
+	std::optional<std::uint64_t> m_capturedRevision{};
+};
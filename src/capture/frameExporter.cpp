@@ -0,0 +1,162 @@
+#include "capture/frameExporter.hpp"
+
+#include "exrEncoder.hpp"
+#include "pngEncoder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <system_error>
+
+FrameExporter::FrameExporter(const std::filesystem::path& directory, Format format) :
+	m_directory{directory},
+	m_format{format}
+{
+	m_writer = std::thread{[this] ()
+		{
+			writeFrames();
+		}
+	};
+}
+
+FrameExporter::~FrameExporter()
+{
+	{
+		std::lock_guard<std::mutex> lock{m_slotMutex};
+		m_stop = true;
+	}
+	m_slotCondition.notify_all();
+	m_writer.join();
+}
+
+bool FrameExporter::submit(const unsigned char* rgb, const glm::ivec2& size)
+{
+	FrameSlot& slot = m_slots[m_submittedCount % slotCount];
+	{
+		std::lock_guard<std::mutex> lock{m_slotMutex};
+		if (slot.isFull)
+		{
+			++m_droppedCount;
+			return false;
+		}
+	}
+
+	std::size_t byteCount = static_cast<std::size_t>(size.x) * size.y * 3;
+	slot.pixels.assign(rgb, rgb + byteCount);
+	slot.size = size;
+	slot.frameNumber = m_submittedCount + m_droppedCount;
+
+	{
+		std::lock_guard<std::mutex> lock{m_slotMutex};
+		slot.isFull = true;
+	}
+	m_slotCondition.notify_all();
+	++m_submittedCount;
+	return true;
+}
+
+void FrameExporter::flush()
+{
+	std::unique_lock<std::mutex> lock{m_slotMutex};
+	m_slotCondition.wait(lock, [this] ()
+		{
+			return std::none_of(m_slots.begin(), m_slots.end(),
+				[] (const FrameSlot& slot) { return slot.isFull; });
+		}
+	);
+}
+
+int FrameExporter::getSubmittedCount() const
+{
+	return m_submittedCount;
+}
+
+int FrameExporter::getWrittenCount() const
+{
+	return m_writtenCount;
+}
+
+int FrameExporter::getDroppedCount() const
+{
+	return m_droppedCount;
+}
+
+bool FrameExporter::isWriteFailed() const
+{
+	return m_isWriteFailed;
+}
+
+double FrameExporter::getMeanWriteMs() const
+{
+	int writtenCount = m_writtenCount;
+	return writtenCount > 0 ? m_writeSeconds * 1000 / writtenCount : 0;
+}
+
+std::optional<FrameExporter::Format> FrameExporter::parseFormat(const std::string& name)
+{
+	if (name == "png")
+	{
+		return Format::png;
+	}
+	if (name == "exr")
+	{
+		return Format::exr;
+	}
+	return std::nullopt;
+}
+
+void FrameExporter::writeFrames()
+{
+	using Clock = std::chrono::steady_clock;
+
+	for (int frame = 0; ; ++frame)
+	{
+		FrameSlot& slot = m_slots[frame % slotCount];
+		{
+			std::unique_lock<std::mutex> lock{m_slotMutex};
+			m_slotCondition.wait(lock, [this, &slot] ()
+				{
+					return slot.isFull || m_stop;
+				}
+			);
+			if (!slot.isFull)
+			{
+				return;
+			}
+		}
+
+		Clock::time_point start = Clock::now();
+		if (!writeFrame(slot))
+		{
+			m_isWriteFailed = true;
+		}
+		double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		m_writeSeconds = m_writeSeconds + seconds;
+		++m_writtenCount;
+
+		{
+			std::lock_guard<std::mutex> lock{m_slotMutex};
+			slot.isFull = false;
+		}
+		m_slotCondition.notify_all();
+	}
+}
+
+bool FrameExporter::writeFrame(const FrameSlot& slot) const
+{
+	std::vector<unsigned char> image = m_format == Format::exr ?
+		ExrEncoder::encode(slot.pixels.data(), slot.size) :
+		PngEncoder::encode(slot.pixels.data(), slot.size);
+
+	std::error_code error{};
+	std::filesystem::create_directories(m_directory, error);
+	std::array<char, 32> name{};
+	std::snprintf(name.data(), name.size(), "frame%06d.%s", slot.frameNumber,
+		m_format == Format::exr ? "exr" : "png");
+	std::ofstream file{m_directory / name.data(), std::ios::binary};
+	file.write(reinterpret_cast<const char*>(image.data()),
+		static_cast<std::streamsize>(image.size()));
+	return static_cast<bool>(file);
+}
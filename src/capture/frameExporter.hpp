@@ -0,0 +1,69 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+class FrameExporter
+{
+public:
+	enum class Format
+	{
+		png,
+		exr
+	};
+
+	static constexpr int slotCount = 8;
+
+	FrameExporter(const std::filesystem::path& directory, Format format);
+	FrameExporter(const FrameExporter&) = delete;
+	~FrameExporter();
+
+	FrameExporter& operator=(const FrameExporter&) = delete;
+
+	bool submit(const unsigned char* rgb, const glm::ivec2& size);
+	void flush();
+
+	int getSubmittedCount() const;
+	int getWrittenCount() const;
+	int getDroppedCount() const;
+	bool isWriteFailed() const;
+	double getMeanWriteMs() const;
+
+	static std::optional<Format> parseFormat(const std::string& name);
+
+private:
+	struct FrameSlot
+	{
+		std::vector<unsigned char> pixels{};
+		glm::ivec2 size{};
+		int frameNumber{};
+		bool isFull = false;
+	};
+
+	std::filesystem::path m_directory{};
+	Format m_format{};
+	std::array<FrameSlot, slotCount> m_slots{};
+	std::mutex m_slotMutex{};
+	std::condition_variable m_slotCondition{};
+	std::thread m_writer{};
+	bool m_stop = false;
+
+	int m_submittedCount = 0;
+	int m_droppedCount = 0;
+	std::atomic<int> m_writtenCount = 0;
+	std::atomic<bool> m_isWriteFailed = false;
+	std::atomic<double> m_writeSeconds = 0;
+
+	void writeFrames();
+	bool writeFrame(const FrameSlot& slot) const;
+};
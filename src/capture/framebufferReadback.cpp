@@ -0,0 +1,91 @@
+#include "capture/framebufferReadback.hpp"
+
+constexpr int numOfChannels = 3;
+constexpr int defaultPackAlignment = 4;
+
+FramebufferReadback::FramebufferReadback()
+{
+	for (PendingRead& read : m_reads)
+	{
+		glGenBuffers(1, &read.buffer);
+	}
+}
+
+FramebufferReadback::~FramebufferReadback()
+{
+	for (PendingRead& read : m_reads)
+	{
+		if (read.fence != nullptr)
+		{
+			glDeleteSync(read.fence);
+		}
+		glDeleteBuffers(1, &read.buffer);
+	}
+}
+
+bool FramebufferReadback::request(const glm::ivec2& offset, const glm::ivec2& size)
+{
+	PendingRead& read = m_reads[m_requestCount % bufferCount];
+	if (read.fence != nullptr)
+	{
+		return false;
+	}
+
+	std::size_t byteCount = static_cast<std::size_t>(size.x) * size.y * numOfChannels;
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, read.buffer);
+	if (read.capacity < byteCount)
+	{
+		glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(byteCount), nullptr,
+			GL_STREAM_READ);
+		read.capacity = byteCount;
+	}
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(offset.x, offset.y, size.x, size.y, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+	glPixelStorei(GL_PACK_ALIGNMENT, defaultPackAlignment);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	read.size = size;
+	read.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	++m_requestCount;
+	return true;
+}
+
+int FramebufferReadback::collect(FrameExporter& exporter)
+{
+	int collectedCount = 0;
+	while (m_collectCount < m_requestCount)
+	{
+		PendingRead& read = m_reads[m_collectCount % bufferCount];
+		GLenum status = glClientWaitSync(read.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		if (status == GL_TIMEOUT_EXPIRED)
+		{
+			break;
+		}
+		glDeleteSync(read.fence);
+		read.fence = nullptr;
+		++m_collectCount;
+		if (status == GL_WAIT_FAILED)
+		{
+			continue;
+		}
+
+		std::size_t byteCount = static_cast<std::size_t>(read.size.x) * read.size.y *
+			numOfChannels;
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, read.buffer);
+		const void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+			static_cast<GLsizeiptr>(byteCount), GL_MAP_READ_BIT);
+		if (pixels != nullptr)
+		{
+			exporter.submit(static_cast<const unsigned char*>(pixels), read.size);
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+			++collectedCount;
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	}
+	return collectedCount;
+}
+
+int FramebufferReadback::getPendingCount() const
+{
+	return m_requestCount - m_collectCount;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "capture/frameExporter.hpp"
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+
+class FramebufferReadback
+{
+public:
+	static constexpr int bufferCount = 3;
+
+	FramebufferReadback();
+	FramebufferReadback(const FramebufferReadback&) = delete;
+	~FramebufferReadback();
+
+	FramebufferReadback& operator=(const FramebufferReadback&) = delete;
+
+	bool request(const glm::ivec2& offset, const glm::ivec2& size);
+	int collect(FrameExporter& exporter);
+	int getPendingCount() const;
+
+private:
+	struct PendingRead
+	{
+		unsigned int buffer{};
+		std::size_t capacity{};
+		glm::ivec2 size{};
+		GLsync fence{};
+	};
+
+	std::array<PendingRead, bufferCount> m_reads{};
+	int m_requestCount = 0;
+	int m_collectCount = 0;
+};
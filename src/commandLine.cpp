@@ -0,0 +1,99 @@
+#include "commandLine.hpp"
+
+#include <iostream>
+
+CommandLine::CommandLine(int argc, char** argv)
+{
+	static const std::string optionPrefix = "--";
+
+	if (argc > 0)
+	{
+		m_programPath = argv[0];
+	}
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg.rfind(optionPrefix, 0) != 0)
+		{
+			if (m_mode.empty())
+			{
+				m_mode = arg;
+			}
+			else
+			{
+				std::cerr << "Ignoring unexpected argument: " << arg << '\n';
+			}
+			continue;
+		}
+
+		std::string name = arg.substr(optionPrefix.size());
+		if (i + 1 < argc && std::string{argv[i + 1]}.rfind(optionPrefix, 0) != 0)
+		{
+			m_options[name] = argv[++i];
+		}
+		else
+		{
+			m_options[name] = "";
+		}
+	}
+}
+
+const std::string& CommandLine::getProgramPath() const
+{
+	return m_programPath;
+}
+
+const std::string& CommandLine::getMode() const
+{
+	return m_mode;
+}
+
+bool CommandLine::hasOption(const std::string& name) const
+{
+	return m_options.contains(name);
+}
+
+std::string CommandLine::getString(const std::string& name, const std::string& defaultValue) const
+{
+	auto option = m_options.find(name);
+	return option != m_options.end() ? option->second : defaultValue;
+}
+
+int CommandLine::getInt(const std::string& name, int defaultValue) const
+{
+	auto option = m_options.find(name);
+	if (option == m_options.end())
+	{
+		return defaultValue;
+	}
+
+	try
+	{
+		return std::stoi(option->second);
+	}
+	catch (const std::exception&)
+	{
+		std::cerr << "Invalid value of --" << name << ": " << option->second << '\n';
+		return defaultValue;
+	}
+}
+
+float CommandLine::getFloat(const std::string& name, float defaultValue) const
+{
+	auto option = m_options.find(name);
+	if (option == m_options.end())
+	{
+		return defaultValue;
+	}
+
+	try
+	{
+		return std::stof(option->second);
+	}
+	catch (const std::exception&)
+	{
+		std::cerr << "Invalid value of --" << name << ": " << option->second << '\n';
+		return defaultValue;
+	}
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+class CommandLine
+{
+public:
+	CommandLine(int argc, char** argv);
+
+	const std::string& getProgramPath() const;
+	const std::string& getMode() const;
+	bool hasOption(const std::string& name) const;
+	std::string getString(const std::string& name, const std::string& defaultValue) const;
+	int getInt(const std::string& name, int defaultValue) const;
+	float getFloat(const std::string& name, float defaultValue) const;
+
+private:
+	std::string m_programPath{};
+	std::string m_mode{};
+	std::unordered_map<std::string, std::string> m_options{};
+};
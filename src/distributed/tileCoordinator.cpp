@@ -0,0 +1,321 @@
+#include "distributed/tileCoordinator.hpp"
+
+#include "distributed/workerProcess.hpp"
+#include "pngEncoder.hpp"
+#include "renderer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+
+constexpr std::size_t maxInFlightTilesPerWorker = 2;
+constexpr std::chrono::milliseconds acceptPollInterval{100};
+constexpr int defaultAcceptTimeoutMs = 10000;
+constexpr int defaultTileTimeoutMs = 30000;
+
+TileCoordinator::TileCoordinator(const RenderSettings& settings, int tileSize,
+	std::chrono::milliseconds tileTimeout) :
+	m_settings{settings},
+	m_tileTimeout{tileTimeout},
+	m_framebuffer(static_cast<std::size_t>(settings.resolution.x) * settings.resolution.y *
+		Renderer::numOfChannels, 0)
+{
+	for (int y = 0; y < settings.resolution.y; y += tileSize)
+	{
+		for (int x = 0; x < settings.resolution.x; x += tileSize)
+		{
+			glm::ivec2 offset{x, y};
+			m_tiles.push_back({offset, glm::min(offset + tileSize, settings.resolution) - offset});
+		}
+	}
+}
+
+bool TileCoordinator::render(const std::vector<Socket>& workers)
+{
+	using Clock = std::chrono::steady_clock;
+
+	Clock::time_point start = Clock::now();
+	m_stats = {};
+	m_stats.workerCount = static_cast<int>(workers.size());
+	m_stats.tileCount = static_cast<int>(m_tiles.size());
+	m_pendingTiles.clear();
+	for (std::uint32_t tileId = 0; tileId < m_tiles.size(); ++tileId)
+	{
+		m_pendingTiles.push_back(tileId);
+	}
+	m_remainingTileCount = static_cast<int>(m_tiles.size());
+	m_activeWorkerCount = static_cast<int>(workers.size());
+
+	std::vector<std::thread> threads{};
+	for (const Socket& worker : workers)
+	{
+		threads.emplace_back(&TileCoordinator::serveWorker, this, std::cref(worker));
+	}
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	double pixelCount = static_cast<double>(m_settings.resolution.x) * m_settings.resolution.y;
+	m_stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	m_stats.megapixelsPerSecond = m_stats.seconds > 0 ? pixelCount / m_stats.seconds / 1e6 : 0;
+	return m_remainingTileCount == 0;
+}
+
+const std::vector<unsigned char>& TileCoordinator::getFramebuffer() const
+{
+	return m_framebuffer;
+}
+
+const TileCoordinator::Stats& TileCoordinator::getStats() const
+{
+	return m_stats;
+}
+
+int TileCoordinator::run(const CommandLine& commandLine)
+{
+	RenderSettings settings = RenderSettings::fromCommandLine(commandLine);
+	int workerCount = std::max(commandLine.getInt("workers", 4), 0);
+
+	if (commandLine.hasOption("scaling"))
+	{
+		std::optional<Stats> baseline{};
+		std::cout << "workers  seconds  Mpixels/s  speedup  efficiency\n";
+		for (int count = 1; count <= workerCount; ++count)
+		{
+			std::optional<Stats> stats = renderWithWorkers(commandLine, settings, count, nullptr);
+			if (!stats.has_value())
+			{
+				return 1;
+			}
+			baseline = baseline.value_or(*stats);
+			double speedup = baseline->seconds / stats->seconds;
+			std::cout << count << "  " << stats->seconds << "  " << stats->megapixelsPerSecond <<
+				"  " << speedup << "  " << speedup / count * 100 << "%\n";
+		}
+		return 0;
+	}
+
+	std::vector<unsigned char> framebuffer{};
+	std::optional<Stats> stats = renderWithWorkers(commandLine, settings, workerCount,
+		&framebuffer);
+	if (!stats.has_value())
+	{
+		return 1;
+	}
+
+	std::cout << "resolution: " << settings.resolution.x << 'x' << settings.resolution.y <<
+		", " << stats->tileCount << " tiles on " << stats->workerCount << " workers\n";
+	std::cout << "time: " << stats->seconds << " s, " << stats->megapixelsPerSecond <<
+		" Mpixels/s\n";
+	if (stats->lostWorkerCount > 0)
+	{
+		std::cout << "lost workers: " << stats->lostWorkerCount << " (" <<
+			stats->timedOutWorkerCount << " timed out), retried tiles: " <<
+			stats->retriedTileCount << '\n';
+	}
+
+	std::string outputPath = commandLine.getString("output", "frame.png");
+	std::vector<unsigned char> png = PngEncoder::encode(framebuffer.data(), settings.resolution);
+	std::ofstream file{outputPath, std::ios::binary};
+	file.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+	return file.good() ? 0 : 1;
+}
+
+void TileCoordinator::serveWorker(const Socket& worker)
+{
+	std::vector<std::uint32_t> inFlightTiles{};
+	std::vector<unsigned char> message{};
+	bool isWorkerAlive = true;
+	bool isTimedOut = false;
+	while (isWorkerAlive)
+	{
+		std::optional<std::uint32_t> tileId{};
+		while (inFlightTiles.size() < maxInFlightTilesPerWorker &&
+			(tileId = takeTile(inFlightTiles.empty())).has_value())
+		{
+			Protocol::TileRequest request{*tileId, m_tiles[*tileId].offset,
+				m_tiles[*tileId].size, m_settings};
+			inFlightTiles.push_back(*tileId);
+			if (!worker.sendMessage(Protocol::serialize(request)))
+			{
+				isWorkerAlive = false;
+				break;
+			}
+		}
+		if (!isWorkerAlive || inFlightTiles.empty())
+		{
+			break;
+		}
+
+		if (!worker.waitReadable(m_tileTimeout))
+		{
+			isWorkerAlive = false;
+			isTimedOut = true;
+			break;
+		}
+
+		std::optional<Protocol::TileResponse> response{};
+		isWorkerAlive = worker.receiveMessage(message) &&
+			(response = Protocol::parseTileResponse(message)).has_value() &&
+			storeTile(*response, inFlightTiles);
+	}
+
+	std::lock_guard<std::mutex> lock{m_tileMutex};
+	--m_activeWorkerCount;
+	if (!isWorkerAlive)
+	{
+		++m_stats.lostWorkerCount;
+		m_stats.timedOutWorkerCount += isTimedOut ? 1 : 0;
+		m_stats.retriedTileCount += static_cast<int>(inFlightTiles.size());
+		m_pendingTiles.insert(m_pendingTiles.begin(), inFlightTiles.begin(), inFlightTiles.end());
+	}
+	m_tileCondition.notify_all();
+}
+
+std::optional<std::uint32_t> TileCoordinator::takeTile(bool shouldWait)
+{
+	std::unique_lock<std::mutex> lock{m_tileMutex};
+	if (shouldWait)
+	{
+		m_tileCondition.wait(lock, [this] ()
+			{
+				return !m_pendingTiles.empty() || m_remainingTileCount == 0 ||
+					m_activeWorkerCount == 1;
+			}
+		);
+	}
+	if (m_pendingTiles.empty())
+	{
+		return std::nullopt;
+	}
+
+	std::uint32_t tileId = m_pendingTiles.front();
+	m_pendingTiles.pop_front();
+	return tileId;
+}
+
+bool TileCoordinator::storeTile(const Protocol::TileResponse& response,
+	std::vector<std::uint32_t>& inFlightTiles)
+{
+	auto inFlightTile = std::find(inFlightTiles.begin(), inFlightTiles.end(), response.tileId);
+	if (inFlightTile == inFlightTiles.end())
+	{
+		return false;
+	}
+
+	const Tile& tile = m_tiles[response.tileId];
+	std::size_t rowSize = static_cast<std::size_t>(tile.size.x) * Renderer::numOfChannels;
+	if (response.offset != tile.offset || response.size != tile.size ||
+		response.pixels.size() != rowSize * tile.size.y)
+	{
+		return false;
+	}
+
+	for (int y = 0; y < tile.size.y; ++y)
+	{
+		std::size_t targetIndex = (static_cast<std::size_t>(tile.offset.y + y) *
+			m_settings.resolution.x + tile.offset.x) * Renderer::numOfChannels;
+		std::memcpy(m_framebuffer.data() + targetIndex, response.pixels.data() + y * rowSize,
+			rowSize);
+	}
+	inFlightTiles.erase(inFlightTile);
+
+	std::lock_guard<std::mutex> lock{m_tileMutex};
+	--m_remainingTileCount;
+	m_tileCondition.notify_all();
+	return true;
+}
+
+std::optional<TileCoordinator::Stats> TileCoordinator::renderWithWorkers(
+	const CommandLine& commandLine, const RenderSettings& settings, int spawnedWorkerCount,
+	std::vector<unsigned char>* framebuffer)
+{
+	std::string address = commandLine.getString("listen", "ellipsoid-raycasting-tiles.sock");
+	Socket listenSocket = Socket::listen(address);
+	if (!listenSocket.isValid())
+	{
+		return std::nullopt;
+	}
+
+	std::vector<std::string> workerArguments{"worker", "--connect", address, "--threads",
+		commandLine.getString("worker-threads", "1")};
+	std::deque<WorkerProcess> processes{};
+	for (int i = 0; i < spawnedWorkerCount; ++i)
+	{
+		std::vector<std::string> arguments = workerArguments;
+		if (i == 0 && commandLine.hasOption("fail-after"))
+		{
+			arguments.insert(arguments.end(),
+				{"--max-tiles", commandLine.getString("fail-after", "1")});
+		}
+		processes.emplace_back(commandLine.getProgramPath(), arguments);
+	}
+
+	using Clock = std::chrono::steady_clock;
+
+	int externalWorkerCount = std::max(commandLine.getInt("expect", 0), 0);
+	Clock::time_point deadline = Clock::now() + std::chrono::milliseconds{
+		std::max(commandLine.getInt("accept-timeout-ms", defaultAcceptTimeoutMs), 0)};
+	std::vector<Socket> workers{};
+	while (true)
+	{
+		int workerCount = externalWorkerCount;
+		for (WorkerProcess& process : processes)
+		{
+			workerCount += process.isRunning() ? 1 : 0;
+		}
+		if (static_cast<int>(workers.size()) >= workerCount)
+		{
+			break;
+		}
+		if (Clock::now() >= deadline)
+		{
+			std::cerr << "Timed out with " << workers.size() << " of " << workerCount <<
+				" workers connected\n";
+			break;
+		}
+
+		if (!listenSocket.waitReadable(acceptPollInterval))
+		{
+			continue;
+		}
+		Socket worker = listenSocket.accept();
+		if (worker.isValid())
+		{
+			workers.push_back(std::move(worker));
+		}
+	}
+	if (workers.empty())
+	{
+		std::cerr << "No workers connected\n";
+		return std::nullopt;
+	}
+
+	TileCoordinator coordinator{settings, std::max(commandLine.getInt("tile", 64), 1),
+		std::chrono::milliseconds{std::max(commandLine.getInt("tile-timeout-ms",
+			defaultTileTimeoutMs), 1)}};
+	bool isRendered = coordinator.render(workers);
+	for (const Socket& worker : workers)
+	{
+		worker.shutdown();
+	}
+	if (!isRendered)
+	{
+		std::cerr << "All workers were lost before the frame was finished\n";
+		return std::nullopt;
+	}
+
+	if (framebuffer != nullptr)
+	{
+		*framebuffer = coordinator.getFramebuffer();
+	}
+	return coordinator.getStats();
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "commandLine.hpp"
+#include "network/socket.hpp"
+#include "renderSettings.hpp"
+#include "service/protocol.hpp"
+
+#include <glm/glm.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+class TileCoordinator
+{
+public:
+	struct Stats
+	{
+		int workerCount{};
+		int lostWorkerCount{};
+		int timedOutWorkerCount{};
+		int tileCount{};
+		int retriedTileCount{};
+		double seconds{};
+		double megapixelsPerSecond{};
+	};
+
+	TileCoordinator(const RenderSettings& settings, int tileSize,
+		std::chrono::milliseconds tileTimeout);
+
+	bool render(const std::vector<Socket>& workers);
+	const std::vector<unsigned char>& getFramebuffer() const;
+	const Stats& getStats() const;
+
+	static int run(const CommandLine& commandLine);
+
+private:
+	struct Tile
+	{
+		glm::ivec2 offset{};
+		glm::ivec2 size{};
+	};
+
+	RenderSettings m_settings{};
+	std::chrono::milliseconds m_tileTimeout{};
+	std::vector<Tile> m_tiles{};
+	std::vector<unsigned char> m_framebuffer{};
+
+	std::deque<std::uint32_t> m_pendingTiles{};
+	int m_remainingTileCount{};
+	int m_activeWorkerCount{};
+	std::mutex m_tileMutex{};
+	std::condition_variable m_tileCondition{};
+	Stats m_stats{};
+
+	void serveWorker(const Socket& worker);
+	std::optional<std::uint32_t> takeTile(bool shouldWait);
+	bool storeTile(const Protocol::TileResponse& response,
+		std::vector<std::uint32_t>& inFlightTiles);
+
+	static std::optional<Stats> renderWithWorkers(const CommandLine& commandLine,
+		const RenderSettings& settings, int spawnedWorkerCount,
+		std::vector<unsigned char>* framebuffer);
+};
@@ -0,0 +1,106 @@
+#include "distributed/tileWorker.hpp"
+
+#include "camera.hpp"
+#include "ellipsoid.hpp"
+#include "raycaster.hpp"
+#include "renderer.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+
+constexpr int apronPixels = 1;
+
+TileWorker::TileWorker(Socket socket, int threadCount, int maxTileCount) :
+	m_socket{std::move(socket)},
+	m_threadPool{threadCount},
+	m_maxTileCount{maxTileCount}
+{ }
+
+int TileWorker::serve()
+{
+	using Clock = std::chrono::steady_clock;
+
+	std::vector<unsigned char> message{};
+	for (int tileCount = 0; tileCount < m_maxTileCount && m_socket.receiveMessage(message);
+		++tileCount)
+	{
+		std::optional<Protocol::TileRequest> request = Protocol::parseTileRequest(message);
+		if (!request.has_value())
+		{
+			return 1;
+		}
+
+		Clock::time_point start = Clock::now();
+		Protocol::TileResponse response{};
+		response.tileId = request->tileId;
+		response.offset = request->offset;
+		response.size = request->size;
+		response.pixels = renderTile(*request);
+		response.renderTimeUs = static_cast<std::uint32_t>(
+			std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+		if (!m_socket.sendMessage(Protocol::serialize(response)))
+		{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+int TileWorker::run(const CommandLine& commandLine)
+{
+	Socket socket = Socket::connect(commandLine.getString("connect",
+		"ellipsoid-raycasting-tiles.sock"));
+	if (!socket.isValid())
+	{
+		return 1;
+	}
+
+	TileWorker worker{std::move(socket),
+		commandLine.getInt("threads", ThreadPool::defaultThreadCount()),
+		commandLine.getInt("max-tiles", std::numeric_limits<int>::max())};
+	return worker.serve();
+}
+
+std::vector<unsigned char> TileWorker::renderTile(const Protocol::TileRequest& request)
+{
+	const glm::ivec2& imageSize = request.settings.resolution;
+	glm::ivec2 regionStart = glm::max(request.offset - apronPixels, glm::ivec2{0, 0});
+	glm::ivec2 regionEnd = glm::min(request.offset + request.size + apronPixels, imageSize);
+	glm::ivec2 regionSize = regionEnd - regionStart;
+
+	glm::ivec2 viewportSize = imageSize;
+	Camera camera{viewportSize, Camera::defaultNearPlane, Camera::defaultFarPlane,
+		request.settings.camera.viewWidth};
+	Ellipsoid ellipsoid{request.settings.radii.x, request.settings.radii.y,
+		request.settings.radii.z};
+	request.settings.apply(camera, ellipsoid);
+	Raycaster raycaster{camera, ellipsoid};
+
+	Renderer renderer{regionSize};
+	renderer.setImageRegion(imageSize, regionStart);
+	renderer.drawPass(raycaster, 1, true, m_threadPool);
+	if (request.settings.antialiasingSamples > 1)
+	{
+		renderer.antialias(raycaster, request.settings.antialiasingSamples, m_threadPool);
+	}
+
+	std::span<const unsigned char> regionPixels = renderer.getCpuTexture();
+	std::size_t rowSize = static_cast<std::size_t>(request.size.x) * Renderer::numOfChannels;
+	std::vector<unsigned char> pixels(rowSize * request.size.y);
+	glm::ivec2 cropOffset = request.offset - regionStart;
+	for (int y = 0; y < request.size.y; ++y)
+	{
+		std::size_t sourceIndex = (static_cast<std::size_t>(y + cropOffset.y) * regionSize.x +
+			cropOffset.x) * Renderer::numOfChannels;
+		std::memcpy(pixels.data() + y * rowSize, regionPixels.data() + sourceIndex, rowSize);
+	}
+	return pixels;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "commandLine.hpp"
+#include "network/socket.hpp"
+#include "service/protocol.hpp"
+#include "threadPool.hpp"
+
+#include <vector>
+
+class TileWorker
+{
+public:
+	TileWorker(Socket socket, int threadCount, int maxTileCount);
+
+	int serve();
+
+	static int run(const CommandLine& commandLine);
+
+private:
+	Socket m_socket;
+	ThreadPool m_threadPool;
+	int m_maxTileCount{};
+
+	std::vector<unsigned char> renderTile(const Protocol::TileRequest& request);
+};
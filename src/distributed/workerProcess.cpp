@@ -0,0 +1,105 @@
+#include "distributed/workerProcess.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <spawn.h>
+#include <sys/wait.h>
+
+extern char** environ;
+#endif
+
+#include <iostream>
+
+WorkerProcess::WorkerProcess(const std::string& programPath,
+	const std::vector<std::string>& arguments)
+{
+#ifdef _WIN32
+	std::string commandLine = '"' + programPath + '"';
+	for (const std::string& argument : arguments)
+	{
+		commandLine += " \"" + argument + '"';
+	}
+
+	STARTUPINFOA startupInfo{};
+	startupInfo.cb = sizeof(startupInfo);
+	PROCESS_INFORMATION processInfo{};
+	if (CreateProcessA(nullptr, commandLine.data(), nullptr, nullptr, FALSE, 0, nullptr, nullptr,
+		&startupInfo, &processInfo))
+	{
+		CloseHandle(processInfo.hThread);
+		m_processHandle = processInfo.hProcess;
+	}
+#else
+	std::vector<char*> argv{const_cast<char*>(programPath.c_str())};
+	for (const std::string& argument : arguments)
+	{
+		argv.push_back(const_cast<char*>(argument.c_str()));
+	}
+	argv.push_back(nullptr);
+
+	pid_t processId{};
+	if (posix_spawnp(&processId, programPath.c_str(), nullptr, nullptr, argv.data(),
+		environ) == 0)
+	{
+		m_processId = processId;
+	}
+#endif
+
+	if (!isValid())
+	{
+		std::cerr << "Cannot start worker process " << programPath << '\n';
+	}
+}
+
+WorkerProcess::~WorkerProcess()
+{
+	wait();
+}
+
+bool WorkerProcess::isValid() const
+{
+#ifdef _WIN32
+	return m_processHandle != nullptr;
+#else
+	return m_processId > 0;
+#endif
+}
+
+bool WorkerProcess::isRunning()
+{
+	if (!isValid())
+	{
+		return false;
+	}
+
+#ifdef _WIN32
+	return WaitForSingleObject(m_processHandle, 0) == WAIT_TIMEOUT;
+#else
+	int status{};
+	pid_t processId = waitpid(m_processId, &status, WNOHANG);
+	if (processId == m_processId)
+	{
+		m_processId = -1;
+	}
+	return processId == 0;
+#endif
+}
+
+void WorkerProcess::wait()
+{
+	if (!isValid())
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	WaitForSingleObject(m_processHandle, INFINITE);
+	CloseHandle(m_processHandle);
+	m_processHandle = nullptr;
+#else
+	int status{};
+	waitpid(m_processId, &status, 0);
+	m_processId = -1;
+#endif
+}
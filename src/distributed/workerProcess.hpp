@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+class WorkerProcess
+{
+public:
+	WorkerProcess(const std::string& programPath, const std::vector<std::string>& arguments);
+	WorkerProcess(const WorkerProcess&) = delete;
+	~WorkerProcess();
+
+	WorkerProcess& operator=(const WorkerProcess&) = delete;
+
+	bool isValid() const;
+	bool isRunning();
+	void wait();
+
+private:
+#ifdef _WIN32
+	void* m_processHandle{};
+#else
+	int m_processId = -1;
+#endif
+};
@@ -0,0 +1,147 @@
+#include "embed/ellipsoidRaycasting.h"
+
+#include "embed/renderContext.hpp"
+#include "material.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <new>
+
+struct ErContext
+{
+	RenderContext renderContext;
+};
+
+static bool areFinite(std::initializer_list<float> values)
+{
+	return std::ranges::all_of(values, [] (float value) { return std::isfinite(value); });
+}
+
+std::uint32_t erGetApiVersion(void)
+{
+	return ER_API_VERSION;
+}
+
+ErContext* erCreateContext(std::int32_t imageWidth, std::int32_t imageHeight)
+{
+	if (!RenderContext::isImageSizeValid({imageWidth, imageHeight}))
+	{
+		return nullptr;
+	}
+	return new (std::nothrow) ErContext{RenderContext{{imageWidth, imageHeight}}};
+}
+
+void erDestroyContext(ErContext* context)
+{
+	delete context;
+}
+
+ErStatus erSetImageSize(ErContext* context, std::int32_t imageWidth, std::int32_t imageHeight)
+{
+	if (context == nullptr || !RenderContext::isImageSizeValid({imageWidth, imageHeight}))
+	{
+		return ER_INVALID_ARGUMENT;
+	}
+	context->renderContext.setImageSize({imageWidth, imageHeight});
+	return ER_OK;
+}
+
+ErStatus erSetCamera(ErContext* context, const ErCamera* camera)
+{
+	if (context == nullptr || camera == nullptr || !areFinite({camera->targetPos[0],
+		camera->targetPos[1], camera->targetPos[2], camera->pitchRad, camera->yawRad,
+		camera->viewWidth}) || camera->viewWidth <= 0)
+	{
+		return ER_INVALID_ARGUMENT;
+	}
+	context->renderContext.setCamera({{camera->targetPos[0], camera->targetPos[1],
+		camera->targetPos[2]}, camera->pitchRad, camera->yawRad, camera->viewWidth});
+	return ER_OK;
+}
+
+ErStatus erGetCamera(const ErContext* context, ErCamera* camera)
+{
+	if (context == nullptr || camera == nullptr)
+	{
+		return ER_INVALID_ARGUMENT;
+	}
+	const CameraState& state = context->renderContext.getCamera();
+	*camera = {{state.targetPos.x, state.targetPos.y, state.targetPos.z}, state.pitchRad,
+		state.yawRad, state.viewWidth};
+	return ER_OK;
+}
+
+ErStatus erSetEllipsoid(ErContext* context, float a, float b, float c)
+{
+	if (context == nullptr || !areFinite({a, b, c}) || a <= 0 || b <= 0 || c <= 0)
+	{
+		return ER_INVALID_ARGUMENT;
+	}
+	context->renderContext.setEllipsoid({a, b, c});
+	return ER_OK;
+}
+
+ErStatus erSetMaterial(ErContext* context, const ErMaterial* material)
+{
+	if (context == nullptr || material == nullptr)
+	{
+		return ER_INVALID_ARGUMENT;
+	}
+
+	Material renderMaterial{{material->color[0], material->color[1], material->color[2]},
+		material->ambient, material->diffuse, material->specular, material->shininess};
+	if (!renderMaterial.isValid())
+	{
+		return ER_INVALID_ARGUMENT;
+	}
+	context->renderContext.setMaterial(renderMaterial);
+	return ER_OK;
+}
+
+ErStatus erSetAntialiasing(ErContext* context, std::int32_t samples)
+{
+	if (context == nullptr || samples < 1 || samples > RenderContext::maxAntialiasingSamples)
+	{
+		return ER_INVALID_ARGUMENT;
+	}
+	context->renderContext.setAntialiasing(samples);
+	return ER_OK;
+}
+
+ErStatus erSetPrecision(ErContext* context, ErPrecision precision)
+{
+	if (context == nullptr || precision < ER_PRECISION_FP32 || precision > ER_PRECISION_FP64)
+	{
+		return ER_INVALID_ARGUMENT;
+	}
+	context->renderContext.setPrecision(static_cast<Raycaster::Precision>(precision));
+	return ER_OK;
+}
+
+ErStatus erRender(ErContext* context, const ErRegion* region, void* pixels,
+	std::ptrdiff_t rowStride, ErPixelFormat format)
+{
+	if (context == nullptr || region == nullptr || pixels == nullptr ||
+		format < ER_PIXEL_FORMAT_RGB8 || format > ER_PIXEL_FORMAT_BGRA8)
+	{
+		return ER_INVALID_ARGUMENT;
+	}
+
+	const glm::ivec2& imageSize = context->renderContext.getImageSize();
+	RenderContext::PixelFormat pixelFormat = static_cast<RenderContext::PixelFormat>(format);
+	if (region->width <= 0 || region->height <= 0 || region->x < 0 || region->y < 0 ||
+		region->x > imageSize.x - region->width || region->y > imageSize.y - region->height ||
+		std::abs(rowStride) <
+		static_cast<std::ptrdiff_t>(region->width) * RenderContext::getPixelSize(pixelFormat))
+	{
+		return ER_INVALID_ARGUMENT;
+	}
+
+	context->renderContext.render({region->x, region->y}, {region->width, region->height},
+		static_cast<unsigned char*>(pixels), rowStride, pixelFormat);
+	return ER_OK;
+}
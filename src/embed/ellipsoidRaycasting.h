@@ -0,0 +1,88 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32) && defined(ER_BUILD_LIBRARY)
+#define ER_API __declspec(dllexport)
+#elif defined(_WIN32)
+#define ER_API __declspec(dllimport)
+#elif defined(__GNUC__)
+#define ER_API __attribute__((visibility("default")))
+#else
+#define ER_API
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define ER_API_VERSION 1
+
+typedef struct ErContext ErContext;
+
+typedef enum ErStatus
+{
+	ER_OK = 0,
+	ER_INVALID_ARGUMENT = 1
+} ErStatus;
+
+typedef enum ErPixelFormat
+{
+	ER_PIXEL_FORMAT_RGB8 = 0,
+	ER_PIXEL_FORMAT_RGBA8 = 1,
+	ER_PIXEL_FORMAT_BGRA8 = 2
+} ErPixelFormat;
+
+typedef enum ErPrecision
+{
+	ER_PRECISION_FP32 = 0,
+	ER_PRECISION_ADAPTIVE = 1,
+	ER_PRECISION_FP64 = 2
+} ErPrecision;
+
+typedef struct ErCamera
+{
+	float targetPos[3];
+	float pitchRad;
+	float yawRad;
+	float viewWidth;
+} ErCamera;
+
+typedef struct ErMaterial
+{
+	uint8_t color[3];
+	float ambient;
+	float diffuse;
+	float specular;
+	float shininess;
+} ErMaterial;
+
+typedef struct ErRegion
+{
+	int32_t x;
+	int32_t y;
+	int32_t width;
+	int32_t height;
+} ErRegion;
+
+ER_API uint32_t erGetApiVersion(void);
+
+ER_API ErContext* erCreateContext(int32_t imageWidth, int32_t imageHeight);
+ER_API void erDestroyContext(ErContext* context);
+
+ER_API ErStatus erSetImageSize(ErContext* context, int32_t imageWidth, int32_t imageHeight);
+ER_API ErStatus erSetCamera(ErContext* context, const ErCamera* camera);
+ER_API ErStatus erGetCamera(const ErContext* context, ErCamera* camera);
+ER_API ErStatus erSetEllipsoid(ErContext* context, float a, float b, float c);
+ER_API ErStatus erSetMaterial(ErContext* context, const ErMaterial* material);
+ER_API ErStatus erSetAntialiasing(ErContext* context, int32_t samples);
+ER_API ErStatus erSetPrecision(ErContext* context, ErPrecision precision);
+
+ER_API ErStatus erRender(ErContext* context, const ErRegion* region, void* pixels,
+	ptrdiff_t rowStride, ErPixelFormat format);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,123 @@
+#include "embed/renderContext.hpp"
+
+#include <cstddef>
+#include <span>
+
+constexpr int apronPixels = 1;
+constexpr unsigned char maxChannelValue = 255;
+
+RenderContext::RenderContext(const glm::ivec2& imageSize) :
+	m_camera{m_settings.resolution, Camera::defaultNearPlane, Camera::defaultFarPlane,
+		Camera::defaultViewWidth},
+	m_ellipsoid{m_settings.radii.x, m_settings.radii.y, m_settings.radii.z},
+	m_raycaster{m_camera, m_ellipsoid}
+{
+	m_settings.resolution = imageSize;
+	update();
+}
+
+const glm::ivec2& RenderContext::getImageSize() const
+{
+	return m_settings.resolution;
+}
+
+void RenderContext::setImageSize(const glm::ivec2& imageSize)
+{
+	m_settings.resolution = imageSize;
+	update();
+}
+
+const CameraState& RenderContext::getCamera() const
+{
+	return m_settings.camera;
+}
+
+void RenderContext::setCamera(const CameraState& camera)
+{
+	m_settings.camera = camera;
+	update();
+}
+
+void RenderContext::setEllipsoid(const glm::vec3& radii)
+{
+	m_settings.radii = radii;
+	update();
+}
+
+void RenderContext::setMaterial(const Material& material)
+{
+	m_settings.material = material;
+	update();
+}
+
+void RenderContext::setAntialiasing(int samples)
+{
+	m_settings.antialiasingSamples = samples;
+}
+
+void RenderContext::setPrecision(Raycaster::Precision precision)
+{
+	m_precision = precision;
+	m_raycaster.setPrecision(precision);
+}
+
+void RenderContext::render(const glm::ivec2& regionOffset, const glm::ivec2& regionSize,
+	unsigned char* pixels, std::ptrdiff_t rowStride, PixelFormat format)
+{
+	const glm::ivec2& imageSize = m_settings.resolution;
+	glm::ivec2 requestStart{regionOffset.x, imageSize.y - regionOffset.y - regionSize.y};
+	glm::ivec2 regionStart = glm::max(requestStart - apronPixels, glm::ivec2{0, 0});
+	glm::ivec2 regionEnd = glm::min(requestStart + regionSize + apronPixels, imageSize);
+	m_regionSize = regionEnd - regionStart;
+	m_renderer.updateViewportSize();
+	m_renderer.setImageRegion(imageSize, regionStart);
+	m_renderer.drawPass(m_raycaster, 1, true, m_threadPool);
+	if (m_settings.antialiasingSamples > 1)
+	{
+		m_renderer.antialias(m_raycaster, m_settings.antialiasingSamples, m_threadPool);
+	}
+
+	std::span<const unsigned char> cpuTexture = m_renderer.getCpuTexture();
+	std::span<const unsigned char> hitMask = m_renderer.getHitMask();
+	const glm::ivec2 cropOffset = requestStart - regionStart;
+	const int pixelSize = getPixelSize(format);
+	const bool isBgr = format == PixelFormat::bgra8;
+	const bool hasAlpha = format != PixelFormat::rgb8;
+	for (int row = 0; row < regionSize.y; ++row)
+	{
+		unsigned char* pixel = pixels + row * rowStride;
+		std::size_t sourceIndex = static_cast<std::size_t>(cropOffset.y + regionSize.y - 1 - row) *
+			m_regionSize.x + cropOffset.x;
+		for (int column = 0; column < regionSize.x; ++column)
+		{
+			const unsigned char* color = cpuTexture.data() + sourceIndex * Renderer::numOfChannels;
+			pixel[0] = color[isBgr ? 2 : 0];
+			pixel[1] = color[1];
+			pixel[2] = color[isBgr ? 0 : 2];
+			if (hasAlpha)
+			{
+				pixel[3] = hitMask[sourceIndex] != 0 ? maxChannelValue : 0;
+			}
+			pixel += pixelSize;
+			++sourceIndex;
+		}
+	}
+}
+
+int RenderContext::getPixelSize(PixelFormat format)
+{
+	return format == PixelFormat::rgb8 ? Renderer::numOfChannels : Renderer::numOfChannels + 1;
+}
+
+bool RenderContext::isImageSizeValid(const glm::ivec2& imageSize)
+{
+	return imageSize.x > 0 && imageSize.y > 0 && imageSize.x <= maxImageExtent &&
+		imageSize.y <= maxImageExtent;
+}
+
+void RenderContext::update()
+{
+	m_settings.apply(m_camera, m_ellipsoid);
+	m_raycaster = Raycaster{m_camera, m_ellipsoid};
+	m_raycaster.setPrecision(m_precision);
+}
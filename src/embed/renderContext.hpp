@@ -0,0 +1,59 @@
+#pragma once
+
+#include "camera.hpp"
+#include "ellipsoid.hpp"
+#include "material.hpp"
+#include "raycaster.hpp"
+#include "renderSettings.hpp"
+#include "renderer.hpp"
+#include "threadPool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+
+class RenderContext
+{
+public:
+	static constexpr int maxAntialiasingSamples = 8;
+	static constexpr int maxImageExtent = 16384;
+
+	enum class PixelFormat
+	{
+		rgb8,
+		rgba8,
+		bgra8
+	};
+
+	RenderContext(const glm::ivec2& imageSize);
+	RenderContext(const RenderContext&) = delete;
+
+	RenderContext& operator=(const RenderContext&) = delete;
+
+	const glm::ivec2& getImageSize() const;
+	void setImageSize(const glm::ivec2& imageSize);
+	const CameraState& getCamera() const;
+	void setCamera(const CameraState& camera);
+	void setEllipsoid(const glm::vec3& radii);
+	void setMaterial(const Material& material);
+	void setAntialiasing(int samples);
+	void setPrecision(Raycaster::Precision precision);
+
+	void render(const glm::ivec2& regionOffset, const glm::ivec2& regionSize,
+		unsigned char* pixels, std::ptrdiff_t rowStride, PixelFormat format);
+
+	static int getPixelSize(PixelFormat format);
+	static bool isImageSizeValid(const glm::ivec2& imageSize);
+
+private:
+	RenderSettings m_settings{};
+	Camera m_camera;
+	Ellipsoid m_ellipsoid;
+	Raycaster m_raycaster;
+	Raycaster::Precision m_precision = Raycaster::Precision::adaptive;
+	glm::ivec2 m_regionSize{1, 1};
+	ThreadPool m_threadPool{};
+	Renderer m_renderer{m_regionSize};
+
+	void update();
+};
@@ -0,0 +1,134 @@
+#include "exrEncoder.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace ExrEncoder
+{
+	constexpr int numOfChannels = 3;
+	constexpr std::array<unsigned char, 4> magic{0x76, 0x2f, 0x31, 0x01};
+	constexpr std::uint32_t version = 2;
+	constexpr std::uint32_t floatPixelType = 2;
+	constexpr std::array<const char*, numOfChannels> channelNames{"B", "G", "R"};
+	constexpr std::array<int, numOfChannels> channelOffsets{2, 1, 0};
+
+	void appendUint32(std::vector<unsigned char>& bytes, std::uint32_t value)
+	{
+		for (int shift = 0; shift < 32; shift += 8)
+		{
+			bytes.push_back(static_cast<unsigned char>(value >> shift));
+		}
+	}
+
+	void appendUint64(std::vector<unsigned char>& bytes, std::uint64_t value)
+	{
+		appendUint32(bytes, static_cast<std::uint32_t>(value));
+		appendUint32(bytes, static_cast<std::uint32_t>(value >> 32));
+	}
+
+	void appendFloat(std::vector<unsigned char>& bytes, float value)
+	{
+		std::uint32_t bits{};
+		std::memcpy(&bits, &value, sizeof(bits));
+		appendUint32(bytes, bits);
+	}
+
+	void appendString(std::vector<unsigned char>& bytes, const std::string& value)
+	{
+		bytes.insert(bytes.end(), value.begin(), value.end());
+		bytes.push_back(0);
+	}
+
+	void appendAttribute(std::vector<unsigned char>& header, const std::string& name,
+		const std::string& type, const std::vector<unsigned char>& value)
+	{
+		appendString(header, name);
+		appendString(header, type);
+		appendUint32(header, static_cast<std::uint32_t>(value.size()));
+		header.insert(header.end(), value.begin(), value.end());
+	}
+
+	std::vector<unsigned char> encodeChannels()
+	{
+		std::vector<unsigned char> channels{};
+		for (const char* name : channelNames)
+		{
+			appendString(channels, name);
+			appendUint32(channels, floatPixelType);
+			channels.insert(channels.end(), {0, 0, 0, 0});
+			appendUint32(channels, 1);
+			appendUint32(channels, 1);
+		}
+		channels.push_back(0);
+		return channels;
+	}
+
+	std::vector<unsigned char> encodeBox(const glm::ivec2& size)
+	{
+		std::vector<unsigned char> box{};
+		appendUint32(box, 0);
+		appendUint32(box, 0);
+		appendUint32(box, static_cast<std::uint32_t>(size.x - 1));
+		appendUint32(box, static_cast<std::uint32_t>(size.y - 1));
+		return box;
+	}
+
+	std::array<float, 256> createLinearTable()
+	{
+		std::array<float, 256> table{};
+		for (std::size_t i = 0; i < table.size(); ++i)
+		{
+			float value = i / 255.0f;
+			table[i] = value <= 0.04045f ? value / 12.92f :
+				std::pow((value + 0.055f) / 1.055f, 2.4f);
+		}
+		return table;
+	}
+
+	std::vector<unsigned char> encode(const unsigned char* rgb, const glm::ivec2& size)
+	{
+		static const std::array<float, 256> linearTable = createLinearTable();
+
+		std::vector<unsigned char> exr(magic.begin(), magic.end());
+		appendUint32(exr, version);
+		std::vector<unsigned char> floatOne{};
+		appendFloat(floatOne, 1.0f);
+		appendAttribute(exr, "channels", "chlist", encodeChannels());
+		appendAttribute(exr, "compression", "compression", {0});
+		appendAttribute(exr, "dataWindow", "box2i", encodeBox(size));
+		appendAttribute(exr, "displayWindow", "box2i", encodeBox(size));
+		appendAttribute(exr, "lineOrder", "lineOrder", {0});
+		appendAttribute(exr, "pixelAspectRatio", "float", floatOne);
+		appendAttribute(exr, "screenWindowCenter", "v2f", std::vector<unsigned char>(8, 0));
+		appendAttribute(exr, "screenWindowWidth", "float", floatOne);
+		exr.push_back(0);
+
+		std::size_t rowSize = static_cast<std::size_t>(size.x) * numOfChannels;
+		std::size_t blockSize = 2 * sizeof(std::uint32_t) + rowSize * sizeof(float);
+		std::size_t firstBlock = exr.size() + size.y * sizeof(std::uint64_t);
+		exr.reserve(firstBlock + size.y * blockSize);
+		for (int y = 0; y < size.y; ++y)
+		{
+			appendUint64(exr, firstBlock + y * blockSize);
+		}
+
+		for (int y = 0; y < size.y; ++y)
+		{
+			appendUint32(exr, static_cast<std::uint32_t>(y));
+			appendUint32(exr, static_cast<std::uint32_t>(rowSize * sizeof(float)));
+			const unsigned char* row = rgb + (size.y - 1 - y) * rowSize;
+			for (int channelOffset : channelOffsets)
+			{
+				for (int x = 0; x < size.x; ++x)
+				{
+					appendFloat(exr, linearTable[row[x * numOfChannels + channelOffset]]);
+				}
+			}
+		}
+		return exr;
+	}
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace ExrEncoder
+{
+	std::vector<unsigned char> encode(const unsigned char* rgb, const glm::ivec2& size);
+}
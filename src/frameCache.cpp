@@ -0,0 +1,478 @@
+#include "frameCache.hpp"
+
+#include "renderer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+
+constexpr std::uint64_t fnvOffsetBasis = 14695981039346656037ull;
+constexpr std::uint64_t fnvPrime = 1099511628211ull;
+constexpr std::array<char, 4> diskMagic{'E', 'R', 'F', 'C'};
+
+template <typename T>
+static std::uint64_t hashValues(const T* values, std::size_t count, std::uint64_t hash)
+{
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(values);
+	for (std::size_t i = 0; i < count * sizeof(T); ++i)
+	{
+		hash = (hash ^ bytes[i]) * fnvPrime;
+	}
+	return hash;
+}
+
+std::size_t FrameCache::Entry::getByteCount() const
+{
+	return pixels.size() + hitMask.size();
+}
+
+FrameCache::FrameCache(std::size_t capacityBytes, const std::filesystem::path& diskDirectory) :
+	m_capacityBytes{capacityBytes},
+	m_diskDirectory{diskDirectory}
+{
+	if (m_diskDirectory.empty())
+	{
+		return;
+	}
+
+	scanDiskDirectory();
+	m_loadingKeys.reserve(diskQueueSize);
+	m_loadedEntries.reserve(diskQueueSize);
+	m_diskWorker = std::thread{[this] () { processDiskJobs(); }};
+}
+
+FrameCache::~FrameCache()
+{
+	if (!m_diskWorker.joinable())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock{m_diskMutex};
+		m_stop = true;
+	}
+	m_diskCondition.notify_all();
+	m_diskWorker.join();
+}
+
+std::uint64_t FrameCache::calcKey(const Raycaster& raycaster, const glm::ivec2& viewportSize,
+	int antialiasingSamples, bool isLightCullingEnabled)
+{
+	std::uint64_t hash = calcSceneKey(raycaster.getEllipsoid(),
+		raycaster.hasLights() ? &raycaster.getLights() : nullptr, raycaster.getPrecision(),
+		isLightCullingEnabled, viewportSize);
+	hash = hashValues(&raycaster.getCameraMatrix()[0][0], 16, hash);
+	return hashValues(&antialiasingSamples, 1, hash);
+}
+
+std::uint64_t FrameCache::calcSceneKey(const Ellipsoid& ellipsoid, const LightList* lights,
+	Raycaster::Precision precision, bool isLightCullingEnabled, const glm::ivec2& viewportSize)
+{
+	const Material material = ellipsoid.getMaterial();
+	const std::array<float, 7> shape{ellipsoid.getA(), ellipsoid.getB(), ellipsoid.getC(),
+		material.ambientCoef, material.diffuseCoef, material.specularCoef, material.shininess};
+	const std::array<int, 7> settings{viewportSize.x, viewportSize.y, material.color.r,
+		material.color.g, material.color.b, static_cast<int>(precision),
+		isLightCullingEnabled ? 1 : 0};
+
+	std::uint64_t hash = fnvOffsetBasis;
+	hash = hashValues(shape.data(), shape.size(), hash);
+	hash = hashValues(settings.data(), settings.size(), hash);
+	return lights != nullptr ? hashLights(*lights, hash) : hash;
+}
+
+std::shared_ptr<const FrameCache::Entry> FrameCache::find(std::uint64_t key,
+	bool isWaitingForDisk)
+{
+	receiveLoadedEntries();
+	auto iterator = m_index.find(key);
+	if (iterator != m_index.end())
+	{
+		m_entries.splice(m_entries.begin(), m_entries, iterator->second);
+		++m_stats.hitCount;
+		return iterator->second->second;
+	}
+
+	if (!m_diskWorker.joinable())
+	{
+		++m_stats.missCount;
+		return nullptr;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock{m_diskMutex};
+		if (!m_diskKeys.contains(key))
+		{
+			++m_stats.missCount;
+			return nullptr;
+		}
+		if (std::ranges::find(m_loadingKeys, key) == m_loadingKeys.end())
+		{
+			submitDiskJob(DiskJob{key, nullptr});
+			m_loadingKeys.push_back(key);
+		}
+		if (!isWaitingForDisk)
+		{
+			return nullptr;
+		}
+		m_diskCondition.wait(lock,
+			[this, key] ()
+			{
+				return std::ranges::find(m_loadingKeys, key) == m_loadingKeys.end();
+			}
+		);
+	}
+
+	receiveLoadedEntries();
+	iterator = m_index.find(key);
+	if (iterator == m_index.end())
+	{
+		++m_stats.missCount;
+		return nullptr;
+	}
+	m_entries.splice(m_entries.begin(), m_entries, iterator->second);
+	return iterator->second->second;
+}
+
+bool FrameCache::isLoading(std::uint64_t key)
+{
+	if (!m_diskWorker.joinable())
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock{m_diskMutex};
+	return std::ranges::find(m_loadingKeys, key) != m_loadingKeys.end();
+}
+
+void FrameCache::insert(std::uint64_t key, const glm::ivec2& size,
+	std::span<const unsigned char> pixels, std::span<const unsigned char> hitMask)
+{
+	std::size_t byteCount = pixels.size() + hitMask.size();
+	if (byteCount > m_capacityBytes)
+	{
+		return;
+	}
+
+	remove(key);
+	m_byteCount += byteCount;
+	evict();
+
+	EntryList::iterator entry = acquireEntry(hitMask.size());
+	entry->first = key;
+	entry->second->size = size;
+	entry->second->pixels.assign(pixels.begin(), pixels.end());
+	entry->second->hitMask.assign(hitMask.begin(), hitMask.end());
+	m_entries.splice(m_entries.begin(), m_freeEntries, entry);
+	index(key, entry);
+
+	if (m_diskWorker.joinable())
+	{
+		std::lock_guard<std::mutex> lock{m_diskMutex};
+		submitDiskJob(DiskJob{key, entry->second});
+	}
+}
+
+void FrameCache::clear()
+{
+	m_entries.clear();
+	m_freeEntries.clear();
+	m_index.clear();
+	m_freeIndexNodes.clear();
+	m_byteCount = 0;
+}
+
+std::size_t FrameCache::getCapacityBytes() const
+{
+	return m_capacityBytes;
+}
+
+void FrameCache::setCapacityBytes(std::size_t capacityBytes)
+{
+	m_capacityBytes = capacityBytes;
+	evict();
+	m_freeEntries.clear();
+}
+
+std::size_t FrameCache::getByteCount() const
+{
+	return m_byteCount;
+}
+
+int FrameCache::getEntryCount() const
+{
+	return static_cast<int>(m_entries.size());
+}
+
+const FrameCache::Stats& FrameCache::getStats() const
+{
+	return m_stats;
+}
+
+void FrameCache::store(std::uint64_t key, std::shared_ptr<Entry> entry)
+{
+	if (entry->getByteCount() > m_capacityBytes)
+	{
+		return;
+	}
+
+	remove(key);
+	m_byteCount += entry->getByteCount();
+	evict();
+	m_entries.emplace_front(key, std::move(entry));
+	index(key, m_entries.begin());
+}
+
+void FrameCache::remove(std::uint64_t key)
+{
+	auto iterator = m_index.find(key);
+	if (iterator == m_index.end())
+	{
+		return;
+	}
+
+	EntryList::iterator entry = iterator->second;
+	m_byteCount -= entry->second->getByteCount();
+	m_freeIndexNodes.push_back(m_index.extract(iterator));
+	if (entry->second.use_count() == 1)
+	{
+		m_freeEntries.splice(m_freeEntries.begin(), m_entries, entry);
+	}
+	else
+	{
+		m_entries.erase(entry);
+	}
+}
+
+void FrameCache::evict()
+{
+	while (m_byteCount > m_capacityBytes && !m_entries.empty())
+	{
+		remove(m_entries.back().first);
+		++m_stats.evictionCount;
+	}
+}
+
+FrameCache::EntryList::iterator FrameCache::acquireEntry(std::size_t pixelCount)
+{
+	if (m_freeEntries.empty())
+	{
+		preallocateEntries(pixelCount);
+	}
+
+	for (auto entry = m_freeEntries.begin(); entry != m_freeEntries.end(); ++entry)
+	{
+		if (entry->second->hitMask.capacity() >= pixelCount)
+		{
+			return entry;
+		}
+	}
+	return m_freeEntries.begin();
+}
+
+void FrameCache::preallocateEntries(std::size_t pixelCount)
+{
+	std::size_t entryBytes = std::max<std::size_t>(pixelCount * (Renderer::numOfChannels + 1), 1);
+	std::size_t entryCount = std::clamp<std::size_t>(m_capacityBytes / entryBytes, 1,
+		maxPreallocatedEntries);
+	entryCount = std::max<std::size_t>(entryCount, m_entries.size() + 1);
+	for (std::size_t i = m_entries.size(); i < entryCount; ++i)
+	{
+		auto entry = std::make_shared<Entry>();
+		entry->pixels.reserve(pixelCount * Renderer::numOfChannels);
+		entry->hitMask.reserve(pixelCount);
+		m_freeEntries.emplace_back(0, std::move(entry));
+	}
+	m_index.reserve(entryCount);
+	m_freeIndexNodes.reserve(entryCount);
+}
+
+void FrameCache::index(std::uint64_t key, EntryList::iterator entry)
+{
+	if (m_freeIndexNodes.empty())
+	{
+		m_index.emplace(key, entry);
+		return;
+	}
+
+	EntryIndex::node_type node = std::move(m_freeIndexNodes.back());
+	m_freeIndexNodes.pop_back();
+	node.key() = key;
+	node.mapped() = entry;
+	m_index.insert(std::move(node));
+}
+
+void FrameCache::submitDiskJob(DiskJob job)
+{
+	if (m_diskJobCount == m_diskJobs.size())
+	{
+		DiskJob& oldestJob = m_diskJobs[m_diskJobStart];
+		if (oldestJob.entry == nullptr)
+		{
+			std::erase(m_loadingKeys, oldestJob.key);
+		}
+		oldestJob = DiskJob{};
+		m_diskJobStart = (m_diskJobStart + 1) % m_diskJobs.size();
+		--m_diskJobCount;
+	}
+
+	m_diskJobs[(m_diskJobStart + m_diskJobCount) % m_diskJobs.size()] = std::move(job);
+	++m_diskJobCount;
+	m_diskCondition.notify_all();
+}
+
+void FrameCache::receiveLoadedEntries()
+{
+	if (!m_diskWorker.joinable())
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock{m_diskMutex};
+	for (std::pair<std::uint64_t, std::shared_ptr<Entry>>& loadedEntry : m_loadedEntries)
+	{
+		store(loadedEntry.first, std::move(loadedEntry.second));
+		++m_stats.diskHitCount;
+	}
+	m_loadedEntries.clear();
+}
+
+void FrameCache::processDiskJobs()
+{
+	while (true)
+	{
+		DiskJob job{};
+		{
+			std::unique_lock<std::mutex> lock{m_diskMutex};
+			m_diskCondition.wait(lock, [this] () { return m_diskJobCount > 0 || m_stop; });
+			if (m_diskJobCount == 0)
+			{
+				return;
+			}
+			job = std::move(m_diskJobs[m_diskJobStart]);
+			m_diskJobStart = (m_diskJobStart + 1) % m_diskJobs.size();
+			--m_diskJobCount;
+		}
+
+		if (job.entry != nullptr)
+		{
+			bool isSaved = save(job.key, *job.entry);
+			job.entry.reset();
+			if (isSaved)
+			{
+				std::lock_guard<std::mutex> lock{m_diskMutex};
+				m_diskKeys.insert(job.key);
+			}
+			continue;
+		}
+
+		std::shared_ptr<Entry> entry = load(job.key);
+		{
+			std::lock_guard<std::mutex> lock{m_diskMutex};
+			std::erase(m_loadingKeys, job.key);
+			if (entry != nullptr)
+			{
+				m_loadedEntries.emplace_back(job.key, std::move(entry));
+			}
+			else
+			{
+				m_diskKeys.erase(job.key);
+			}
+		}
+		m_diskCondition.notify_all();
+	}
+}
+
+std::uint64_t FrameCache::hashLights(const LightList& lights, std::uint64_t hash)
+{
+	const LightList::Components& components = lights.getComponents();
+	for (const std::vector<float>* component : {&components.x, &components.y, &components.z,
+		&components.w, &components.red, &components.green, &components.blue,
+		&components.invRangeSquared})
+	{
+		std::uint64_t count = component->size();
+		hash = hashValues(&count, 1, hash);
+		hash = hashValues(component->data(), component->size(), hash);
+	}
+	return hash;
+}
+
+void FrameCache::scanDiskDirectory()
+{
+	std::error_code error{};
+	for (const std::filesystem::directory_entry& file :
+		std::filesystem::directory_iterator{m_diskDirectory, error})
+	{
+		if (file.path().extension() != ".frame")
+		{
+			continue;
+		}
+
+		std::string name = file.path().stem().string();
+		std::uint64_t key{};
+		auto [end, result] = std::from_chars(name.data(), name.data() + name.size(), key, 16);
+		if (result == std::errc{} && end == name.data() + name.size())
+		{
+			m_diskKeys.insert(key);
+		}
+	}
+}
+
+std::filesystem::path FrameCache::getDiskPath(std::uint64_t key) const
+{
+	std::ostringstream fileName{};
+	fileName << std::hex << key << ".frame";
+	return m_diskDirectory / fileName.str();
+}
+
+std::shared_ptr<FrameCache::Entry> FrameCache::load(std::uint64_t key) const
+{
+	std::ifstream file{getDiskPath(key), std::ios::binary};
+	std::array<char, 4> magic{};
+	Entry entry{};
+	if (!file.read(magic.data(), magic.size()) || magic != diskMagic ||
+		!file.read(reinterpret_cast<char*>(&entry.size), sizeof(entry.size)) ||
+		entry.size.x <= 0 || entry.size.y <= 0)
+	{
+		return nullptr;
+	}
+
+	std::size_t pixelCount = static_cast<std::size_t>(entry.size.x) * entry.size.y;
+	entry.pixels.resize(pixelCount * Renderer::numOfChannels);
+	entry.hitMask.resize(pixelCount);
+	if (!file.read(reinterpret_cast<char*>(entry.pixels.data()), entry.pixels.size()) ||
+		!file.read(reinterpret_cast<char*>(entry.hitMask.data()), entry.hitMask.size()))
+	{
+		return nullptr;
+	}
+	return std::make_shared<Entry>(std::move(entry));
+}
+
+bool FrameCache::save(std::uint64_t key, const Entry& entry) const
+{
+	std::error_code error{};
+	std::filesystem::create_directories(m_diskDirectory, error);
+	std::filesystem::path path = getDiskPath(key);
+	std::filesystem::path tempPath = path;
+	tempPath += ".tmp";
+	{
+		std::ofstream file{tempPath, std::ios::binary | std::ios::trunc};
+		file.write(diskMagic.data(), diskMagic.size());
+		file.write(reinterpret_cast<const char*>(&entry.size), sizeof(entry.size));
+		file.write(reinterpret_cast<const char*>(entry.pixels.data()), entry.pixels.size());
+		file.write(reinterpret_cast<const char*>(entry.hitMask.data()), entry.hitMask.size());
+		if (!file.good())
+		{
+			file.close();
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+	}
+	std::filesystem::rename(tempPath, path, error);
+	return !error;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "raycaster.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+class FrameCache
+{
+public:
+	struct Entry
+	{
+		glm::ivec2 size{};
+		std::vector<unsigned char> pixels{};
+		std::vector<unsigned char> hitMask{};
+
+		std::size_t getByteCount() const;
+	};
+
+	struct Stats
+	{
+		std::uint64_t hitCount{};
+		std::uint64_t diskHitCount{};
+		std::uint64_t missCount{};
+		std::uint64_t evictionCount{};
+	};
+
+	static constexpr std::size_t bytesPerMiB = 1024 * 1024;
+	static constexpr std::size_t defaultCapacityBytes = 256 * bytesPerMiB;
+	static constexpr std::size_t maxPreallocatedEntries = 256;
+	static constexpr std::size_t diskQueueSize = 8;
+
+	FrameCache(std::size_t capacityBytes = defaultCapacityBytes,
+		const std::filesystem::path& diskDirectory = {});
+	FrameCache(const FrameCache&) = delete;
+	~FrameCache();
+
+	FrameCache& operator=(const FrameCache&) = delete;
+
+	static std::uint64_t calcKey(const Raycaster& raycaster, const glm::ivec2& viewportSize,
+		int antialiasingSamples, bool isLightCullingEnabled);
+	static std::uint64_t calcSceneKey(const Ellipsoid& ellipsoid, const LightList* lights,
+		Raycaster::Precision precision, bool isLightCullingEnabled,
+		const glm::ivec2& viewportSize);
+
+	std::shared_ptr<const Entry> find(std::uint64_t key, bool isWaitingForDisk = false);
+	bool isLoading(std::uint64_t key);
+	void insert(std::uint64_t key, const glm::ivec2& size, std::span<const unsigned char> pixels,
+		std::span<const unsigned char> hitMask);
+	void clear();
+
+	std::size_t getCapacityBytes() const;
+	void setCapacityBytes(std::size_t capacityBytes);
+	std::size_t getByteCount() const;
+	int getEntryCount() const;
+	const Stats& getStats() const;
+
+private:
+	using EntryList = std::list<std::pair<std::uint64_t, std::shared_ptr<Entry>>>;
+	using EntryIndex = std::unordered_map<std::uint64_t, EntryList::iterator>;
+
+	struct DiskJob
+	{
+		std::uint64_t key{};
+		std::shared_ptr<const Entry> entry{};
+	};
+
+	std::size_t m_capacityBytes{};
+	std::filesystem::path m_diskDirectory{};
+	EntryList m_entries{};
+	EntryList m_freeEntries{};
+	EntryIndex m_index{};
+	std::vector<EntryIndex::node_type> m_freeIndexNodes{};
+	std::size_t m_byteCount{};
+	Stats m_stats{};
+
+	std::unordered_set<std::uint64_t> m_diskKeys{};
+	std::vector<std::uint64_t> m_loadingKeys{};
+	std::array<DiskJob, diskQueueSize> m_diskJobs{};
+	std::size_t m_diskJobStart{};
+	std::size_t m_diskJobCount{};
+	std::vector<std::pair<std::uint64_t, std::shared_ptr<Entry>>> m_loadedEntries{};
+	std::mutex m_diskMutex{};
+	std::condition_variable m_diskCondition{};
+	std::thread m_diskWorker{};
+	bool m_stop = false;
+
+	void store(std::uint64_t key, std::shared_ptr<Entry> entry);
+	void remove(std::uint64_t key);
+	void evict();
+	EntryList::iterator acquireEntry(std::size_t pixelCount);
+	void preallocateEntries(std::size_t pixelCount);
+	void index(std::uint64_t key, EntryList::iterator entry);
+
+	void submitDiskJob(DiskJob job);
+	void receiveLoadedEntries();
+	void processDiskJobs();
+	static std::uint64_t hashLights(const LightList& lights, std::uint64_t hash);
+	void scanDiskDirectory();
+	std::filesystem::path getDiskPath(std::uint64_t key) const;
+	std::shared_ptr<Entry> load(std::uint64_t key) const;
+	bool save(std::uint64_t key, const Entry& entry) const;
+};
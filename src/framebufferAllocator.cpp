@@ -0,0 +1,150 @@
+#include "framebufferAllocator.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include <atomic>
+
+namespace PageAllocator
+{
+	std::atomic<PageMode> currentPageMode = PageMode::standard;
+	std::atomic<bool> isTouchDistributed = false;
+	std::atomic<std::uint64_t> hugeFallbackCount = 0;
+
+	std::size_t calcMappedSize(std::size_t size)
+	{
+		return (size + hugePageSize - 1) / hugePageSize * hugePageSize;
+	}
+
+	void* map(std::size_t size, PageMode pageMode)
+	{
+#ifdef _WIN32
+		if (pageMode == PageMode::explicitHuge)
+		{
+			std::size_t largePageSize = GetLargePageMinimum();
+			if (largePageSize != 0 && size % largePageSize == 0)
+			{
+				void* pointer = VirtualAlloc(nullptr, size,
+					MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+				if (pointer != nullptr)
+				{
+					return pointer;
+				}
+			}
+			++hugeFallbackCount;
+		}
+		return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+		constexpr int protection = PROT_READ | PROT_WRITE;
+		constexpr int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_HUGETLB
+		if (pageMode == PageMode::explicitHuge)
+		{
+			void* pointer = mmap(nullptr, size, protection, flags | MAP_HUGETLB, -1, 0);
+			if (pointer != MAP_FAILED)
+			{
+				return pointer;
+			}
+			++hugeFallbackCount;
+		}
+#endif
+		void* pointer = mmap(nullptr, size, protection, flags, -1, 0);
+		if (pointer == MAP_FAILED)
+		{
+			return nullptr;
+		}
+#ifdef MADV_HUGEPAGE
+		if (pageMode != PageMode::standard)
+		{
+			madvise(pointer, size, MADV_HUGEPAGE);
+		}
+#endif
+		return pointer;
+#endif
+	}
+
+	void* allocate(std::size_t size)
+	{
+		if (size < minMappedSize)
+		{
+			return ::operator new(size);
+		}
+
+		void* pointer = map(calcMappedSize(size), currentPageMode.load(std::memory_order_relaxed));
+		if (pointer == nullptr)
+		{
+			throw std::bad_alloc{};
+		}
+		return pointer;
+	}
+
+	void deallocate(void* pointer, std::size_t size)
+	{
+		if (size < minMappedSize)
+		{
+			::operator delete(pointer);
+			return;
+		}
+
+#ifdef _WIN32
+		VirtualFree(pointer, 0, MEM_RELEASE);
+#else
+		munmap(pointer, calcMappedSize(size));
+#endif
+	}
+
+	PageMode getPageMode()
+	{
+		return currentPageMode.load(std::memory_order_relaxed);
+	}
+
+	void setPageMode(PageMode pageMode)
+	{
+		currentPageMode.store(pageMode, std::memory_order_relaxed);
+	}
+
+	bool isFirstTouchDistributed()
+	{
+		return isTouchDistributed.load(std::memory_order_relaxed);
+	}
+
+	void setFirstTouchDistributed(bool isFirstTouchDistributed)
+	{
+		isTouchDistributed.store(isFirstTouchDistributed, std::memory_order_relaxed);
+	}
+
+	std::uint64_t getHugeFallbackCount()
+	{
+		return hugeFallbackCount.load(std::memory_order_relaxed);
+	}
+
+	std::optional<PageMode> parsePageMode(const std::string& name)
+	{
+		for (PageMode pageMode :
+			{PageMode::standard, PageMode::transparentHuge, PageMode::explicitHuge})
+		{
+			if (name == getPageModeName(pageMode))
+			{
+				return pageMode;
+			}
+		}
+		return std::nullopt;
+	}
+
+	const char* getPageModeName(PageMode pageMode)
+	{
+		switch (pageMode)
+		{
+			case PageMode::standard:
+				return "standard";
+			case PageMode::transparentHuge:
+				return "transparent";
+			case PageMode::explicitHuge:
+				return "explicit";
+		}
+		return "standard";
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace PageAllocator
+{
+	enum class PageMode
+	{
+		standard,
+		transparentHuge,
+		explicitHuge
+	};
+
+	constexpr std::size_t minMappedSize = 256 * 1024;
+	constexpr std::size_t hugePageSize = 2 * 1024 * 1024;
+
+	void* allocate(std::size_t size);
+	void deallocate(void* pointer, std::size_t size);
+
+	PageMode getPageMode();
+	void setPageMode(PageMode pageMode);
+	bool isFirstTouchDistributed();
+	void setFirstTouchDistributed(bool isFirstTouchDistributed);
+	std::uint64_t getHugeFallbackCount();
+
+	std::optional<PageMode> parsePageMode(const std::string& name);
+	const char* getPageModeName(PageMode pageMode);
+}
+
+template <typename T>
+class FramebufferAllocator
+{
+public:
+	using value_type = T;
+
+	FramebufferAllocator() = default;
+
+	template <typename U>
+	FramebufferAllocator(const FramebufferAllocator<U>&)
+	{ }
+
+	T* allocate(std::size_t count)
+	{
+		return static_cast<T*>(PageAllocator::allocate(count * sizeof(T)));
+	}
+
+	void deallocate(T* pointer, std::size_t count)
+	{
+		PageAllocator::deallocate(pointer, count * sizeof(T));
+	}
+
+	template <typename U>
+	void construct(U* pointer)
+	{
+		::new (static_cast<void*>(pointer)) U;
+	}
+
+	template <typename U, typename... Args>
+	void construct(U* pointer, Args&&... args)
+	{
+		::new (static_cast<void*>(pointer)) U(std::forward<Args>(args)...);
+	}
+
+	template <typename U>
+	bool operator==(const FramebufferAllocator<U>&) const
+	{
+		return true;
+	}
+};
+
+template <typename T>
+using FramebufferVector = std::vector<T, FramebufferAllocator<T>>;
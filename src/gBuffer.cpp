@@ -0,0 +1,50 @@
+#include "gBuffer.hpp"
+
+#include <optional>
+
+void GBuffer::resize(const glm::ivec2& size)
+{
+	m_size = size;
+	m_hitMask.clear();
+	m_normals.clear();
+	m_hitMask.resize(getPixelCount());
+	m_normals.resize(getPixelCount());
+}
+
+void GBuffer::draw(const Raycaster& raycaster, ThreadPool& threadPool)
+{
+	threadPool.parallelFor(m_size.y,
+		[this, &raycaster] (int y)
+		{
+			float ndcY = 2 * static_cast<float>(y) / m_size.y - 1;
+			for (int x = 0; x < m_size.x; ++x)
+			{
+				std::size_t index = static_cast<std::size_t>(y) * m_size.x + x;
+				std::optional<glm::vec3> normal =
+					raycaster.calcNormal(2 * static_cast<float>(x) / m_size.x - 1, ndcY);
+				m_hitMask[index] = normal.has_value() ? 1 : 0;
+				m_normals[index] = normal.value_or(glm::vec3{});
+			}
+		}
+	);
+}
+
+const glm::ivec2& GBuffer::getSize() const
+{
+	return m_size;
+}
+
+std::size_t GBuffer::getPixelCount() const
+{
+	return static_cast<std::size_t>(m_size.x) * m_size.y;
+}
+
+bool GBuffer::isHit(std::size_t index) const
+{
+	return m_hitMask[index] != 0;
+}
+
+const glm::vec3& GBuffer::getNormal(std::size_t index) const
+{
+	return m_normals[index];
+}
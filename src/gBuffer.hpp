@@ -0,0 +1,27 @@
+#pragma once
+
+#include "framebufferAllocator.hpp"
+#include "raycaster.hpp"
+#include "threadPool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+class GBuffer
+{
+public:
+	void resize(const glm::ivec2& size);
+	void draw(const Raycaster& raycaster, ThreadPool& threadPool);
+
+	const glm::ivec2& getSize() const;
+	std::size_t getPixelCount() const;
+	bool isHit(std::size_t index) const;
+	const glm::vec3& getNormal(std::size_t index) const;
+
+private:
+	glm::ivec2 m_size{};
+	FramebufferVector<unsigned char> m_hitMask{};
+	FramebufferVector<glm::vec3> m_normals{};
+};
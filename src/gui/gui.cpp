@@ -4,8 +4,9 @@
 #include <imgui/backends/imgui_impl_opengl3.h>
 #include <imgui/imgui.h>
 
-GUI::GUI(GLFWwindow* window, Scene& scene, const glm::ivec2& viewportSize) :
-	m_leftPanel{scene, viewportSize}
+GUI::GUI(GLFWwindow* window, SplitView& splitView, FrameCapture& frameCapture,
+	LatencyTracker& latencyTracker, AutoTuner& tuner, const glm::ivec2& viewportSize) :
+	m_leftPanel{splitView, frameCapture, latencyTracker, tuner, viewportSize}
 {
 	IMGUI_CHECKVERSION();
 	ImGui::CreateContext();
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "capture/frameCapture.hpp"
 #include "gui/leftPanel.hpp"
-#include "scene.hpp"
+#include "latencyTracker.hpp"
+#include "splitView.hpp"
+#include "tuning/autoTuner.hpp"
 
 #include <glad/glad.h>
 #include <glfw/glfw3.h>
@@ -10,7 +13,8 @@
 class GUI
 {
 public:
-	GUI(GLFWwindow* window, Scene& scene, const glm::ivec2& viewportSize);
+	GUI(GLFWwindow* window, SplitView& splitView, FrameCapture& frameCapture,
+		LatencyTracker& latencyTracker, AutoTuner& tuner, const glm::ivec2& viewportSize);
 	~GUI();
 
 	void update();
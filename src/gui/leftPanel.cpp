@@ -1,11 +1,22 @@
 #include "gui/leftPanel.hpp"
 
+#include "sampleOrder.hpp"
+
 #include <imgui/imgui.h>
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+
+constexpr double countersPerMillion = 1e6;
+constexpr float latencyPlotHeight = 40;
 
-LeftPanel::LeftPanel(Scene& scene, const glm::ivec2& viewportSize) :
-	m_scene{scene},
+LeftPanel::LeftPanel(SplitView& splitView, FrameCapture& frameCapture,
+	LatencyTracker& latencyTracker, AutoTuner& tuner, const glm::ivec2& viewportSize) :
+	m_splitView{splitView},
+	m_frameCapture{frameCapture},
+	m_latencyTracker{latencyTracker},
+	m_tuner{tuner},
 	m_viewportSize{viewportSize}
 { }
 
@@ -15,77 +26,278 @@ void LeftPanel::update()
 	ImGui::SetNextWindowSize({width, static_cast<float>(m_viewportSize.y)}, ImGuiCond_Always);
 	ImGui::Begin("leftPanel", nullptr, ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoTitleBar);
 	ImGui::PushItemWidth(100);
+	updateViews();
+	Scene& scene = m_splitView.getFocusedScene();
+
+	int backend = static_cast<int>(scene.getBackend());
+	if (ImGui::Combo("backend", &backend, "CPU\0GLSL\0"))
+	{
+		scene.setBackend(static_cast<RenderBackend::Type>(backend));
+	}
+	ImGui::Text("frame: %.2f ms", scene.getFrameTimeMs());
 
-	updateIntValue("accuracy",
-		[this] () { return m_scene.getAccuracy(); },
-		[this] (int value) { m_scene.setAccuracy(value); },
-		1, 0);
-	updateFloatValue("view width",
-		[this] () { return m_scene.getViewWidth(); },
-		[this] (float value) { m_scene.setViewWidth(value); },
-		0.1f, "%.2f", 0.01f);
-	updateFloatValue("ambient",
-		[this] () { return m_scene.getAmbient(); },
-		[this] (float value) { m_scene.setAmbient(value); },
-		0.01f, "%.2f", 0.0f, 1.0f);
-	updateFloatValue("diffuse",
-		[this] () { return m_scene.getDiffuse(); },
-		[this] (float value) { m_scene.setDiffuse(value); },
-		0.01f, "%.2f", 0.0f, 1.0f);
-	updateFloatValue("specular",
-		[this] () { return m_scene.getSpecular(); },
-		[this] (float value) { m_scene.setSpecular(value); },
-		0.01f, "%.2f", 0.0f, 1.0f);
-	updateFloatValue("shininess",
-		[this] () { return m_scene.getShininess(); },
-		[this] (float value) { m_scene.setShininess(value); },
-		0.1f, "%.1f", 1.0f, 100.0f);
-	updateFloatValue("a",
-		[this] () { return m_scene.getEllipsoidA(); },
-		[this] (float value) { m_scene.setEllipsoidA(value); },
-		0.1f, "%.1f", 0.1f);
-	updateFloatValue("b",
-		[this] () { return m_scene.getEllipsoidB(); },
-		[this] (float value) { m_scene.setEllipsoidB(value); },
-		0.1f, "%.1f", 0.1f);
-	updateFloatValue("c",
-		[this] () { return m_scene.getEllipsoidC(); },
-		[this] (float value) { m_scene.setEllipsoidC(value); },
-		0.1f, "%.1f", 0.1f);
+	int refinement = static_cast<int>(scene.getRefinement());
+	if (ImGui::Combo("refinement", &refinement, "grid\0blue noise\0"))
+	{
+		scene.setRefinement(static_cast<CpuRenderBackend::Refinement>(refinement));
+	}
+	updateIntValue("sample batch", &Scene::getSampleBatch, &Scene::setSampleBatch,
+		16, 1, SampleOrder::rankCount);
+	updateIntValue("accuracy", &Scene::getAccuracy, &Scene::setAccuracy, 1, 0);
+	updateIntValue("antialiasing", &Scene::getAntialiasing, &Scene::setAntialiasing, 1, 1, 8);
+	updateFloatValue("view width", &Scene::getViewWidth, &Scene::setViewWidth, 0.1f, "%.2f", 0.01f);
+	updateFloatValue("ambient", &Scene::getAmbient, &Scene::setAmbient, 0.01f, "%.2f", 0.0f,
+		Material::maxCoef);
+	updateFloatValue("diffuse", &Scene::getDiffuse, &Scene::setDiffuse, 0.01f, "%.2f", 0.0f,
+		Material::maxCoef);
+	updateFloatValue("specular", &Scene::getSpecular, &Scene::setSpecular, 0.01f, "%.2f", 0.0f,
+		Material::maxCoef);
+	updateFloatValue("shininess", &Scene::getShininess, &Scene::setShininess, 0.1f, "%.1f",
+		Material::minShininess, Material::maxShininess);
+	updateFloatValue("a", &Scene::getEllipsoidA, &Scene::setEllipsoidA, 0.1f, "%.1f", 0.1f);
+	updateFloatValue("b", &Scene::getEllipsoidB, &Scene::setEllipsoidB, 0.1f, "%.1f", 0.1f);
+	updateFloatValue("c", &Scene::getEllipsoidC, &Scene::setEllipsoidC, 0.1f, "%.1f", 0.1f);
+	updateIntValue("lights", &Scene::getLightCount, &Scene::setLightCount, 1, 0,
+		LightList::maxLightCount);
+	if (scene.getLightCount() > 0)
+	{
+		ImGui::Text("lights/tile: %.1f", scene.getMeanTileLightCount());
+	}
+	updateCapture();
+	updateFrameCache();
+	updateProfile();
+	updateCounters();
+	updateLatency();
+	updateSpeculation();
 
 	ImGui::PopItemWidth();
 	ImGui::End();
 }
 
-void LeftPanel::updateIntValue(const std::string& name, const std::function<int(void)>& getter,
-	const std::function<void(int)>& setter, int step, int min, int max)
+void LeftPanel::updateViews()
 {
-	int value = getter();
+	int viewCount = m_splitView.getViewCount();
+	if (ImGui::InputInt("views", &viewCount, 1, 1))
+	{
+		m_splitView.setViewCount(std::clamp(viewCount, 1, SplitView::maxViewCount));
+	}
+	if (m_splitView.getViewCount() == 1)
+	{
+		return;
+	}
+
+	int focus = m_splitView.getFocus() + 1;
+	if (ImGui::InputInt("focus", &focus, 1, 1))
+	{
+		m_splitView.setFocus(focus - 1);
+	}
+	ImGui::Text("converged: %d/%d", m_splitView.getConvergedViewCount(),
+		m_splitView.getViewCount());
+	ImGui::Separator();
+}
+
+void LeftPanel::updateIntValue(const char* name, int (Scene::*getter)() const,
+	void (Scene::*setter)(int), int step, int min, int max)
+{
+	Scene& scene = m_splitView.getFocusedScene();
+	int value = (scene.*getter)();
 	int prevValue = value;
 
-	ImGui::InputInt(name.c_str(), &value, step, step);
+	ImGui::InputInt(name, &value, step, step);
 
 	value = std::clamp(value, min, max);
 
 	if (value != prevValue)
 	{
-		setter(value);
+		(scene.*setter)(value);
 	}
 }
 
-void LeftPanel::updateFloatValue(const std::string& name, const std::function<float(void)>& getter,
-	const std::function<void(float)>& setter, float step, const std::string& format, float min,
-	float max)
+void LeftPanel::updateFloatValue(const char* name, float (Scene::*getter)() const,
+	void (Scene::*setter)(float), float step, const char* format, float min, float max)
 {
-	float value = getter();
+	Scene& scene = m_splitView.getFocusedScene();
+	float value = (scene.*getter)();
 	float prevValue = value;
 
-	ImGui::InputFloat(name.c_str(), &value, step, step, format.c_str());
+	ImGui::InputFloat(name, &value, step, step, format);
 
 	value = std::clamp(value, min, max);
 
 	if (value != prevValue)
 	{
-		setter(value);
+		(scene.*setter)(value);
+	}
+}
+
+void LeftPanel::updateCapture()
+{
+	ImGui::Separator();
+	if (ImGui::Button("screenshot"))
+	{
+		m_frameCapture.requestScreenshot();
+	}
+
+	bool isCapturingConverged = m_frameCapture.isCapturingConverged();
+	if (ImGui::Checkbox("capture converged", &isCapturingConverged))
+	{
+		m_frameCapture.setCapturingConverged(isCapturingConverged);
+	}
+
+	const FrameExporter& exporter = m_frameCapture.getExporter();
+	ImGui::Text("exported: %d/%d", exporter.getWrittenCount(), exporter.getSubmittedCount());
+	if (exporter.getDroppedCount() > 0)
+	{
+		ImGui::Text("dropped: %d", exporter.getDroppedCount());
+	}
+	if (exporter.isWriteFailed())
+	{
+		ImGui::Text("export write failed");
+	}
+}
+
+void LeftPanel::updateFrameCache()
+{
+	const FrameCache* frameCache = m_splitView.getFrameCache();
+	if (frameCache == nullptr)
+	{
+		return;
+	}
+
+	const FrameCache::Stats& stats = frameCache->getStats();
+	unsigned long long hitCount = stats.hitCount + stats.diskHitCount;
+	unsigned long long lookupCount = hitCount + stats.missCount;
+	ImGui::Separator();
+	ImGui::Text("cached: %d frames, %.0f MiB", frameCache->getEntryCount(),
+		frameCache->getByteCount() / static_cast<float>(FrameCache::bytesPerMiB));
+	ImGui::Text("cache hits: %llu/%llu", hitCount, lookupCount);
+}
+
+void LeftPanel::updateProfile()
+{
+	const RenderProfile& profile = m_splitView.getRenderProfile();
+	ImGui::Separator();
+	ImGui::Text("threads: %d", profile.threadCount);
+	if (profile.traversal == Renderer::Traversal::morton)
+	{
+		ImGui::Text("traversal: %s %d", RenderProfile::getTraversalName(profile.traversal),
+			profile.tileSize);
+	}
+	else
+	{
+		ImGui::Text("traversal: %s", RenderProfile::getTraversalName(profile.traversal));
+	}
+	ImGui::Text("precision: %s", RenderProfile::getPrecisionName(profile.precision));
+	ImGui::Text("tuned pass: %.1f ms", profile.passMs);
+	if (m_tuner.isTuning())
+	{
+		ImGui::Text("tuning...");
+	}
+	else if (ImGui::Button("re-tune"))
+	{
+		m_tuner.start();
+	}
+}
+
+void LeftPanel::updateCounters()
+{
+	using Event = PerfCounters::Event;
+
+	ThreadPool& threadPool = m_splitView.getThreadPool();
+	bool areCountersEnabled = threadPool.areCountersEnabled();
+	ImGui::Separator();
+	if (ImGui::Checkbox("hw counters", &areCountersEnabled))
+	{
+		threadPool.setCountersEnabled(areCountersEnabled);
+	}
+	if (!areCountersEnabled)
+	{
+		return;
+	}
+	if (!PerfCounters::isSupported())
+	{
+		ImGui::Text("counters unavailable");
+		return;
+	}
+
+	const PerfCounters::Sample& counters = m_splitView.getFocusedScene().getFrameCounters();
+	if (counters.hasEvent(Event::cycles))
+	{
+		ImGui::Text("cycles: %.1fM", counters.get(Event::cycles) / countersPerMillion);
+	}
+	if (counters.hasEvent(Event::instructions))
+	{
+		ImGui::Text("IPC: %.2f", counters.getInstructionsPerCycle());
+	}
+	if (counters.hasEvent(Event::cacheMisses))
+	{
+		ImGui::Text("LLC misses: %.2fM", counters.get(Event::cacheMisses) / countersPerMillion);
+	}
+	if (counters.hasEvent(Event::branchMisses))
+	{
+		ImGui::Text("branch misses: %.2fM",
+			counters.get(Event::branchMisses) / countersPerMillion);
+	}
+}
+
+void LeftPanel::updateLatency()
+{
+	using Stage = LatencyTracker::Stage;
+
+	ImGui::Separator();
+	if (m_latencyTracker.getSampleCount(Stage::firstEffect) == 0)
+	{
+		ImGui::Text("latency: no input");
+		return;
+	}
+
+	ImGui::Text("latency p50: %.1f ms", m_latencyTracker.getPercentile(Stage::firstEffect, 0.5));
+	ImGui::Text("latency p99: %.1f ms", m_latencyTracker.getPercentile(Stage::firstEffect, 0.99));
+	if (m_latencyTracker.getSampleCount(Stage::converged) > 0)
+	{
+		ImGui::Text("converged p99: %.0f ms",
+			m_latencyTracker.getPercentile(Stage::converged, 0.99));
+	}
+
+	std::array<std::uint64_t, LatencyTracker::bucketCount> histogram =
+		m_latencyTracker.getHistogram(Stage::firstEffect);
+	std::array<float, LatencyTracker::bucketCount> values{};
+	std::transform(histogram.begin(), histogram.end(), values.begin(),
+		[] (std::uint64_t count) { return static_cast<float>(count); });
+	ImGui::PlotHistogram("##latency", values.data(), static_cast<int>(values.size()), 0, nullptr,
+		0, std::numeric_limits<float>::max(), {0, latencyPlotHeight});
+	if (ImGui::Button("reset latency"))
+	{
+		m_latencyTracker.reset();
+	}
+}
+
+void LeftPanel::updateSpeculation()
+{
+	Scene& scene = m_splitView.getFocusedScene();
+	bool isSpeculationEnabled = scene.isSpeculationEnabled();
+	ImGui::Separator();
+	if (ImGui::Checkbox("speculation", &isSpeculationEnabled))
+	{
+		scene.setSpeculationEnabled(isSpeculationEnabled);
+	}
+	if (!isSpeculationEnabled)
+	{
+		return;
+	}
+
+	const SpeculativeFramePool& pool = scene.getSpeculativeFramePool();
+	const SpeculativeFramePool::Stats& stats = pool.getStats();
+	unsigned long long hitCount = stats.hitCount;
+	unsigned long long lookupCount = hitCount + stats.missCount;
+	unsigned long long wastedCount = stats.wastedCount;
+	unsigned long long frameCount = stats.frameCount;
+	ImGui::Text("predicted: %llu/%llu hits", hitCount, lookupCount);
+	ImGui::Text("hit rate: %.0f%%", 100 * pool.getHitRate());
+	ImGui::Text("wasted: %llu/%llu frames", wastedCount, frameCount);
+	ImGui::Text("wasted work: %.0f%%", 100 * pool.getWastedFraction());
+	if (ImGui::Button("reset speculation"))
+	{
+		scene.resetSpeculationStats();
 	}
 }
@@ -1,29 +1,42 @@
 #pragma once
 
+#include "capture/frameCapture.hpp"
+#include "latencyTracker.hpp"
 #include "scene.hpp"
+#include "splitView.hpp"
+#include "tuning/autoTuner.hpp"
 
 #include <glm/glm.hpp>
 
-#include <functional>
 #include <limits>
-#include <string>
 
 class LeftPanel
 {
 public:
 	static constexpr int width = 200;
 
-	LeftPanel(Scene& scene, const glm::ivec2& viewportSize);
+	LeftPanel(SplitView& splitView, FrameCapture& frameCapture, LatencyTracker& latencyTracker,
+		AutoTuner& tuner, const glm::ivec2& viewportSize);
 	void update();
 
 private:
-	Scene& m_scene;
+	SplitView& m_splitView;
+	FrameCapture& m_frameCapture;
+	LatencyTracker& m_latencyTracker;
+	AutoTuner& m_tuner;
 	const glm::ivec2& m_viewportSize;
 
-	void updateIntValue(const std::string& name, const std::function<int(void)>& getter,
-		const std::function<void(int)>& setter, int step, int min,
-		int max = std::numeric_limits<int>::max());
-	void updateFloatValue(const std::string& name, const std::function<float(void)>& getter,
-		const std::function<void(float)>& setter, float step, const std::string& format, float min,
+	void updateViews();
+	void updateCapture();
+	void updateFrameCache();
+	void updateProfile();
+	void updateCounters();
+	void updateLatency();
+	void updateSpeculation();
+
+	void updateIntValue(const char* name, int (Scene::*getter)() const,
+		void (Scene::*setter)(int), int step, int min, int max = std::numeric_limits<int>::max());
+	void updateFloatValue(const char* name, float (Scene::*getter)() const,
+		void (Scene::*setter)(float), float step, const char* format, float min,
 		float max = std::numeric_limits<float>::max());
 };
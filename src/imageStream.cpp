@@ -0,0 +1,121 @@
+#include "imageStream.hpp"
+
+#include "pngEncoder.hpp"
+
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <vector>
+
+constexpr int numOfChannels = 3;
+
+ImageStream::ImageStream(const std::filesystem::path& path, const glm::ivec2& size,
+	Format format) :
+	m_path{path},
+	m_size{size},
+	m_format{format}
+{ }
+
+bool ImageStream::open()
+{
+	m_file.open(m_path, std::ios::binary | std::ios::trunc);
+	m_checkpoint = {};
+	if (m_format == Format::png)
+	{
+		std::vector<unsigned char> header = PngEncoder::encodeHeader(m_size);
+		return write(header.data(), header.size());
+	}
+
+	std::string header = "P6\n" + std::to_string(m_size.x) + ' ' + std::to_string(m_size.y) +
+		"\n255\n";
+	return write(reinterpret_cast<const unsigned char*>(header.data()), header.size());
+}
+
+bool ImageStream::resume(const Checkpoint& checkpoint)
+{
+	std::error_code error{};
+	if (std::filesystem::file_size(m_path, error) < checkpoint.fileOffset || error)
+	{
+		return false;
+	}
+	std::filesystem::resize_file(m_path, checkpoint.fileOffset, error);
+	if (error)
+	{
+		return false;
+	}
+
+	m_file.open(m_path, std::ios::binary | std::ios::app);
+	m_checkpoint = checkpoint;
+	return m_file.good();
+}
+
+bool ImageStream::writeRows(const unsigned char* rows, int rowCount)
+{
+	std::size_t rowSize = static_cast<std::size_t>(m_size.x) * numOfChannels;
+	if (m_format == Format::ppm)
+	{
+		m_checkpoint.nextRow += rowCount;
+		return write(rows, rowSize * rowCount);
+	}
+
+	std::vector<unsigned char> scanlines{};
+	scanlines.reserve((rowSize + 1) * rowCount);
+	for (int row = 0; row < rowCount; ++row)
+	{
+		scanlines.push_back(0);
+		scanlines.insert(scanlines.end(), rows + row * rowSize, rows + (row + 1) * rowSize);
+	}
+
+	std::vector<unsigned char> stream{};
+	if (m_checkpoint.nextRow == 0)
+	{
+		stream.insert(stream.end(), {0x78, 0x01});
+	}
+	m_checkpoint.nextRow += rowCount;
+	m_checkpoint.adler =
+		PngEncoder::adler32(scanlines.data(), scanlines.size(), m_checkpoint.adler);
+
+	bool isLastBand = m_checkpoint.nextRow >= m_size.y;
+	PngEncoder::appendStoredBlocks(stream, scanlines.data(), scanlines.size(), isLastBand);
+	if (isLastBand)
+	{
+		PngEncoder::appendUint32(stream, m_checkpoint.adler);
+	}
+
+	std::vector<unsigned char> chunk{};
+	PngEncoder::appendChunk(chunk, "IDAT", stream);
+	return write(chunk.data(), chunk.size());
+}
+
+bool ImageStream::finish()
+{
+	if (m_format == Format::png)
+	{
+		std::vector<unsigned char> chunk{};
+		PngEncoder::appendChunk(chunk, "IEND", {});
+		if (!write(chunk.data(), chunk.size()))
+		{
+			return false;
+		}
+	}
+	m_file.close();
+	return !m_file.fail();
+}
+
+const ImageStream::Checkpoint& ImageStream::getCheckpoint() const
+{
+	return m_checkpoint;
+}
+
+ImageStream::Format ImageStream::formatFromPath(const std::filesystem::path& path)
+{
+	return path.extension() == ".ppm" ? Format::ppm : Format::png;
+}
+
+bool ImageStream::write(const unsigned char* data, std::size_t size)
+{
+	m_file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+	m_file.flush();
+	m_checkpoint.fileOffset += size;
+	return m_file.good();
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+class ImageStream
+{
+public:
+	enum class Format
+	{
+		png,
+		ppm
+	};
+
+	struct Checkpoint
+	{
+		int nextRow{};
+		std::uint64_t fileOffset{};
+		std::uint32_t adler = 1;
+	};
+
+	ImageStream(const std::filesystem::path& path, const glm::ivec2& size, Format format);
+
+	bool open();
+	bool resume(const Checkpoint& checkpoint);
+	bool writeRows(const unsigned char* rows, int rowCount);
+	bool finish();
+
+	const Checkpoint& getCheckpoint() const;
+
+	static Format formatFromPath(const std::filesystem::path& path);
+
+private:
+	std::filesystem::path m_path{};
+	glm::ivec2 m_size{};
+	Format m_format{};
+	std::ofstream m_file{};
+	Checkpoint m_checkpoint{};
+
+	bool write(const unsigned char* data, std::size_t size);
+};
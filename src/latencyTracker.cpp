@@ -0,0 +1,273 @@
+#include "latencyTracker.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+constexpr std::chrono::seconds calibrationInterval{1};
+constexpr GLuint64 maxWaitNs = 1'000'000'000;
+
+LatencyTracker::LatencyTracker()
+{
+	for (PendingFrame& frame : m_frames)
+	{
+		glGenQueries(1, &frame.query);
+	}
+	GLint timestampBits = 0;
+	glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &timestampBits);
+	m_hasGpuTimestamps = timestampBits > 0;
+	calibrate();
+}
+
+LatencyTracker::~LatencyTracker()
+{
+	for (PendingFrame& frame : m_frames)
+	{
+		if (frame.fence != nullptr)
+		{
+			glDeleteSync(frame.fence);
+		}
+		glDeleteQueries(1, &frame.query);
+	}
+}
+
+void LatencyTracker::recordInput(Clock::time_point time)
+{
+	m_inputTimes.push_back(time);
+	++m_inputCount;
+}
+
+void LatencyTracker::submitFrame(bool isConverged)
+{
+	bool hasNewInputs = m_inputCount > m_submittedInputCount;
+	bool completesInputs = isConverged && m_inputCount > m_convergedInputCount;
+	if (!hasNewInputs && !completesInputs)
+	{
+		return;
+	}
+
+	if (m_submitCount - m_resolveCount == maxFramesInFlight)
+	{
+		resolve(true);
+	}
+	if (Clock::now() - m_calibrationTime >= calibrationInterval)
+	{
+		calibrate();
+	}
+
+	PendingFrame& frame = m_frames[m_submitCount % maxFramesInFlight];
+	if (m_hasGpuTimestamps)
+	{
+		glQueryCounter(frame.query, GL_TIMESTAMP);
+	}
+	frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	frame.inputEnd = m_inputCount;
+	frame.isConverged = isConverged;
+	m_submittedInputCount = m_inputCount;
+	++m_submitCount;
+}
+
+void LatencyTracker::update()
+{
+	while (m_resolveCount < m_submitCount && resolve(false))
+	{ }
+}
+
+void LatencyTracker::flush()
+{
+	while (m_resolveCount < m_submitCount)
+	{
+		resolve(true);
+	}
+}
+
+void LatencyTracker::reset()
+{
+	flush();
+	m_inputTimes.clear();
+	m_inputCount = 0;
+	m_submittedInputCount = 0;
+	m_firstEffectInputCount = 0;
+	m_convergedInputCount = 0;
+	m_distributions = {};
+}
+
+bool LatencyTracker::hasGpuTimestamps() const
+{
+	return m_hasGpuTimestamps;
+}
+
+std::uint64_t LatencyTracker::getSampleCount(Stage stage) const
+{
+	return getDistribution(stage).sampleCount;
+}
+
+double LatencyTracker::getMeanMs(Stage stage) const
+{
+	const Distribution& distribution = getDistribution(stage);
+	return distribution.sampleCount == 0 ? 0 : distribution.sumMs / distribution.sampleCount;
+}
+
+double LatencyTracker::getMaxMs(Stage stage) const
+{
+	return getDistribution(stage).maxMs;
+}
+
+double LatencyTracker::getPercentile(Stage stage, double fraction) const
+{
+	const Distribution& distribution = getDistribution(stage);
+	if (distribution.sampleCount == 0)
+	{
+		return 0;
+	}
+
+	std::uint64_t rank = std::max(static_cast<std::uint64_t>(
+		std::ceil(fraction * distribution.sampleCount)), static_cast<std::uint64_t>(1));
+	std::uint64_t count = 0;
+	for (int bin = 0; bin < binCount; ++bin)
+	{
+		count += distribution.bins[bin];
+		if (count >= rank)
+		{
+			return std::min((bin + 1) * binMs, distribution.maxMs);
+		}
+	}
+	return distribution.maxMs;
+}
+
+std::array<std::uint64_t, LatencyTracker::bucketCount> LatencyTracker::getHistogram(
+	Stage stage) const
+{
+	const Distribution& distribution = getDistribution(stage);
+	std::array<std::uint64_t, bucketCount> histogram{};
+	std::size_t bucket = 0;
+	for (int bin = 0; bin < binCount; ++bin)
+	{
+		while (bucket < bucketLimitsMs.size() && bin * binMs >= bucketLimitsMs[bucket])
+		{
+			++bucket;
+		}
+		histogram[bucket] += distribution.bins[bin];
+	}
+	return histogram;
+}
+
+void LatencyTracker::printReport(std::ostream& output) const
+{
+	output << "input latency measured with " <<
+		(m_hasGpuTimestamps ? "GPU timestamp queries" : "fence completion") << '\n';
+	for (Stage stage : {Stage::firstEffect, Stage::converged})
+	{
+		std::uint64_t sampleCount = getSampleCount(stage);
+		if (sampleCount == 0)
+		{
+			output << "input to " << getStageName(stage) << ": no samples\n";
+			continue;
+		}
+
+		output << "input to " << getStageName(stage) << ": " << sampleCount << " samples, mean " <<
+			getMeanMs(stage) << " ms, p50 " << getPercentile(stage, 0.5) << " ms, p90 " <<
+			getPercentile(stage, 0.9) << " ms, p99 " << getPercentile(stage, 0.99) <<
+			" ms, max " << getMaxMs(stage) << " ms\n";
+		std::array<std::uint64_t, bucketCount> histogram = getHistogram(stage);
+		double lowerMs = 0;
+		for (std::size_t bucket = 0; bucket < bucketLimitsMs.size(); ++bucket)
+		{
+			output << "  " << lowerMs << '-' << bucketLimitsMs[bucket] << " ms: " <<
+				histogram[bucket] << '\n';
+			lowerMs = bucketLimitsMs[bucket];
+		}
+		output << "  >= " << lowerMs << " ms: " << histogram.back() << '\n';
+	}
+}
+
+const char* LatencyTracker::getStageName(Stage stage)
+{
+	switch (stage)
+	{
+		case Stage::firstEffect:
+			return "first effect";
+		case Stage::converged:
+			return "converged";
+	}
+	return "first effect";
+}
+
+void LatencyTracker::Distribution::add(double ms)
+{
+	ms = std::max(ms, 0.0);
+	int bin = std::min(static_cast<int>(ms / binMs), binCount - 1);
+	++bins[bin];
+	++sampleCount;
+	sumMs += ms;
+	maxMs = std::max(maxMs, ms);
+}
+
+void LatencyTracker::calibrate()
+{
+	if (!m_hasGpuTimestamps)
+	{
+		return;
+	}
+
+	GLint64 gpuTime = 0;
+	glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+	Clock::time_point now = Clock::now();
+	m_gpuToCpuOffset = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		now.time_since_epoch()) - std::chrono::nanoseconds{gpuTime};
+	m_calibrationTime = now;
+}
+
+bool LatencyTracker::resolve(bool isBlocking)
+{
+	PendingFrame& frame = m_frames[m_resolveCount % maxFramesInFlight];
+	GLenum status = glClientWaitSync(frame.fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+		isBlocking ? maxWaitNs : 0);
+	if (status == GL_TIMEOUT_EXPIRED && !isBlocking)
+	{
+		return false;
+	}
+
+	Clock::time_point completionTime = getCompletionTime(frame, status);
+	glDeleteSync(frame.fence);
+	frame.fence = nullptr;
+	++m_resolveCount;
+
+	for (; m_firstEffectInputCount < frame.inputEnd; ++m_firstEffectInputCount)
+	{
+		Clock::time_point inputTime = m_inputTimes[m_firstEffectInputCount - m_convergedInputCount];
+		m_distributions[static_cast<int>(Stage::firstEffect)].add(
+			std::chrono::duration<double, std::milli>(completionTime - inputTime).count());
+	}
+	if (frame.isConverged)
+	{
+		for (; m_convergedInputCount < frame.inputEnd; ++m_convergedInputCount)
+		{
+			m_distributions[static_cast<int>(Stage::converged)].add(
+				std::chrono::duration<double, std::milli>(completionTime - m_inputTimes.front())
+				.count());
+			m_inputTimes.pop_front();
+		}
+	}
+	return true;
+}
+
+LatencyTracker::Clock::time_point LatencyTracker::getCompletionTime(const PendingFrame& frame,
+	GLenum status) const
+{
+	Clock::time_point now = Clock::now();
+	if (!m_hasGpuTimestamps || (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED))
+	{
+		return now;
+	}
+
+	GLint64 gpuTime = 0;
+	glGetQueryObjecti64v(frame.query, GL_QUERY_RESULT, &gpuTime);
+	Clock::time_point completionTime{std::chrono::duration_cast<Clock::duration>(
+		std::chrono::nanoseconds{gpuTime} + m_gpuToCpuOffset)};
+	return std::min(completionTime, now);
+}
+
+const LatencyTracker::Distribution& LatencyTracker::getDistribution(Stage stage) const
+{
+	return m_distributions[static_cast<int>(stage)];
+}
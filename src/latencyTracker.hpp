@@ -0,0 +1,89 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <ostream>
+
+class LatencyTracker
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	enum class Stage
+	{
+		firstEffect,
+		converged
+	};
+
+	static constexpr int maxFramesInFlight = 8;
+	static constexpr double binMs = 0.25;
+	static constexpr int binCount = 8000;
+	static constexpr std::array<double, 9> bucketLimitsMs{8, 16, 24, 33, 50, 100, 250, 500,
+		1000};
+	static constexpr std::size_t bucketCount = bucketLimitsMs.size() + 1;
+
+	LatencyTracker();
+	LatencyTracker(const LatencyTracker&) = delete;
+	~LatencyTracker();
+
+	LatencyTracker& operator=(const LatencyTracker&) = delete;
+
+	void recordInput(Clock::time_point time);
+	void submitFrame(bool isConverged);
+	void update();
+	void flush();
+	void reset();
+
+	bool hasGpuTimestamps() const;
+	std::uint64_t getSampleCount(Stage stage) const;
+	double getMeanMs(Stage stage) const;
+	double getMaxMs(Stage stage) const;
+	double getPercentile(Stage stage, double fraction) const;
+	std::array<std::uint64_t, bucketCount> getHistogram(Stage stage) const;
+	void printReport(std::ostream& output) const;
+
+	static const char* getStageName(Stage stage);
+
+private:
+	struct PendingFrame
+	{
+		GLsync fence{};
+		unsigned int query{};
+		std::uint64_t inputEnd{};
+		bool isConverged{};
+	};
+
+	struct Distribution
+	{
+		std::array<std::uint32_t, binCount> bins{};
+		std::uint64_t sampleCount{};
+		double sumMs{};
+		double maxMs{};
+
+		void add(double ms);
+	};
+
+	std::array<PendingFrame, maxFramesInFlight> m_frames{};
+	int m_submitCount = 0;
+	int m_resolveCount = 0;
+	bool m_hasGpuTimestamps = false;
+	std::chrono::nanoseconds m_gpuToCpuOffset{};
+	Clock::time_point m_calibrationTime{};
+
+	std::deque<Clock::time_point> m_inputTimes{};
+	std::uint64_t m_inputCount = 0;
+	std::uint64_t m_submittedInputCount = 0;
+	std::uint64_t m_firstEffectInputCount = 0;
+	std::uint64_t m_convergedInputCount = 0;
+	std::array<Distribution, 2> m_distributions{};
+
+	void calibrate();
+	bool resolve(bool isBlocking);
+	Clock::time_point getCompletionTime(const PendingFrame& frame, GLenum status) const;
+	const Distribution& getDistribution(Stage stage) const;
+};
@@ -0,0 +1,207 @@
+#include "lightCulling.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <optional>
+
+void LightCulling::cull(const Raycaster& raycaster, const glm::ivec2& viewportSize,
+	const glm::vec2& ndcOrigin, const glm::vec2& ndcPixelSize, int margin, ThreadPool& threadPool)
+{
+	if (!raycaster.hasLights())
+	{
+		clear();
+		return;
+	}
+
+	m_tileCount = (viewportSize + tileSize - 1) / tileSize;
+	m_lightCount = raycaster.getLights().getCount();
+	std::size_t tileCount = static_cast<std::size_t>(m_tileCount.x) * m_tileCount.y;
+	m_tileLights.resize(tileCount * m_lightCount);
+	m_tileLightCounts.resize(tileCount);
+
+	const Ellipsoid& ellipsoid = raycaster.getEllipsoid();
+	const glm::mat4& cameraMatrix = raycaster.getCameraMatrix();
+	float radius = std::max({ellipsoid.getA(), ellipsoid.getB(), ellipsoid.getC()});
+	float depthScale = glm::length(glm::vec3{cameraMatrix[2]});
+	float centerDepth = (glm::inverse(cameraMatrix) * glm::vec4{0, 0, 0, 1}).z;
+	glm::vec2 ndcDepthRange{std::max(centerDepth - radius / depthScale, -1.0f),
+		std::min(centerDepth + radius / depthScale, 1.0f)};
+
+	std::atomic<int> coveredTileCount = 0;
+	std::atomic<int> totalLightCount = 0;
+	threadPool.parallelFor(m_tileCount.y,
+		[this, &raycaster, &coveredTileCount, &totalLightCount, ndcOrigin, ndcPixelSize, margin,
+			ndcDepthRange] (int tileRow)
+		{
+			int rowCoveredTileCount = 0;
+			int rowLightCount = 0;
+			for (int tileColumn = 0; tileColumn < m_tileCount.x; ++tileColumn)
+			{
+				glm::vec2 tileStart =
+					glm::vec2{tileColumn * tileSize - margin, tileRow * tileSize - margin};
+				glm::vec2 tileEnd = tileStart + static_cast<float>(tileSize + 2 * margin);
+				glm::vec2 cornerA = ndcOrigin + tileStart * ndcPixelSize;
+				glm::vec2 cornerB = ndcOrigin + tileEnd * ndcPixelSize;
+
+				std::size_t tile = static_cast<std::size_t>(tileRow) * m_tileCount.x +
+					tileColumn;
+				Bounds bounds{};
+				m_tileLightCounts[tile] = 0;
+				if (calcTileBounds(raycaster, glm::min(cornerA, cornerB),
+					glm::max(cornerA, cornerB), ndcDepthRange, bounds))
+				{
+					m_tileLightCounts[tile] =
+						cullTile(raycaster, bounds, m_tileLights.data() + tile * m_lightCount);
+					rowLightCount += m_tileLightCounts[tile];
+					++rowCoveredTileCount;
+				}
+			}
+			coveredTileCount += rowCoveredTileCount;
+			totalLightCount += rowLightCount;
+		}
+	);
+
+	m_meanTileLightCount = coveredTileCount > 0 ?
+		static_cast<float>(totalLightCount) / coveredTileCount : 0.0f;
+}
+
+void LightCulling::clear()
+{
+	m_tileCount = {};
+	m_lightCount = 0;
+	m_meanTileLightCount = 0;
+}
+
+bool LightCulling::isActive() const
+{
+	return m_lightCount > 0;
+}
+
+std::span<const std::uint16_t> LightCulling::getTileLights(int x, int y) const
+{
+	int tileColumn = std::clamp(x / tileSize, 0, m_tileCount.x - 1);
+	int tileRow = std::clamp(y / tileSize, 0, m_tileCount.y - 1);
+	std::size_t tile = static_cast<std::size_t>(tileRow) * m_tileCount.x + tileColumn;
+	return {m_tileLights.data() + tile * m_lightCount,
+		static_cast<std::size_t>(m_tileLightCounts[tile])};
+}
+
+float LightCulling::getMeanTileLightCount() const
+{
+	return m_meanTileLightCount;
+}
+
+int LightCulling::cullTile(const Raycaster& raycaster, const Bounds& bounds,
+	std::uint16_t* tileLights) const
+{
+	const Ellipsoid& ellipsoid = raycaster.getEllipsoid();
+	const Material material = ellipsoid.getMaterial();
+	glm::vec3 gradientScale = 1.0f / glm::vec3{ellipsoid.getA() * ellipsoid.getA(),
+		ellipsoid.getB() * ellipsoid.getB(), ellipsoid.getC() * ellipsoid.getC()};
+	glm::vec3 gradientMin = bounds.min * gradientScale;
+	glm::vec3 gradientMax = bounds.max * gradientScale;
+	float maxReflectance = (material.diffuseCoef + material.specularCoef) *
+		std::max({material.color.r, material.color.g, material.color.b});
+
+	const LightList::Components& lights = raycaster.getLights().getComponents();
+	int tileLightCount = 0;
+	for (int light = 0; light < m_lightCount; ++light)
+	{
+		glm::vec3 vector{lights.x[light], lights.y[light], lights.z[light]};
+		float w = lights.w[light];
+		glm::vec3 lightMin = vector - w * bounds.max;
+		glm::vec3 lightMax = vector - w * bounds.min;
+
+		float maxLightNormalDot = 0;
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			maxLightNormalDot += std::max({gradientMin[axis] * lightMin[axis],
+				gradientMin[axis] * lightMax[axis], gradientMax[axis] * lightMin[axis],
+				gradientMax[axis] * lightMax[axis]});
+		}
+		if (maxLightNormalDot <= 0)
+		{
+			continue;
+		}
+
+		glm::vec3 closestPoint = glm::clamp(vector, bounds.min, bounds.max);
+		glm::vec3 closestOffset = w * (vector - closestPoint);
+		float falloff =
+			1 - glm::dot(closestOffset, closestOffset) * lights.invRangeSquared[light];
+		float maxContribution = falloff * falloff * maxReflectance *
+			std::max({lights.red[light], lights.green[light], lights.blue[light]});
+		if (falloff <= 0 || maxContribution < contributionThreshold)
+		{
+			continue;
+		}
+
+		tileLights[tileLightCount++] = static_cast<std::uint16_t>(light);
+	}
+	return tileLightCount;
+}
+
+bool LightCulling::calcTileBounds(const Raycaster& raycaster, const glm::vec2& ndcMin,
+	const glm::vec2& ndcMax, const glm::vec2& ndcDepthRange, Bounds& bounds)
+{
+	const std::array<glm::vec2, 4> corners{{ndcMin, {ndcMax.x, ndcMin.y}, {ndcMin.x, ndcMax.y},
+		ndcMax}};
+	glm::vec2 center = (ndcMin + ndcMax) / 2.0f;
+	std::optional<float> centerDepth = raycaster.calcIntersection(center.x, center.y);
+	bool isInterior = centerDepth.has_value();
+	float maxDepth = std::numeric_limits<float>::lowest();
+	for (const glm::vec2& corner : corners)
+	{
+		std::optional<float> depth = raycaster.calcIntersection(corner.x, corner.y);
+		isInterior = isInterior && depth.has_value();
+		maxDepth = std::max(maxDepth, depth.value_or(maxDepth));
+	}
+
+	glm::vec2 depthRange = ndcDepthRange;
+	if (isInterior)
+	{
+		glm::vec3 gradient{
+			raycaster.getCameraEllipsoidMatrix() * glm::vec4{center, *centerDepth, 1}};
+		glm::vec2 depthSlope = -glm::vec2{gradient} / gradient.z;
+		float minDepth = std::numeric_limits<float>::max();
+		for (const glm::vec2& corner : corners)
+		{
+			minDepth = std::min(minDepth, *centerDepth + glm::dot(depthSlope, corner - center));
+		}
+		depthRange = {std::max(depthRange.x, minDepth), std::min(depthRange.y, maxDepth)};
+	}
+	else
+	{
+		float maxChordMidpoint = std::numeric_limits<float>::lowest();
+		for (const glm::vec2& corner : corners)
+		{
+			maxChordMidpoint =
+				std::max(maxChordMidpoint, raycaster.calcChordMidpoint(corner.x, corner.y));
+		}
+		depthRange.y = std::min(depthRange.y, maxChordMidpoint);
+	}
+	if (depthRange.x > depthRange.y)
+	{
+		return false;
+	}
+
+	const glm::mat4& cameraMatrix = raycaster.getCameraMatrix();
+	bounds.min = glm::vec3{std::numeric_limits<float>::max()};
+	bounds.max = glm::vec3{std::numeric_limits<float>::lowest()};
+	for (int corner = 0; corner < 8; ++corner)
+	{
+		glm::vec4 ndc{corners[corner % 4], corner < 4 ? depthRange.x : depthRange.y, 1};
+		glm::vec3 point{cameraMatrix * ndc};
+		bounds.min = glm::min(bounds.min, point);
+		bounds.max = glm::max(bounds.max, point);
+	}
+
+	const Ellipsoid& ellipsoid = raycaster.getEllipsoid();
+	glm::vec3 extent{ellipsoid.getA(), ellipsoid.getB(), ellipsoid.getC()};
+	bounds.min = glm::max(bounds.min, -extent);
+	bounds.max = glm::min(bounds.max, extent);
+	return bounds.min.x <= bounds.max.x && bounds.min.y <= bounds.max.y &&
+		bounds.min.z <= bounds.max.z;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "raycaster.hpp"
+#include "threadPool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class LightCulling
+{
+public:
+	static constexpr int tileSize = 64;
+	static constexpr float contributionThreshold = 0.5f;
+
+	void cull(const Raycaster& raycaster, const glm::ivec2& viewportSize,
+		const glm::vec2& ndcOrigin, const glm::vec2& ndcPixelSize, int margin,
+		ThreadPool& threadPool);
+	void clear();
+	bool isActive() const;
+	std::span<const std::uint16_t> getTileLights(int x, int y) const;
+	float getMeanTileLightCount() const;
+
+private:
+	struct Bounds
+	{
+		glm::vec3 min{};
+		glm::vec3 max{};
+	};
+
+	glm::ivec2 m_tileCount{};
+	int m_lightCount{};
+	float m_meanTileLightCount{};
+	std::vector<std::uint16_t> m_tileLights{};
+	std::vector<int> m_tileLightCounts{};
+
+	int cullTile(const Raycaster& raycaster, const Bounds& bounds, std::uint16_t* tileLights)
+		const;
+	static bool calcTileBounds(const Raycaster& raycaster, const glm::vec2& ndcMin,
+		const glm::vec2& ndcMax, const glm::vec2& ndcDepthRange, Bounds& bounds);
+};
@@ -0,0 +1,108 @@
+#include "lightList.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+constexpr std::array<glm::vec3, 6> ringColors
+{{
+	{1.0f, 0.3f, 0.3f},
+	{0.3f, 1.0f, 0.3f},
+	{0.3f, 0.3f, 1.0f},
+	{1.0f, 1.0f, 0.3f},
+	{0.3f, 1.0f, 1.0f},
+	{1.0f, 0.3f, 1.0f}
+}};
+constexpr int ringDirectionalInterval = 4;
+constexpr float ringRangeScale = 1.5f;
+constexpr float ringTotalIntensity = 4.0f;
+
+bool LightList::add(const Light& light)
+{
+	if (getCount() >= maxLightCount)
+	{
+		return false;
+	}
+
+	bool isPoint = light.type == Type::point;
+	glm::vec3 vector = isPoint ? light.vector : glm::normalize(light.vector);
+	m_indices.push_back(static_cast<std::uint16_t>(getCount()));
+	m_components.x.push_back(vector.x);
+	m_components.y.push_back(vector.y);
+	m_components.z.push_back(vector.z);
+	m_components.w.push_back(isPoint ? 1.0f : 0.0f);
+	m_components.red.push_back(light.color.r);
+	m_components.green.push_back(light.color.g);
+	m_components.blue.push_back(light.color.b);
+	m_components.invRangeSquared.push_back(isPoint && light.range > 0 ?
+		1 / (light.range * light.range) : 0.0f);
+	return true;
+}
+
+void LightList::clear()
+{
+	m_indices.clear();
+	m_components.x.clear();
+	m_components.y.clear();
+	m_components.z.clear();
+	m_components.w.clear();
+	m_components.red.clear();
+	m_components.green.clear();
+	m_components.blue.clear();
+	m_components.invRangeSquared.clear();
+}
+
+int LightList::getCount() const
+{
+	return static_cast<int>(m_indices.size());
+}
+
+bool LightList::isEmpty() const
+{
+	return m_indices.empty();
+}
+
+LightList::Light LightList::get(int index) const
+{
+	Light light{};
+	light.type = m_components.w[index] > 0 ? Type::point : Type::directional;
+	light.vector = {m_components.x[index], m_components.y[index], m_components.z[index]};
+	light.color = {m_components.red[index], m_components.green[index], m_components.blue[index]};
+	float invRangeSquared = m_components.invRangeSquared[index];
+	light.range = invRangeSquared > 0 ? 1 / std::sqrt(invRangeSquared) : 0.0f;
+	return light;
+}
+
+const LightList::Components& LightList::getComponents() const
+{
+	return m_components;
+}
+
+const std::vector<std::uint16_t>& LightList::getIndices() const
+{
+	return m_indices;
+}
+
+LightList LightList::createRing(int count, float radius)
+{
+	LightList lights{};
+	count = std::clamp(count, 0, maxLightCount);
+	float intensity = std::min(1.0f, ringTotalIntensity / std::max(count, 1));
+	for (int i = 0; i < count; ++i)
+	{
+		float angle = 2 * glm::pi<float>() * i / count;
+		glm::vec3 position{radius * std::cos(angle), (i % 2 == 0 ? 0.5f : -0.5f) * radius,
+			radius * std::sin(angle)};
+
+		Light light{};
+		light.type = i % ringDirectionalInterval == ringDirectionalInterval - 1 ?
+			Type::directional : Type::point;
+		light.vector = position;
+		light.color = intensity * ringColors[i % ringColors.size()];
+		light.range = ringRangeScale * radius;
+		lights.add(light);
+	}
+	return lights;
+}
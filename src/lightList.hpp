@@ -0,0 +1,54 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+class LightList
+{
+public:
+	enum class Type
+	{
+		point,
+		directional
+	};
+
+	struct Light
+	{
+		Type type = Type::directional;
+		glm::vec3 vector{0, 0, 1};
+		glm::vec3 color{1, 1, 1};
+		float range{};
+	};
+
+	struct Components
+	{
+		std::vector<float> x{};
+		std::vector<float> y{};
+		std::vector<float> z{};
+		std::vector<float> w{};
+		std::vector<float> red{};
+		std::vector<float> green{};
+		std::vector<float> blue{};
+		std::vector<float> invRangeSquared{};
+	};
+
+	static constexpr int maxLightCount = 64;
+	static constexpr float defaultRingRadius = 12.0f;
+
+	bool add(const Light& light);
+	void clear();
+	int getCount() const;
+	bool isEmpty() const;
+	Light get(int index) const;
+
+	const Components& getComponents() const;
+	const std::vector<std::uint16_t>& getIndices() const;
+
+	static LightList createRing(int count, float radius);
+
+private:
+	Components m_components{};
+	std::vector<std::uint16_t> m_indices{};
+};
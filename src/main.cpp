@@ -1,22 +1,326 @@
+#include "allocationCounter.hpp"
+#include "animation/animationRender.hpp"
+#include "backends/backendComparison.hpp"
+#include "benchmark/lightBenchmark.hpp"
+#include "benchmark/numaBenchmark.hpp"
+#include "benchmark/precisionBenchmark.hpp"
+#include "benchmark/refinementBenchmark.hpp"
+#include "benchmark/traversalBenchmark.hpp"
+#include "capture/frameCapture.hpp"
+#include "commandLine.hpp"
+#include "distributed/tileCoordinator.hpp"
+#include "distributed/tileWorker.hpp"
+#include "frameCache.hpp"
+#include "framebufferAllocator.hpp"
 #include "gui/gui.hpp"
-#include "scene.hpp"
+#include "latencyTracker.hpp"
+#include "perfCounters.hpp"
+#include "resizeSweep.hpp"
+#include "service/loadTest.hpp"
+#include "service/renderClient.hpp"
+#include "service/renderService.hpp"
+#include "shaderPrograms.hpp"
+#include "splitView.hpp"
+#include "streaming/streamServer.hpp"
+#include "streaming/streamViewer.hpp"
+#include "sweep/parameterSweep.hpp"
+#include "threadPool.hpp"
+#include "tiled/tiledRender.hpp"
+#include "trace/inputTrace.hpp"
+#include "trace/traceReplay.hpp"
+#include "tuning/autoTuner.hpp"
+#include "tuning/renderProfile.hpp"
 #include "window.hpp"
 
-int main()
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+
+constexpr int allocationReportFrames = 120;
+constexpr int resizeSweepFrames = 240;
+constexpr int resizeSettleFrames = 60;
+
+int runInteractive(const CommandLine& commandLine)
 {
+	using Clock = std::chrono::steady_clock;
+
+	const bool isStartupBenchmark = commandLine.hasOption("benchmark");
+	std::string captureFormatName = commandLine.getString("capture-format", "png");
+	std::optional<FrameExporter::Format> captureFormat =
+		FrameExporter::parseFormat(captureFormatName);
+	if (!captureFormat.has_value())
+	{
+		std::cerr << "Invalid value of --capture-format: " << captureFormatName << '\n';
+		return 1;
+	}
+	std::string pageModeName = commandLine.getString("page-mode", "standard");
+	std::optional<PageAllocator::PageMode> pageMode = PageAllocator::parsePageMode(pageModeName);
+	if (!pageMode.has_value())
+	{
+		std::cerr << "Invalid value of --page-mode: " << pageModeName << '\n';
+		return 1;
+	}
+	const bool isNumaAware = commandLine.hasOption("numa");
+	PageAllocator::setPageMode(*pageMode);
+	PageAllocator::setFirstTouchDistributed(isNumaAware);
+
+	int frameCacheMiB = std::max(commandLine.getInt("frame-cache-mb",
+		static_cast<int>(FrameCache::defaultCapacityBytes / FrameCache::bytesPerMiB)), 0);
+	FrameCache frameCache{frameCacheMiB * FrameCache::bytesPerMiB,
+		commandLine.getString("frame-cache-dir", "")};
+
+	Clock::time_point start = Clock::now();
 	Window window{};
-	Scene scene{window.viewportSize()};
-	GUI gui{window.getPtr(), scene, window.viewportSize()};
-	window.init(scene);
+	Clock::time_point windowCreated = Clock::now();
+	SplitView splitView{window.viewportSize()};
+	splitView.setViewCount(commandLine.getInt("views", 1));
+	if (commandLine.hasOption("perf-counters"))
+	{
+		splitView.getThreadPool().setCountersEnabled(true);
+		if (!PerfCounters::isSupported())
+		{
+			std::cerr << "Hardware performance counters are unavailable\n";
+		}
+	}
+	if (frameCacheMiB > 0 || commandLine.hasOption("frame-cache-dir"))
+	{
+		splitView.setFrameCache(&frameCache);
+	}
+	if (isNumaAware)
+	{
+		splitView.getThreadPool().setScheduling(ThreadPool::Scheduling::affinity);
+		if (!splitView.getThreadPool().pinToNodes(NumaTopology::detect()))
+		{
+			std::cerr << "Cannot pin render threads to NUMA nodes\n";
+		}
+	}
+	std::filesystem::path profilePath = commandLine.getString("profile",
+		RenderProfile::getDefaultPath().string());
+	std::optional<RenderProfile> profile = commandLine.hasOption("tune") ? std::nullopt :
+		RenderProfile::load(profilePath);
+	AutoTuner tuner{splitView.getThreadPool()};
+	if (profile.has_value())
+	{
+		splitView.setRenderProfile(*profile);
+	}
+	else
+	{
+		tuner.start();
+	}
+	FrameCapture frameCapture{commandLine.getString("capture-dir", FrameCapture::defaultDirectory),
+		*captureFormat};
+	frameCapture.setCapturingConverged(commandLine.hasOption("capture-converged"));
+	LatencyTracker latencyTracker{};
+	GUI gui{window.getPtr(), splitView, frameCapture, latencyTracker, tuner,
+		window.viewportSize()};
+	window.init(splitView, latencyTracker);
+
+	AllocationCounter::setEnabled(commandLine.hasOption("count-allocations"));
+	std::uint64_t allocationCount = AllocationCounter::getCount();
+	std::uint64_t maxFrameAllocations = 0;
+	std::uint64_t reportAllocations = 0;
+	int reportFrame = 0;
 
+	std::optional<InputRecorder> recorder{};
+	if (commandLine.hasOption("record-trace"))
+	{
+		std::string tracePath = commandLine.getString("record-trace", "");
+		recorder.emplace(tracePath.empty() ? InputTrace::defaultPath : tracePath,
+			window.viewportSize());
+		splitView.setRecorder(&*recorder);
+	}
+
+	std::optional<ResizeSweep> resizeSweep{};
+	if (commandLine.hasOption("resize-sweep"))
+	{
+		resizeSweep.emplace(window.viewportSize(), resizeSweepFrames, resizeSettleFrames);
+	}
+	Clock::time_point frameStart = Clock::now();
 	while (!window.shouldClose())
 	{
+		if (resizeSweep.has_value())
+		{
+			Clock::time_point now = Clock::now();
+			std::optional<glm::ivec2> size = resizeSweep->nextFrame(
+				std::chrono::duration<double, std::milli>(now - frameStart).count(),
+				splitView.isResizePending());
+			frameStart = now;
+			if (resizeSweep->isFinished())
+			{
+				resizeSweep->printReport(std::cout);
+				break;
+			}
+			if (size.has_value())
+			{
+				window.setViewportSize(*size);
+			}
+		}
+
 		gui.update();
-		scene.render();
+		splitView.render();
+		frameCapture.update({LeftPanel::width, 0}, window.viewportSize(), splitView.isConverged(),
+			splitView.getRevision());
 		gui.render();
 		window.swapBuffers();
+		latencyTracker.submitFrame(splitView.isConverged());
+		latencyTracker.update();
 		window.pollEvents();
+		if (tuner.isTuning() && tuner.step())
+		{
+			if (!tuner.getProfile().save(profilePath))
+			{
+				std::cerr << "Cannot write render profile: " << profilePath.string() << '\n';
+			}
+			splitView.setRenderProfile(tuner.getProfile());
+		}
+
+		if (AllocationCounter::isEnabled())
+		{
+			std::uint64_t frameAllocations = AllocationCounter::getCount() - allocationCount;
+			allocationCount += frameAllocations;
+			maxFrameAllocations = std::max(maxFrameAllocations, frameAllocations);
+			reportAllocations += frameAllocations;
+			if (++reportFrame == allocationReportFrames)
+			{
+				std::cout << "allocations per frame: mean " <<
+					static_cast<double>(reportAllocations) / reportFrame << ", max " <<
+					maxFrameAllocations << '\n';
+				maxFrameAllocations = 0;
+				reportAllocations = 0;
+				reportFrame = 0;
+			}
+		}
+
+		if (isStartupBenchmark)
+		{
+			std::chrono::duration<double, std::milli> timeToFirstFrame = Clock::now() - start;
+			std::chrono::duration<double, std::milli> windowTime = windowCreated - start;
+			std::cout << "time to first frame: " << timeToFirstFrame.count() << " ms\n";
+			std::cout << "window, context and shader programs: " << windowTime.count() <<
+				" ms, shader programs " <<
+				(ShaderPrograms::areLoadedFromCache() ? "loaded from cache" : "compiled") << '\n';
+			break;
+		}
 	}
 
+	frameCapture.flush();
+	if (commandLine.hasOption("latency-report"))
+	{
+		latencyTracker.flush();
+		latencyTracker.printReport(std::cout);
+	}
+	const FrameExporter& exporter = frameCapture.getExporter();
+	if (exporter.getSubmittedCount() > 0 || exporter.getDroppedCount() > 0)
+	{
+		std::cout << "exported " << exporter.getWrittenCount() << " frames, dropped " <<
+			exporter.getDroppedCount() << ", mean encode and write " <<
+			exporter.getMeanWriteMs() << " ms\n";
+	}
+
+	if (recorder.has_value())
+	{
+		splitView.setRecorder(nullptr);
+		if (!recorder->isGood())
+		{
+			std::cerr << "Cannot write input trace\n";
+			return 1;
+		}
+		std::cout << "recorded " << recorder->getEventCount() << " input trace events\n";
+	}
 	return 0;
 }
+
+int main(int argc, char** argv)
+{
+	CommandLine commandLine{argc, argv};
+	const std::string& mode = commandLine.getMode();
+
+	if (mode.empty())
+	{
+		return runInteractive(commandLine);
+	}
+	if (mode == "compare-backends")
+	{
+		return BackendComparison::run(commandLine);
+	}
+	if (mode == "refinement-benchmark")
+	{
+		return RefinementBenchmark::run(commandLine);
+	}
+	if (mode == "light-benchmark")
+	{
+		return LightBenchmark::run(commandLine);
+	}
+	if (mode == "numa-benchmark")
+	{
+		return NumaBenchmark::run(commandLine);
+	}
+	if (mode == "precision-benchmark")
+	{
+		return PrecisionBenchmark::run(commandLine);
+	}
+	if (mode == "traversal-benchmark")
+	{
+		return TraversalBenchmark::run(commandLine);
+	}
+	if (mode == "replay")
+	{
+		return TraceReplay::run(commandLine);
+	}
+	if (mode == "coordinator")
+	{
+		return TileCoordinator::run(commandLine);
+	}
+	if (mode == "worker")
+	{
+		return TileWorker::run(commandLine);
+	}
+	if (mode == "daemon")
+	{
+		int frameCacheMiB = std::max(commandLine.getInt("frame-cache-mb",
+			static_cast<int>(FrameCache::defaultCapacityBytes / FrameCache::bytesPerMiB)), 0);
+		RenderService service{commandLine.getString("socket", "ellipsoid-raycasting.sock"),
+			commandLine.getInt("threads", ThreadPool::defaultThreadCount()),
+			frameCacheMiB * FrameCache::bytesPerMiB, commandLine.getString("frame-cache-dir", "")};
+		return service.run();
+	}
+	if (mode == "client")
+	{
+		return RenderClient::run(commandLine);
+	}
+	if (mode == "stream")
+	{
+		return StreamServer::run(commandLine);
+	}
+	if (mode == "viewer")
+	{
+		return StreamViewer::run(commandLine);
+	}
+	if (mode == "load-test")
+	{
+		return LoadTest::run(commandLine);
+	}
+	if (mode == "sweep")
+	{
+		return ParameterSweep::run(commandLine);
+	}
+	if (mode == "animate")
+	{
+		return AnimationRender::run(commandLine);
+	}
+	if (mode == "tiled")
+	{
+		return TiledRender::run(commandLine);
+	}
+	if (mode == "tune")
+	{
+		return AutoTuner::run(commandLine);
+	}
+
+	std::cerr << "Unknown mode: " << mode << '\n';
+	return 1;
+}
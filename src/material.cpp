@@ -1,5 +1,7 @@
 #include "material.hpp"
 
+#include <initializer_list>
+
 Material::Material(const glm::ivec3& color, float ambientCoef, float diffuseCoef,
 	float specularCoef, float shininess) :
 	color{color},
@@ -8,3 +10,22 @@ Material::Material(const glm::ivec3& color, float ambientCoef, float diffuseCoef
 	specularCoef{specularCoef},
 	shininess{shininess}
 { }
+
+bool Material::isValid() const
+{
+	for (int channel = 0; channel < 3; ++channel)
+	{
+		if (color[channel] < 0 || color[channel] > maxColorComponent)
+		{
+			return false;
+		}
+	}
+	for (float coef : {ambientCoef, diffuseCoef, specularCoef})
+	{
+		if (!(coef >= 0 && coef <= maxCoef))
+		{
+			return false;
+		}
+	}
+	return shininess >= minShininess && shininess <= maxShininess;
+}
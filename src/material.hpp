@@ -4,6 +4,11 @@
 
 struct Material
 {
+	static constexpr int maxColorComponent = 255;
+	static constexpr float maxCoef = 1.0f;
+	static constexpr float minShininess = 1.0f;
+	static constexpr float maxShininess = 100.0f;
+
 	glm::ivec3 color{};
 	float ambientCoef{};
 	float diffuseCoef{};
@@ -12,4 +17,8 @@ struct Material
 
 	Material(const glm::ivec3& color, float ambientCoef, float diffuseCoef, float specularCoef,
 		float shininess);
+
+	bool isValid() const;
+
+	bool operator==(const Material& material) const = default;
 };
@@ -0,0 +1,88 @@
+#include "motionPredictor.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <cmath>
+
+void MotionPredictor::record(const CameraState& state, Clock::time_point time)
+{
+	if (!m_samples.empty() && (state.targetPos != m_samples.back().state.targetPos ||
+		time - m_samples.back().time > motionTimeout))
+	{
+		m_samples.clear();
+	}
+
+	glm::vec3 motion{state.pitchRad, state.yawRad, std::log(state.viewWidth)};
+	if (!m_samples.empty())
+	{
+		float previousYaw = m_samples.back().motion.y;
+		motion.y = previousYaw + std::remainder(state.yawRad - previousYaw, 2 * glm::pi<float>());
+	}
+	m_samples.push_back(Sample{time, state, motion});
+	while (static_cast<int>(m_samples.size()) > maxSampleCount ||
+		time - m_samples.front().time > sampleWindow)
+	{
+		m_samples.pop_front();
+	}
+	updateVelocity();
+}
+
+void MotionPredictor::reset()
+{
+	m_samples.clear();
+	m_velocity = {};
+}
+
+bool MotionPredictor::isMoving(Clock::time_point time) const
+{
+	return m_samples.size() >= 2 && time - m_samples.back().time <= motionTimeout &&
+		glm::length(m_velocity) >= minSpeed;
+}
+
+std::optional<CameraState> MotionPredictor::predict(std::chrono::duration<float> lookahead,
+	Clock::time_point time) const
+{
+	if (!isMoving(time))
+	{
+		return std::nullopt;
+	}
+
+	float seconds = lookahead.count();
+	CameraState state = m_samples.back().state;
+	state.pitchRad += m_velocity.x * seconds;
+	state.yawRad += m_velocity.y * seconds;
+	state.viewWidth *= std::exp(m_velocity.z * seconds);
+	return state;
+}
+
+void MotionPredictor::updateVelocity()
+{
+	m_velocity = {};
+	if (m_samples.size() < 2)
+	{
+		return;
+	}
+
+	const Clock::time_point origin = m_samples.back().time;
+	const float sampleCount = static_cast<float>(m_samples.size());
+	float meanTime = 0;
+	glm::vec3 meanMotion{};
+	for (const Sample& sample : m_samples)
+	{
+		meanTime += std::chrono::duration<float>(sample.time - origin).count() / sampleCount;
+		meanMotion += sample.motion / sampleCount;
+	}
+
+	float timeVariance = 0;
+	glm::vec3 covariance{};
+	for (const Sample& sample : m_samples)
+	{
+		float time = std::chrono::duration<float>(sample.time - origin).count() - meanTime;
+		timeVariance += time * time;
+		covariance += time * (sample.motion - meanMotion);
+	}
+	if (timeVariance > 0)
+	{
+		m_velocity = covariance / timeVariance;
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "camera.hpp"
+
+#include <glm/glm.hpp>
+
+#include <chrono>
+#include <deque>
+#include <optional>
+
+class MotionPredictor
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr std::chrono::milliseconds sampleWindow{100};
+	static constexpr std::chrono::milliseconds motionTimeout{100};
+	static constexpr int maxSampleCount = 32;
+	static constexpr float minSpeed = 1e-3f;
+
+	void record(const CameraState& state, Clock::time_point time);
+	void reset();
+
+	bool isMoving(Clock::time_point time) const;
+	std::optional<CameraState> predict(std::chrono::duration<float> lookahead,
+		Clock::time_point time) const;
+
+private:
+	struct Sample
+	{
+		Clock::time_point time{};
+		CameraState state{};
+		glm::vec3 motion{};
+	};
+
+	std::deque<Sample> m_samples{};
+	glm::vec3 m_velocity{};
+
+	void updateVelocity();
+};
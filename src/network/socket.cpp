@@ -0,0 +1,382 @@
+#include "network/socket.hpp"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <afunix.h>
+#else
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <string_view>
+#include <utility>
+
+#ifdef _WIN32
+using SocketLength = int;
+#else
+using SocketLength = socklen_t;
+#endif
+
+#ifdef MSG_NOSIGNAL
+constexpr int sendFlags = MSG_NOSIGNAL;
+#else
+constexpr int sendFlags = 0;
+#endif
+
+constexpr int listenBacklog = 64;
+constexpr std::string_view tcpAddressPrefix = "tcp:";
+constexpr std::uint32_t maxMessageSize = 1u << 30;
+
+Socket::Socket(Socket&& socket) noexcept :
+	m_handle{std::exchange(socket.m_handle, invalidHandle)}
+{ }
+
+Socket::~Socket()
+{
+	close();
+}
+
+Socket& Socket::operator=(Socket&& socket) noexcept
+{
+	if (this != &socket)
+	{
+		close();
+		m_handle = std::exchange(socket.m_handle, invalidHandle);
+	}
+	return *this;
+}
+
+Socket Socket::listen(const std::string& address)
+{
+	std::string host{};
+	std::string port{};
+	return parseTcpAddress(address, host, port) ? listenTcp(host, port) : listenUnix(address);
+}
+
+Socket Socket::connect(const std::string& address)
+{
+	std::string host{};
+	std::string port{};
+	return parseTcpAddress(address, host, port) ? connectTcp(host, port) : connectUnix(address);
+}
+
+Socket Socket::listenUnix(const std::string& path)
+{
+	initPlatform();
+
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(address.sun_path))
+	{
+		printError("Socket path too long: " + path);
+		return {};
+	}
+	std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+	Socket socket{static_cast<Handle>(::socket(AF_UNIX, SOCK_STREAM, 0))};
+	if (!socket.isValid())
+	{
+		printError("Error creating socket");
+		return {};
+	}
+
+	std::error_code error{};
+	if (std::filesystem::exists(std::filesystem::symlink_status(path, error)))
+	{
+		Socket probe{static_cast<Handle>(::socket(AF_UNIX, SOCK_STREAM, 0))};
+		if (!isSocketFile(path) || !probe.isValid() ||
+			::connect(probe.m_handle, reinterpret_cast<const sockaddr*>(&address),
+				sizeof(address)) == 0)
+		{
+			printError("Address in use: " + path);
+			return {};
+		}
+		std::filesystem::remove(path, error);
+	}
+	if (::bind(socket.m_handle, reinterpret_cast<const sockaddr*>(&address),
+			sizeof(address)) != 0 ||
+		::listen(socket.m_handle, listenBacklog) != 0)
+	{
+		printError("Error listening on " + path);
+		return {};
+	}
+	return socket;
+}
+
+Socket Socket::connectUnix(const std::string& path)
+{
+	initPlatform();
+
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(address.sun_path))
+	{
+		printError("Socket path too long: " + path);
+		return {};
+	}
+	std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+	Socket socket{static_cast<Handle>(::socket(AF_UNIX, SOCK_STREAM, 0))};
+	if (!socket.isValid() ||
+		::connect(socket.m_handle, reinterpret_cast<const sockaddr*>(&address),
+			sizeof(address)) != 0)
+	{
+		printError("Error connecting to " + path);
+		return {};
+	}
+	return socket;
+}
+
+Socket Socket::listenTcp(const std::string& host, const std::string& port)
+{
+	return openTcp(host, port, true);
+}
+
+Socket Socket::connectTcp(const std::string& host, const std::string& port)
+{
+	return openTcp(host, port, false);
+}
+
+bool Socket::isValid() const
+{
+	return m_handle != invalidHandle;
+}
+
+Socket Socket::accept() const
+{
+	Socket socket{static_cast<Handle>(::accept(m_handle, nullptr, nullptr))};
+	int isEnabled = 1;
+	::setsockopt(socket.m_handle, IPPROTO_TCP, TCP_NODELAY,
+		reinterpret_cast<const char*>(&isEnabled), sizeof(isEnabled));
+	return socket;
+}
+
+bool Socket::waitReadable(std::chrono::milliseconds timeout) const
+{
+#ifdef _WIN32
+	WSAPOLLFD descriptor{};
+	descriptor.fd = m_handle;
+	descriptor.events = POLLRDNORM;
+	return ::WSAPoll(&descriptor, 1, static_cast<int>(timeout.count())) > 0;
+#else
+	pollfd descriptor{};
+	descriptor.fd = m_handle;
+	descriptor.events = POLLIN;
+	return ::poll(&descriptor, 1, static_cast<int>(timeout.count())) > 0;
+#endif
+}
+
+void Socket::shutdown() const
+{
+#ifdef _WIN32
+	::shutdown(m_handle, SD_BOTH);
+#else
+	::shutdown(m_handle, SHUT_RDWR);
+#endif
+}
+
+bool Socket::send(const void* data, std::size_t size) const
+{
+	const char* bytes = static_cast<const char*>(data);
+	while (size > 0)
+	{
+		int chunkSize = static_cast<int>(std::min<std::size_t>(size, 1u << 20));
+		auto sent = ::send(m_handle, bytes, chunkSize, sendFlags);
+		if (sent <= 0)
+		{
+			return false;
+		}
+		bytes += sent;
+		size -= static_cast<std::size_t>(sent);
+	}
+	return true;
+}
+
+bool Socket::receive(void* data, std::size_t size) const
+{
+	char* bytes = static_cast<char*>(data);
+	while (size > 0)
+	{
+		int chunkSize = static_cast<int>(std::min<std::size_t>(size, 1u << 20));
+		auto received = ::recv(m_handle, bytes, chunkSize, 0);
+		if (received <= 0)
+		{
+			return false;
+		}
+		bytes += received;
+		size -= static_cast<std::size_t>(received);
+	}
+	return true;
+}
+
+bool Socket::sendMessage(const std::vector<unsigned char>& message) const
+{
+	std::uint32_t size = static_cast<std::uint32_t>(message.size());
+	unsigned char header[4] =
+	{
+		static_cast<unsigned char>(size),
+		static_cast<unsigned char>(size >> 8),
+		static_cast<unsigned char>(size >> 16),
+		static_cast<unsigned char>(size >> 24)
+	};
+	return send(header, sizeof(header)) && send(message.data(), message.size());
+}
+
+bool Socket::receiveMessage(std::vector<unsigned char>& message) const
+{
+	unsigned char header[4]{};
+	if (!receive(header, sizeof(header)))
+	{
+		return false;
+	}
+	std::uint32_t size = static_cast<std::uint32_t>(header[0]) |
+		static_cast<std::uint32_t>(header[1]) << 8 |
+		static_cast<std::uint32_t>(header[2]) << 16 |
+		static_cast<std::uint32_t>(header[3]) << 24;
+	if (size > maxMessageSize)
+	{
+		printError("Message too large");
+		return false;
+	}
+	message.resize(size);
+	return receive(message.data(), size);
+}
+
+Socket::Socket(Handle handle) :
+	m_handle{handle}
+{ }
+
+void Socket::close()
+{
+	if (!isValid())
+	{
+		return;
+	}
+#ifdef _WIN32
+	::closesocket(m_handle);
+#else
+	::close(m_handle);
+#endif
+	m_handle = invalidHandle;
+}
+
+Socket Socket::openTcp(const std::string& host, const std::string& port, bool isListening)
+{
+	initPlatform();
+
+	addrinfo hints{};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = isListening ? AI_PASSIVE : 0;
+	addrinfo* addresses{};
+	if (::getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints,
+		&addresses) != 0)
+	{
+		printError("Cannot resolve " + host + ':' + port);
+		return {};
+	}
+
+	Socket socket{};
+	for (addrinfo* address = addresses; address != nullptr; address = address->ai_next)
+	{
+		Socket candidate{static_cast<Handle>(::socket(address->ai_family, address->ai_socktype,
+			address->ai_protocol))};
+		if (!candidate.isValid())
+		{
+			continue;
+		}
+
+		int isEnabled = 1;
+		const char* option = reinterpret_cast<const char*>(&isEnabled);
+		bool isOpen{};
+		if (isListening)
+		{
+			::setsockopt(candidate.m_handle, SOL_SOCKET, SO_REUSEADDR, option, sizeof(isEnabled));
+			isOpen = ::bind(candidate.m_handle, address->ai_addr,
+				static_cast<SocketLength>(address->ai_addrlen)) == 0 &&
+				::listen(candidate.m_handle, listenBacklog) == 0;
+		}
+		else
+		{
+			::setsockopt(candidate.m_handle, IPPROTO_TCP, TCP_NODELAY, option, sizeof(isEnabled));
+			isOpen = ::connect(candidate.m_handle, address->ai_addr,
+				static_cast<SocketLength>(address->ai_addrlen)) == 0;
+		}
+
+		if (isOpen)
+		{
+			socket = std::move(candidate);
+			break;
+		}
+	}
+	::freeaddrinfo(addresses);
+
+	if (!socket.isValid())
+	{
+		printError(std::string{isListening ? "Error listening on " : "Error connecting to "} +
+			host + ':' + port);
+	}
+	return socket;
+}
+
+bool Socket::parseTcpAddress(const std::string& address, std::string& host, std::string& port)
+{
+	if (!address.starts_with(tcpAddressPrefix))
+	{
+		return false;
+	}
+
+	std::size_t separator = address.rfind(':');
+	if (separator < tcpAddressPrefix.size())
+	{
+		host.clear();
+		port = address.substr(tcpAddressPrefix.size());
+		return true;
+	}
+	host = address.substr(tcpAddressPrefix.size(), separator - tcpAddressPrefix.size());
+	port = address.substr(separator + 1);
+	return true;
+}
+
+void Socket::initPlatform()
+{
+#ifdef _WIN32
+	static std::once_flag initFlag{};
+	std::call_once(initFlag,
+		[] ()
+		{
+			WSADATA data{};
+			WSAStartup(MAKEWORD(2, 2), &data);
+		}
+	);
+#endif
+}
+
+bool Socket::isSocketFile(const std::string& path)
+{
+#ifdef _WIN32
+	DWORD attributes = GetFileAttributesA(path.c_str());
+	return attributes != INVALID_FILE_ATTRIBUTES &&
+		(attributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
+#else
+	struct stat status{};
+	return ::lstat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode);
+#endif
+}
+
+void Socket::printError(const std::string& message)
+{
+	std::cerr << message << '\n';
+}
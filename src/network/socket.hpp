@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Socket
+{
+public:
+	Socket() = default;
+	Socket(const Socket&) = delete;
+	Socket(Socket&& socket) noexcept;
+	~Socket();
+
+	Socket& operator=(const Socket&) = delete;
+	Socket& operator=(Socket&& socket) noexcept;
+
+	static Socket listen(const std::string& address);
+	static Socket connect(const std::string& address);
+	static Socket listenUnix(const std::string& path);
+	static Socket connectUnix(const std::string& path);
+	static Socket listenTcp(const std::string& host, const std::string& port);
+	static Socket connectTcp(const std::string& host, const std::string& port);
+
+	bool isValid() const;
+	Socket accept() const;
+	bool waitReadable(std::chrono::milliseconds timeout) const;
+	void shutdown() const;
+
+	bool send(const void* data, std::size_t size) const;
+	bool receive(void* data, std::size_t size) const;
+	bool sendMessage(const std::vector<unsigned char>& message) const;
+	bool receiveMessage(std::vector<unsigned char>& message) const;
+
+private:
+#ifdef _WIN32
+	using Handle = std::uintptr_t;
+	static constexpr Handle invalidHandle = ~Handle{0};
+#else
+	using Handle = int;
+	static constexpr Handle invalidHandle = -1;
+#endif
+
+	Handle m_handle = invalidHandle;
+
+	explicit Socket(Handle handle);
+	void close();
+
+	static Socket openTcp(const std::string& host, const std::string& port, bool isListening);
+	static bool parseTcpAddress(const std::string& address, std::string& host, std::string& port);
+	static bool isSocketFile(const std::string& path);
+	static void initPlatform();
+	static void printError(const std::string& message);
+};
@@ -0,0 +1,154 @@
+#include "numaTopology.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+NumaTopology NumaTopology::detect()
+{
+	NumaTopology topology{};
+#ifdef _WIN32
+	ULONG highestNode = 0;
+	if (GetNumaHighestNodeNumber(&highestNode))
+	{
+		for (ULONG node = 0; node <= highestNode; ++node)
+		{
+			ULONGLONG mask = 0;
+			if (!GetNumaNodeProcessorMask(static_cast<UCHAR>(node), &mask) || mask == 0)
+			{
+				continue;
+			}
+			std::vector<int> cpus{};
+			for (int cpu = 0; cpu < 64; ++cpu)
+			{
+				if ((mask >> cpu) & 1)
+				{
+					cpus.push_back(cpu);
+				}
+			}
+			topology.m_nodeCpus.push_back(std::move(cpus));
+		}
+	}
+#else
+	std::vector<std::pair<int, std::filesystem::path>> nodePaths{};
+	std::error_code error{};
+	for (const std::filesystem::directory_entry& entry :
+		std::filesystem::directory_iterator{"/sys/devices/system/node", error})
+	{
+		std::string name = entry.path().filename().string();
+		if (name.size() > 4 && name.starts_with("node") &&
+			std::all_of(name.begin() + 4, name.end(), [] (char c) { return c >= '0' && c <= '9'; }))
+		{
+			nodePaths.emplace_back(std::stoi(name.substr(4)), entry.path());
+		}
+	}
+	std::sort(nodePaths.begin(), nodePaths.end());
+	for (const auto& [node, path] : nodePaths)
+	{
+		std::ifstream file{path / "cpulist"};
+		std::string cpuList{};
+		std::getline(file, cpuList);
+		std::vector<int> cpus = parseCpuList(cpuList);
+		if (!cpus.empty())
+		{
+			topology.m_nodeCpus.push_back(std::move(cpus));
+		}
+	}
+#endif
+
+	if (topology.m_nodeCpus.empty())
+	{
+		std::vector<int> cpus(std::max(static_cast<int>(std::thread::hardware_concurrency()), 1));
+		for (int cpu = 0; cpu < static_cast<int>(cpus.size()); ++cpu)
+		{
+			cpus[cpu] = cpu;
+		}
+		topology.m_nodeCpus.push_back(std::move(cpus));
+	}
+	return topology;
+}
+
+int NumaTopology::getNodeCount() const
+{
+	return static_cast<int>(m_nodeCpus.size());
+}
+
+const std::vector<int>& NumaTopology::getNodeCpus(int node) const
+{
+	return m_nodeCpus[node];
+}
+
+int NumaTopology::getThreadNode(int threadIndex, int threadCount) const
+{
+	return static_cast<int>(static_cast<std::int64_t>(threadIndex) * getNodeCount() /
+		std::max(threadCount, 1));
+}
+
+bool NumaTopology::pinThread(std::thread::native_handle_type thread, int node) const
+{
+#ifdef _WIN32
+	DWORD_PTR mask = 0;
+	for (int cpu : m_nodeCpus[node])
+	{
+		if (cpu < static_cast<int>(8 * sizeof(DWORD_PTR)))
+		{
+			mask |= static_cast<DWORD_PTR>(1) << cpu;
+		}
+	}
+	return mask != 0 && SetThreadAffinityMask(static_cast<HANDLE>(thread), mask) != 0;
+#else
+	cpu_set_t cpuSet{};
+	CPU_ZERO(&cpuSet);
+	for (int cpu : m_nodeCpus[node])
+	{
+		if (cpu < CPU_SETSIZE)
+		{
+			CPU_SET(cpu, &cpuSet);
+		}
+	}
+	return pthread_setaffinity_np(thread, sizeof(cpuSet), &cpuSet) == 0;
+#endif
+}
+
+std::thread::native_handle_type NumaTopology::getCurrentThread()
+{
+#ifdef _WIN32
+	return GetCurrentThread();
+#else
+	return pthread_self();
+#endif
+}
+
+std::vector<int> NumaTopology::parseCpuList(const std::string& cpuList)
+{
+	std::vector<int> cpus{};
+	std::istringstream stream{cpuList};
+	std::string range{};
+	while (std::getline(stream, range, ','))
+	{
+		std::size_t dash = range.find('-');
+		try
+		{
+			int first = std::stoi(range.substr(0, dash));
+			int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+			for (int cpu = first; cpu <= last; ++cpu)
+			{
+				cpus.push_back(cpu);
+			}
+		}
+		catch (const std::exception&)
+		{
+			return {};
+		}
+	}
+	return cpus;
+}
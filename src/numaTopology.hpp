@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+#include <thread>
+#include <vector>
+
+class NumaTopology
+{
+public:
+	static NumaTopology detect();
+
+	int getNodeCount() const;
+	const std::vector<int>& getNodeCpus(int node) const;
+	int getThreadNode(int threadIndex, int threadCount) const;
+	bool pinThread(std::thread::native_handle_type thread, int node) const;
+
+	static std::thread::native_handle_type getCurrentThread();
+
+private:
+	std::vector<std::vector<int>> m_nodeCpus{};
+
+	static std::vector<int> parseCpuList(const std::string& cpuList);
+};
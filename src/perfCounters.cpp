@@ -0,0 +1,158 @@
+#include "perfCounters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+
+#ifdef __linux__
+constexpr std::array<std::uint64_t, PerfCounters::eventCount> eventConfigs{
+	PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+	PERF_COUNT_HW_BRANCH_MISSES};
+
+static int openEvent(std::uint64_t config, int groupFd)
+{
+	perf_event_attr attributes{};
+	attributes.size = sizeof(attributes);
+	attributes.type = PERF_TYPE_HARDWARE;
+	attributes.config = config;
+	attributes.disabled = groupFd == -1 ? 1 : 0;
+	attributes.exclude_kernel = 1;
+	attributes.exclude_hv = 1;
+	attributes.read_format =
+		PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, groupFd, 0));
+}
+#endif
+
+void PerfCounters::Sample::add(const Sample& sample)
+{
+	if (sample.count == 0)
+	{
+		return;
+	}
+
+	for (int event = 0; event < eventCount; ++event)
+	{
+		values[event] += sample.values[event];
+	}
+	eventMask = count == 0 ? sample.eventMask : eventMask & sample.eventMask;
+	count += sample.count;
+}
+
+bool PerfCounters::Sample::hasEvent(Event event) const
+{
+	return count > 0 && ((eventMask >> static_cast<int>(event)) & 1) != 0;
+}
+
+std::uint64_t PerfCounters::Sample::get(Event event) const
+{
+	return values[static_cast<int>(event)];
+}
+
+double PerfCounters::Sample::getInstructionsPerCycle() const
+{
+	if (!hasEvent(Event::cycles) || !hasEvent(Event::instructions) || get(Event::cycles) == 0)
+	{
+		return 0;
+	}
+	return static_cast<double>(get(Event::instructions)) / get(Event::cycles);
+}
+
+PerfCounters::PerfCounters()
+{
+	m_fds.fill(-1);
+#ifdef __linux__
+	for (int event = 0; event < eventCount; ++event)
+	{
+		int fd = openEvent(eventConfigs[event], getLeader());
+		if (fd == -1)
+		{
+			if (event == 0)
+			{
+				return;
+			}
+			continue;
+		}
+		m_fds[event] = fd;
+		m_readOrder[m_openCount++] = event;
+		m_eventMask |= 1u << event;
+	}
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+	for (int fd : m_fds)
+	{
+		if (fd != -1)
+		{
+			close(fd);
+		}
+	}
+#endif
+}
+
+bool PerfCounters::isAvailable() const
+{
+	return m_openCount > 0;
+}
+
+void PerfCounters::start()
+{
+#ifdef __linux__
+	if (isAvailable())
+	{
+		ioctl(getLeader(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(getLeader(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+#endif
+}
+
+PerfCounters::Sample PerfCounters::stop()
+{
+	Sample sample{};
+#ifdef __linux__
+	if (!isAvailable())
+	{
+		return sample;
+	}
+
+	ioctl(getLeader(), PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+	std::array<std::uint64_t, 3 + eventCount> buffer{};
+	ssize_t size = read(getLeader(), buffer.data(), sizeof(buffer));
+	if (size < static_cast<ssize_t>(3 * sizeof(std::uint64_t)))
+	{
+		return sample;
+	}
+
+	std::uint64_t timeEnabled = buffer[1];
+	std::uint64_t timeRunning = buffer[2];
+	double scale = timeRunning > 0 && timeRunning < timeEnabled ?
+		static_cast<double>(timeEnabled) / timeRunning : 1.0;
+	int valueCount = std::min(static_cast<int>(buffer[0]), m_openCount);
+	for (int i = 0; i < valueCount; ++i)
+	{
+		sample.values[m_readOrder[i]] = static_cast<std::uint64_t>(buffer[3 + i] * scale);
+	}
+	sample.eventMask = m_eventMask;
+	sample.count = 1;
+#endif
+	return sample;
+}
+
+bool PerfCounters::isSupported()
+{
+	static const bool isSupported = PerfCounters{}.isAvailable();
+	return isSupported;
+}
+
+int PerfCounters::getLeader() const
+{
+	return m_fds[0];
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+class PerfCounters
+{
+public:
+	enum class Event
+	{
+		cycles,
+		instructions,
+		cacheMisses,
+		branchMisses
+	};
+
+	static constexpr int eventCount = 4;
+	static constexpr std::array<const char*, eventCount> eventNames{"cycles", "instructions",
+		"llc-misses", "branch-misses"};
+
+	struct Sample
+	{
+		std::array<std::uint64_t, eventCount> values{};
+		unsigned int eventMask{};
+		int count{};
+
+		void add(const Sample& sample);
+		bool hasEvent(Event event) const;
+		std::uint64_t get(Event event) const;
+		double getInstructionsPerCycle() const;
+	};
+
+	PerfCounters();
+	PerfCounters(const PerfCounters&) = delete;
+	~PerfCounters();
+
+	PerfCounters& operator=(const PerfCounters&) = delete;
+
+	bool isAvailable() const;
+	void start();
+	Sample stop();
+
+	static bool isSupported();
+
+private:
+	std::array<int, eventCount> m_fds{};
+	std::array<int, eventCount> m_readOrder{};
+	int m_openCount{};
+	unsigned int m_eventMask{};
+
+	int getLeader() const;
+};
@@ -0,0 +1,134 @@
+#include "pngEncoder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace PngEncoder
+{
+	constexpr int numOfChannels = 3;
+	constexpr std::size_t maxStoredBlockSize = 65535;
+	constexpr std::array<unsigned char, 8> signature{0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+	constexpr std::array<unsigned char, 2> zlibHeader{0x78, 0x01};
+
+	std::vector<unsigned char> encode(const unsigned char* rgb, const glm::ivec2& size)
+	{
+		std::size_t rowSize = static_cast<std::size_t>(size.x) * numOfChannels;
+		std::vector<unsigned char> scanlines{};
+		scanlines.reserve((rowSize + 1) * size.y);
+		for (int y = size.y - 1; y >= 0; --y)
+		{
+			scanlines.push_back(0);
+			const unsigned char* row = rgb + y * rowSize;
+			scanlines.insert(scanlines.end(), row, row + rowSize);
+		}
+
+		std::vector<unsigned char> stream(zlibHeader.begin(), zlibHeader.end());
+		appendStoredBlocks(stream, scanlines.data(), scanlines.size(), true);
+		appendUint32(stream, adler32(scanlines.data(), scanlines.size()));
+
+		std::vector<unsigned char> png = encodeHeader(size);
+		appendChunk(png, "IDAT", stream);
+		appendChunk(png, "IEND", {});
+		return png;
+	}
+
+	std::vector<unsigned char> encodeHeader(const glm::ivec2& size)
+	{
+		std::vector<unsigned char> header{};
+		appendUint32(header, static_cast<std::uint32_t>(size.x));
+		appendUint32(header, static_cast<std::uint32_t>(size.y));
+		header.insert(header.end(), {8, 2, 0, 0, 0});
+
+		std::vector<unsigned char> png(signature.begin(), signature.end());
+		appendChunk(png, "IHDR", header);
+		return png;
+	}
+
+	void appendChunk(std::vector<unsigned char>& png, const std::string& type,
+		const std::vector<unsigned char>& data)
+	{
+		appendUint32(png, static_cast<std::uint32_t>(data.size()));
+		std::size_t typeStart = png.size();
+		png.insert(png.end(), type.begin(), type.end());
+		png.insert(png.end(), data.begin(), data.end());
+		appendUint32(png, crc32(png.data() + typeStart, png.size() - typeStart));
+	}
+
+	void appendStoredBlocks(std::vector<unsigned char>& stream, const unsigned char* data,
+		std::size_t size, bool isFinal)
+	{
+		std::size_t offset = 0;
+		do
+		{
+			std::size_t blockSize = std::min(size - offset, maxStoredBlockSize);
+			bool isLastBlock = isFinal && offset + blockSize == size;
+			stream.push_back(isLastBlock ? 1 : 0);
+			stream.push_back(static_cast<unsigned char>(blockSize));
+			stream.push_back(static_cast<unsigned char>(blockSize >> 8));
+			stream.push_back(static_cast<unsigned char>(~blockSize));
+			stream.push_back(static_cast<unsigned char>(~blockSize >> 8));
+			stream.insert(stream.end(), data + offset, data + offset + blockSize);
+			offset += blockSize;
+		}
+		while (offset < size);
+	}
+
+	void appendUint32(std::vector<unsigned char>& bytes, std::uint32_t value)
+	{
+		bytes.push_back(static_cast<unsigned char>(value >> 24));
+		bytes.push_back(static_cast<unsigned char>(value >> 16));
+		bytes.push_back(static_cast<unsigned char>(value >> 8));
+		bytes.push_back(static_cast<unsigned char>(value));
+	}
+
+	std::uint32_t crc32(const unsigned char* data, std::size_t size, std::uint32_t crc)
+	{
+		static const std::array<std::uint32_t, 256> table = [] ()
+			{
+				std::array<std::uint32_t, 256> table{};
+				for (std::uint32_t i = 0; i < table.size(); ++i)
+				{
+					std::uint32_t value = i;
+					for (int bit = 0; bit < 8; ++bit)
+					{
+						value = (value & 1) ? 0xedb88320u ^ (value >> 1) : value >> 1;
+					}
+					table[i] = value;
+				}
+				return table;
+			}();
+
+		crc = ~crc;
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+		}
+		return ~crc;
+	}
+
+	std::uint32_t adler32(const unsigned char* data, std::size_t size, std::uint32_t adler)
+	{
+		static constexpr std::uint32_t modulus = 65521;
+		static constexpr std::size_t maxRunLength = 5552;
+
+		std::uint32_t a = adler & 0xffff;
+		std::uint32_t b = adler >> 16;
+		while (size > 0)
+		{
+			std::size_t runLength = std::min(size, maxRunLength);
+			for (std::size_t i = 0; i < runLength; ++i)
+			{
+				a += data[i];
+				b += a;
+			}
+			a %= modulus;
+			b %= modulus;
+			data += runLength;
+			size -= runLength;
+		}
+		return (b << 16) | a;
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace PngEncoder
+{
+	std::vector<unsigned char> encode(const unsigned char* rgb, const glm::ivec2& size);
+
+	std::vector<unsigned char> encodeHeader(const glm::ivec2& size);
+	void appendChunk(std::vector<unsigned char>& png, const std::string& type,
+		const std::vector<unsigned char>& data);
+	void appendStoredBlocks(std::vector<unsigned char>& stream, const unsigned char* data,
+		std::size_t size, bool isFinal);
+	void appendUint32(std::vector<unsigned char>& bytes, std::uint32_t value);
+
+	std::uint32_t crc32(const unsigned char* data, std::size_t size, std::uint32_t crc = 0);
+	std::uint32_t adler32(const unsigned char* data, std::size_t size, std::uint32_t adler = 1);
+}
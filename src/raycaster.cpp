@@ -0,0 +1,212 @@
+#include "raycaster.hpp"
+
+#include <cmath>
+
+Raycaster::Raycaster(const Camera& camera, const Ellipsoid& ellipsoid, const LightList* lights) :
+	m_viewVector{glm::normalize(camera.getPos())},
+	m_cameraMatrix{camera.getMatrixInverse()},
+	m_cameraEllipsoidMatrix{glm::transpose(m_cameraMatrix) * ellipsoid.getMatrix() *
+		m_cameraMatrix},
+	m_quadraticForm{QuadraticForm<float>::create(m_cameraEllipsoidMatrix)},
+	m_quadraticFormFp64{QuadraticForm<double>::create(glm::transpose(glm::dmat4{m_cameraMatrix}) *
+		glm::dmat4{ellipsoid.getMatrix()} * glm::dmat4{m_cameraMatrix})},
+	m_ellipsoid{ellipsoid},
+	m_material{ellipsoid.getMaterial()},
+	m_lights{lights != nullptr && !lights->isEmpty() ? lights : nullptr}
+{ }
+
+std::optional<glm::ivec3> Raycaster::calcColor(float x, float y) const
+{
+	if (hasLights())
+	{
+		return calcColor(x, y, m_lights->getIndices());
+	}
+
+	std::optional<glm::vec3> normalVector = calcNormal(x, y);
+	if (!normalVector.has_value())
+	{
+		return std::nullopt;
+	}
+
+	return calcPhong(calcShadingTerms(*normalVector), m_material);
+}
+
+std::optional<glm::ivec3> Raycaster::calcColor(float x, float y,
+	std::span<const std::uint16_t> lightIndices) const
+{
+	std::optional<glm::vec3> point = calcPoint(x, y);
+	if (!point.has_value())
+	{
+		return std::nullopt;
+	}
+
+	return calcLighting(*point, m_ellipsoid.getNormalVector(*point), lightIndices);
+}
+
+std::optional<glm::vec3> Raycaster::calcNormal(float x, float y) const
+{
+	std::optional<glm::vec3> point = calcPoint(x, y);
+	if (!point.has_value())
+	{
+		return std::nullopt;
+	}
+
+	return m_ellipsoid.getNormalVector(*point);
+}
+
+std::optional<float> Raycaster::calcIntersection(float x, float y) const
+{
+	if (m_precision != Precision::fp64)
+	{
+		QuadraticCoefs<float> coefs = m_quadraticForm.evaluate(x, y);
+		if (m_precision == Precision::fp32 || !isIllConditioned(coefs))
+		{
+			return coefs.solve();
+		}
+	}
+
+	std::optional<double> z = m_quadraticFormFp64.evaluate(x, y).solve();
+	if (!z.has_value())
+	{
+		return std::nullopt;
+	}
+
+	return static_cast<float>(*z);
+}
+
+bool Raycaster::isIllConditioned(float x, float y) const
+{
+	return isIllConditioned(m_quadraticForm.evaluate(x, y));
+}
+
+float Raycaster::calcDelta(float x, float y) const
+{
+	return m_quadraticForm.evaluate(x, y).calcDelta();
+}
+
+float Raycaster::calcChordMidpoint(float x, float y) const
+{
+	QuadraticCoefs<float> coefs = m_quadraticForm.evaluate(x, y);
+	return -coefs.b / (2 * coefs.a);
+}
+
+Raycaster::ShadingTerms Raycaster::calcShadingTerms(const glm::vec3& normalVector) const
+{
+	glm::vec3 lightVector = m_viewVector;
+
+	ShadingTerms shadingTerms{};
+	shadingTerms.lightNormalCos = glm::dot(lightVector, normalVector);
+
+	glm::vec3 reflectionVector =
+		2 * glm::dot(lightVector, normalVector) * normalVector - lightVector;
+	shadingTerms.reflectionViewCos = glm::dot(reflectionVector, m_viewVector);
+	return shadingTerms;
+}
+
+glm::ivec3 Raycaster::calcPhong(const ShadingTerms& shadingTerms, const Material& material)
+{
+	float ambient = material.ambientCoef;
+
+	float diffuse = shadingTerms.lightNormalCos > 0 ?
+		material.diffuseCoef * shadingTerms.lightNormalCos : 0;
+
+	float specular = shadingTerms.reflectionViewCos > 0 ?
+		material.specularCoef * std::pow(shadingTerms.reflectionViewCos, material.shininess) :
+		0;
+
+	glm::vec3 color = (ambient + diffuse + specular) * glm::vec3{material.color};
+	return glm::ivec3{glm::clamp(color, 0.0f, 255.0f)};
+}
+
+glm::ivec3 Raycaster::calcLighting(const glm::vec3& point, const glm::vec3& normalVector,
+	std::span<const std::uint16_t> lightIndices) const
+{
+	const LightList::Components& lights = m_lights->getComponents();
+	glm::vec3 intensity{m_material.ambientCoef};
+	for (std::uint16_t light : lightIndices)
+	{
+		glm::vec3 lightVector = glm::vec3{lights.x[light], lights.y[light], lights.z[light]} -
+			lights.w[light] * point;
+		float distanceSquared = glm::dot(lightVector, lightVector);
+		float falloff = 1 - distanceSquared * lights.invRangeSquared[light];
+		if (falloff <= 0)
+		{
+			continue;
+		}
+
+		lightVector /= std::sqrt(distanceSquared);
+		float lightNormalCos = glm::dot(lightVector, normalVector);
+		if (lightNormalCos <= 0)
+		{
+			continue;
+		}
+
+		glm::vec3 reflectionVector = 2 * lightNormalCos * normalVector - lightVector;
+		float reflectionViewCos = glm::dot(reflectionVector, m_viewVector);
+		float diffuse = m_material.diffuseCoef * lightNormalCos;
+		float specular = reflectionViewCos > 0 ?
+			m_material.specularCoef * std::pow(reflectionViewCos, m_material.shininess) : 0;
+		intensity += (diffuse + specular) * falloff * falloff *
+			glm::vec3{lights.red[light], lights.green[light], lights.blue[light]};
+	}
+
+	glm::vec3 color = intensity * glm::vec3{m_material.color};
+	return glm::ivec3{glm::clamp(color, 0.0f, 255.0f)};
+}
+
+const glm::vec3& Raycaster::getViewVector() const
+{
+	return m_viewVector;
+}
+
+const glm::mat4& Raycaster::getCameraMatrix() const
+{
+	return m_cameraMatrix;
+}
+
+const glm::mat4& Raycaster::getCameraEllipsoidMatrix() const
+{
+	return m_cameraEllipsoidMatrix;
+}
+
+const Ellipsoid& Raycaster::getEllipsoid() const
+{
+	return m_ellipsoid;
+}
+
+bool Raycaster::hasLights() const
+{
+	return m_lights != nullptr;
+}
+
+const LightList& Raycaster::getLights() const
+{
+	return *m_lights;
+}
+
+Raycaster::Precision Raycaster::getPrecision() const
+{
+	return m_precision;
+}
+
+void Raycaster::setPrecision(Precision precision)
+{
+	m_precision = precision;
+}
+
+std::optional<glm::vec3> Raycaster::calcPoint(float x, float y) const
+{
+	std::optional<float> z = calcIntersection(x, y);
+	if (!z.has_value())
+	{
+		return std::nullopt;
+	}
+
+	return glm::vec3{m_cameraMatrix * glm::vec4{x, y, *z, 1}};
+}
+
+bool Raycaster::isIllConditioned(const QuadraticCoefs<float>& coefs)
+{
+	float magnitude = coefs.b * coefs.b + 4 * std::abs(coefs.a * coefs.c);
+	return std::abs(coefs.calcDelta()) * maxConditionNumber < magnitude;
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "camera.hpp"
+#include "ellipsoid.hpp"
+#include "lightList.hpp"
+#include "material.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+class Raycaster
+{
+public:
+	enum class Precision
+	{
+		fp32,
+		adaptive,
+		fp64
+	};
+
+	struct ShadingTerms
+	{
+		float lightNormalCos{};
+		float reflectionViewCos{};
+	};
+
+	static constexpr float maxConditionNumber = 1e4f;
+
+	Raycaster(const Camera& camera, const Ellipsoid& ellipsoid,
+		const LightList* lights = nullptr);
+
+	std::optional<glm::ivec3> calcColor(float x, float y) const;
+	std::optional<glm::ivec3> calcColor(float x, float y,
+		std::span<const std::uint16_t> lightIndices) const;
+	std::optional<glm::vec3> calcNormal(float x, float y) const;
+	std::optional<float> calcIntersection(float x, float y) const;
+	bool isIllConditioned(float x, float y) const;
+	float calcDelta(float x, float y) const;
+	float calcChordMidpoint(float x, float y) const;
+	ShadingTerms calcShadingTerms(const glm::vec3& normalVector) const;
+	static glm::ivec3 calcPhong(const ShadingTerms& shadingTerms, const Material& material);
+	glm::ivec3 calcLighting(const glm::vec3& point, const glm::vec3& normalVector,
+		std::span<const std::uint16_t> lightIndices) const;
+
+	const glm::vec3& getViewVector() const;
+	const glm::mat4& getCameraMatrix() const;
+	const glm::mat4& getCameraEllipsoidMatrix() const;
+	const Ellipsoid& getEllipsoid() const;
+	bool hasLights() const;
+	const LightList& getLights() const;
+	Precision getPrecision() const;
+	void setPrecision(Precision precision);
+
+private:
+	template <typename Scalar>
+	struct QuadraticCoefs
+	{
+		Scalar a{};
+		Scalar b{};
+		Scalar c{};
+
+		Scalar calcDelta() const;
+		std::optional<Scalar> solve() const;
+	};
+
+	template <typename Scalar>
+	struct QuadraticForm
+	{
+		Scalar a{};
+		Scalar bx{};
+		Scalar by{};
+		Scalar b0{};
+		Scalar cxx{};
+		Scalar cxy{};
+		Scalar cyy{};
+		Scalar cx{};
+		Scalar cy{};
+		Scalar c0{};
+
+		template <typename Matrix>
+		static QuadraticForm create(const Matrix& matrix);
+		QuadraticCoefs<Scalar> evaluate(Scalar x, Scalar y) const;
+	};
+
+	glm::vec3 m_viewVector{};
+	glm::mat4 m_cameraMatrix{};
+	glm::mat4 m_cameraEllipsoidMatrix{};
+	QuadraticForm<float> m_quadraticForm{};
+	QuadraticForm<double> m_quadraticFormFp64{};
+	Ellipsoid m_ellipsoid;
+	Material m_material;
+	const LightList* m_lights{};
+	Precision m_precision = Precision::adaptive;
+
+	std::optional<glm::vec3> calcPoint(float x, float y) const;
+	static bool isIllConditioned(const QuadraticCoefs<float>& coefs);
+};
+
+template <typename Scalar>
+Scalar Raycaster::QuadraticCoefs<Scalar>::calcDelta() const
+{
+	return b * b - 4 * a * c;
+}
+
+template <typename Scalar>
+std::optional<Scalar> Raycaster::QuadraticCoefs<Scalar>::solve() const
+{
+	Scalar delta = calcDelta();
+	if (delta <= 0)
+	{
+		return std::nullopt;
+	}
+
+	Scalar q = b >= 0 ? -(b + std::sqrt(delta)) / 2 : (std::sqrt(delta) - b) / 2;
+	Scalar z = b >= 0 ? q / a : c / q;
+	if (z < -1 || z > 1)
+	{
+		return std::nullopt;
+	}
+
+	return z;
+}
+
+template <typename Scalar>
+template <typename Matrix>
+Raycaster::QuadraticForm<Scalar> Raycaster::QuadraticForm<Scalar>::create(const Matrix& matrix)
+{
+	QuadraticForm form{};
+	form.a = matrix[2][2];
+	form.bx = matrix[2][0] + matrix[0][2];
+	form.by = matrix[2][1] + matrix[1][2];
+	form.b0 = matrix[2][3] + matrix[3][2];
+	form.cxx = matrix[0][0];
+	form.cxy = matrix[0][1] + matrix[1][0];
+	form.cyy = matrix[1][1];
+	form.cx = matrix[0][3] + matrix[3][0];
+	form.cy = matrix[1][3] + matrix[3][1];
+	form.c0 = matrix[3][3];
+	return form;
+}
+
+template <typename Scalar>
+Raycaster::QuadraticCoefs<Scalar> Raycaster::QuadraticForm<Scalar>::evaluate(Scalar x, Scalar y)
+	const
+{
+	QuadraticCoefs<Scalar> coefs{};
+	coefs.a = a;
+	coefs.b = bx * x + by * y + b0;
+	coefs.c = (cxx * x + cxy * y + cx) * x + (cyy * y + cy) * y + c0;
+	return coefs;
+}
@@ -0,0 +1,38 @@
+#include "renderSettings.hpp"
+
+void RenderSettings::apply(Camera& camera, Ellipsoid& ellipsoid) const
+{
+	camera.updateViewportSize();
+	camera.setState(this->camera);
+	ellipsoid.setA(radii.x);
+	ellipsoid.setB(radii.y);
+	ellipsoid.setC(radii.z);
+	ellipsoid.setMaterial(material);
+}
+
+RenderSettings RenderSettings::fromCommandLine(const CommandLine& commandLine)
+{
+	RenderSettings settings{};
+	settings.resolution.x = commandLine.getInt("width", settings.resolution.x);
+	settings.resolution.y = commandLine.getInt("height", settings.resolution.y);
+	settings.camera.targetPos.x = commandLine.getFloat("target-x", settings.camera.targetPos.x);
+	settings.camera.targetPos.y = commandLine.getFloat("target-y", settings.camera.targetPos.y);
+	settings.camera.targetPos.z = commandLine.getFloat("target-z", settings.camera.targetPos.z);
+	settings.camera.pitchRad = commandLine.getFloat("pitch", settings.camera.pitchRad);
+	settings.camera.yawRad = commandLine.getFloat("yaw", settings.camera.yawRad);
+	settings.camera.viewWidth = commandLine.getFloat("view-width", settings.camera.viewWidth);
+	settings.radii.x = commandLine.getFloat("a", settings.radii.x);
+	settings.radii.y = commandLine.getFloat("b", settings.radii.y);
+	settings.radii.z = commandLine.getFloat("c", settings.radii.z);
+	settings.material.color.r = commandLine.getInt("red", settings.material.color.r);
+	settings.material.color.g = commandLine.getInt("green", settings.material.color.g);
+	settings.material.color.b = commandLine.getInt("blue", settings.material.color.b);
+	settings.material.ambientCoef = commandLine.getFloat("ambient", settings.material.ambientCoef);
+	settings.material.diffuseCoef = commandLine.getFloat("diffuse", settings.material.diffuseCoef);
+	settings.material.specularCoef =
+		commandLine.getFloat("specular", settings.material.specularCoef);
+	settings.material.shininess = commandLine.getFloat("shininess", settings.material.shininess);
+	settings.antialiasingSamples =
+		commandLine.getInt("antialiasing", settings.antialiasingSamples);
+	return settings;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "camera.hpp"
+#include "commandLine.hpp"
+#include "ellipsoid.hpp"
+#include "material.hpp"
+
+#include <glm/glm.hpp>
+
+struct RenderSettings
+{
+	glm::ivec2 resolution{1280, 720};
+	CameraState camera{};
+	glm::vec3 radii{4.0f, 2.0f, 8.0f};
+	Material material{{255, 255, 0}, 0.1f, 0.5f, 0.9f, 20};
+	int antialiasingSamples = 1;
+
+	void apply(Camera& camera, Ellipsoid& ellipsoid) const;
+
+	bool operator==(const RenderSettings& settings) const = default;
+
+	static RenderSettings fromCommandLine(const CommandLine& commandLine);
+};
@@ -0,0 +1,715 @@
+#include "renderer.hpp"
+
+#include "sampleOrder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+constexpr int edgeColorThreshold = 24;
+constexpr int edgePixelBatchSize = 64;
+constexpr int edgeScanRowCount = 16;
+constexpr int edgeSegmentWidth = Renderer::minTileSize;
+constexpr unsigned char edgeSegmentHitFlag = 1;
+constexpr unsigned char edgeSegmentMissFlag = 2;
+constexpr std::array<glm::ivec2, 4> neighborOffsets{{{-1, 0}, {1, 0}, {0, -1}, {0, 1}}};
+
+Renderer::Renderer(const glm::ivec2& viewportSize) :
+	m_viewportSize{viewportSize},
+	m_cpuTexture(numOfChannels * viewportSize.x * viewportSize.y),
+	m_hitMask(viewportSize.x * viewportSize.y)
+{ }
+
+void Renderer::updateViewportSize()
+{
+	std::size_t pixelCount = static_cast<std::size_t>(m_viewportSize.x) * m_viewportSize.y;
+	if (pixelCount > m_hitMask.capacity())
+	{
+		m_cpuTexture.clear();
+		m_hitMask.clear();
+	}
+	m_cpuTexture.resize(pixelCount * numOfChannels);
+	m_hitMask.resize(pixelCount);
+	m_isTouchPending = true;
+	m_areEdgeSegmentsValid = false;
+}
+
+void Renderer::reserve(const glm::ivec2& maxViewportSize)
+{
+	std::size_t pixelCount = static_cast<std::size_t>(maxViewportSize.x) * maxViewportSize.y;
+	if (pixelCount > m_hitMask.capacity())
+	{
+		m_cpuTexture.clear();
+		m_hitMask.clear();
+		m_isTouchPending = true;
+	}
+	m_cpuTexture.reserve(pixelCount * numOfChannels);
+	m_hitMask.reserve(pixelCount);
+}
+
+void Renderer::setImageRegion(const glm::ivec2& imageSize, const glm::ivec2& regionOffset)
+{
+	m_imageSize = imageSize;
+	m_regionOffset = regionOffset;
+}
+
+std::span<const unsigned char> Renderer::getCpuTexture() const
+{
+	return m_cpuTexture;
+}
+
+std::span<const unsigned char> Renderer::getHitMask() const
+{
+	return m_hitMask;
+}
+
+void Renderer::load(std::span<const unsigned char> cpuTexture,
+	std::span<const unsigned char> hitMask, ThreadPool& threadPool)
+{
+	touchPages(threadPool);
+	std::copy_n(cpuTexture.begin(), std::min(cpuTexture.size(), m_cpuTexture.size()),
+		m_cpuTexture.begin());
+	std::copy_n(hitMask.begin(), std::min(hitMask.size(), m_hitMask.size()), m_hitMask.begin());
+	m_areEdgeSegmentsValid = false;
+}
+
+Renderer::Traversal Renderer::getTraversal() const
+{
+	return m_traversal;
+}
+
+void Renderer::setTraversal(Traversal traversal)
+{
+	m_traversal = traversal;
+}
+
+int Renderer::getTileSize() const
+{
+	return m_tileSize;
+}
+
+void Renderer::setTileSize(int tileSize)
+{
+	m_tileSize = static_cast<int>(std::bit_ceil(static_cast<unsigned int>(
+		std::clamp(tileSize, minTileSize, maxTileSize))));
+}
+
+bool Renderer::isTileSizeValid(int tileSize)
+{
+	return tileSize >= minTileSize && tileSize <= maxTileSize &&
+		std::has_single_bit(static_cast<unsigned int>(tileSize));
+}
+
+bool Renderer::isLightCullingEnabled() const
+{
+	return m_isLightCullingEnabled;
+}
+
+void Renderer::setLightCullingEnabled(bool isLightCullingEnabled)
+{
+	m_isLightCullingEnabled = isLightCullingEnabled;
+}
+
+float Renderer::getMeanTileLightCount() const
+{
+	return m_lightCulling.getMeanTileLightCount();
+}
+
+void Renderer::touchPages(ThreadPool& threadPool)
+{
+	if (!m_isTouchPending)
+	{
+		return;
+	}
+
+	m_isTouchPending = false;
+	std::size_t rowSize = static_cast<std::size_t>(m_viewportSize.x);
+	auto touchRow = [this, rowSize] (int y)
+	{
+		std::memset(m_cpuTexture.data() + y * rowSize * numOfChannels, 0,
+			rowSize * numOfChannels);
+		std::memset(m_hitMask.data() + y * rowSize, 0, rowSize);
+	};
+	if (PageAllocator::isFirstTouchDistributed())
+	{
+		threadPool.parallelFor(m_viewportSize.y, touchRow);
+		return;
+	}
+	for (int y = 0; y < m_viewportSize.y; ++y)
+	{
+		touchRow(y);
+	}
+}
+
+void Renderer::resetEdgeSegments()
+{
+	m_edgeSegmentColumnCount = (m_viewportSize.x + edgeSegmentWidth - 1) / edgeSegmentWidth;
+	m_edgeSegments.assign(static_cast<std::size_t>(m_edgeSegmentColumnCount) * m_viewportSize.y,
+		EdgeSegment{});
+	m_areEdgeSegmentsValid = true;
+}
+
+void Renderer::drawPass(const Raycaster& raycaster, int pixelSize, bool isFirstPass,
+	ThreadPool& threadPool)
+{
+	touchPages(threadPool);
+	if (isFirstPass)
+	{
+		resetEdgeSegments();
+	}
+	cullLights(raycaster, pixelSize, threadPool);
+	if (m_traversal == Traversal::rowMajor)
+	{
+		threadPool.parallelFor(getRowCount(pixelSize),
+			[this, &raycaster, pixelSize, isFirstPass] (int row)
+			{
+				drawRows(raycaster, pixelSize, isFirstPass, row, row + 1);
+			}
+		);
+		return;
+	}
+
+	const int halfPixelSize = pixelSize / 2;
+	const int tileSize = std::max(m_tileSize, 2 * pixelSize);
+	const int tileRowCount = tileSize / pixelSize;
+	const int rowCount = getRowCount(pixelSize);
+	updateTileOrder({(m_viewportSize.x + halfPixelSize + tileSize - 1) / tileSize,
+		(rowCount + tileRowCount - 1) / tileRowCount});
+	threadPool.parallelFor(static_cast<int>(m_tileOrder.size()),
+		[this, &raycaster, pixelSize, isFirstPass, tileSize, tileRowCount, rowCount] (int index)
+		{
+			const glm::ivec2& tile = m_tileOrder[index];
+			drawRegion(raycaster, pixelSize, isFirstPass, tile.y * tileRowCount,
+				std::min((tile.y + 1) * tileRowCount, rowCount), tile.x * tileSize,
+				(tile.x + 1) * tileSize);
+		}
+	);
+}
+
+int Renderer::getRowCount(int pixelSize) const
+{
+	const int halfPixelSize = pixelSize / 2;
+	return (m_viewportSize.y + halfPixelSize + pixelSize - 1) / pixelSize;
+}
+
+void Renderer::drawRows(const Raycaster& raycaster, int pixelSize, bool isFirstPass,
+	int startRow, int endRow)
+{
+	drawRegion(raycaster, pixelSize, isFirstPass, startRow, endRow, 0,
+		m_viewportSize.x + pixelSize / 2);
+}
+
+void Renderer::drawRegion(const Raycaster& raycaster, int pixelSize, bool isFirstPass,
+	int startRow, int endRow, int startX, int endX)
+{
+	const int halfPixelSize = pixelSize / 2;
+	endX = std::min(endX, m_viewportSize.x + halfPixelSize);
+	for (int row = startRow; row < endRow; ++row)
+	{
+		int centerY = row * pixelSize;
+		bool isRowIndexEven = row % 2 == 0;
+
+		int start{};
+		int increment{};
+		if (!isFirstPass && isRowIndexEven)
+		{
+			start = pixelSize;
+			increment = 2 * pixelSize;
+		}
+		else
+		{
+			start = 0;
+			increment = pixelSize;
+		}
+
+		for (int centerX = startX + start; centerX < endX; centerX += increment)
+		{
+			glm::vec2 ndc = toNDC(static_cast<float>(centerX), static_cast<float>(centerY));
+			std::optional<glm::ivec3> color = calcColor(raycaster, centerX, centerY, ndc);
+			glm::ivec3 pixelColor = color.value_or(backgroundColor);
+			unsigned char isHit = color.has_value() ? 1 : 0;
+
+			glm::ivec2 blockStart = glm::max(glm::ivec2{centerX, centerY} - halfPixelSize,
+				glm::ivec2{0, 0});
+			glm::ivec2 blockEnd = glm::min(glm::ivec2{centerX, centerY} +
+				(halfPixelSize != 0 ? halfPixelSize : 1), m_viewportSize);
+			fillBlock(blockStart, blockEnd, pixelColor, isHit);
+			recordEdgeSample(centerX, centerY, pixelColor, isHit);
+		}
+	}
+}
+
+void Renderer::recordEdgeSample(int x, int y, const glm::ivec3& color, unsigned char isHit)
+{
+	if (!m_areEdgeSegmentsValid || !isInViewport(x, y))
+	{
+		return;
+	}
+
+	EdgeSegment& segment = m_edgeSegments[static_cast<std::size_t>(y) * m_edgeSegmentColumnCount +
+		x / edgeSegmentWidth];
+	for (int channel = 0; channel < numOfChannels; ++channel)
+	{
+		unsigned char value = static_cast<unsigned char>(color[channel]);
+		segment.minColor[channel] = segment.hitFlags == 0 ? value :
+			std::min(segment.minColor[channel], value);
+		segment.maxColor[channel] = segment.hitFlags == 0 ? value :
+			std::max(segment.maxColor[channel], value);
+	}
+	segment.hitFlags |= isHit ? edgeSegmentHitFlag : edgeSegmentMissFlag;
+}
+
+void Renderer::fillBlock(const glm::ivec2& start, const glm::ivec2& end, const glm::ivec3& color,
+	unsigned char isHit)
+{
+	std::size_t width = static_cast<std::size_t>(end.x - start.x);
+	std::size_t firstPixel = static_cast<std::size_t>(start.y) * m_viewportSize.x + start.x;
+	unsigned char* firstRow = m_cpuTexture.data() + firstPixel * numOfChannels;
+	for (std::size_t x = 0; x < width; ++x)
+	{
+		for (int channel = 0; channel < numOfChannels; ++channel)
+		{
+			firstRow[x * numOfChannels + channel] = static_cast<unsigned char>(color[channel]);
+		}
+	}
+	std::memset(m_hitMask.data() + firstPixel, isHit, width);
+
+	for (int y = start.y + 1; y < end.y; ++y)
+	{
+		std::size_t pixel = static_cast<std::size_t>(y) * m_viewportSize.x + start.x;
+		std::memcpy(m_cpuTexture.data() + pixel * numOfChannels, firstRow, width * numOfChannels);
+		std::memset(m_hitMask.data() + pixel, isHit, width);
+	}
+}
+
+void Renderer::updateTileOrder(const glm::ivec2& tileCount)
+{
+	if (tileCount == m_tileOrderCount)
+	{
+		return;
+	}
+
+	m_tileOrderCount = tileCount;
+	m_tileOrder.clear();
+	for (int y = 0; y < tileCount.y; ++y)
+	{
+		for (int x = 0; x < tileCount.x; ++x)
+		{
+			m_tileOrder.push_back({x, y});
+		}
+	}
+	std::sort(m_tileOrder.begin(), m_tileOrder.end(),
+		[] (const glm::ivec2& left, const glm::ivec2& right)
+		{
+			return calcMortonCode(left) < calcMortonCode(right);
+		}
+	);
+}
+
+std::uint32_t Renderer::calcMortonCode(const glm::ivec2& tile)
+{
+	std::uint32_t code = 0;
+	for (int bit = 0; bit < 16; ++bit)
+	{
+		code |= ((static_cast<std::uint32_t>(tile.x) >> bit) & 1u) << (2 * bit);
+		code |= ((static_cast<std::uint32_t>(tile.y) >> bit) & 1u) << (2 * bit + 1);
+	}
+	return code;
+}
+
+int Renderer::drawSamples(const Raycaster& raycaster, int startRank, int endRank,
+	ThreadPool& threadPool)
+{
+	const SampleOrder::BlueNoise& blueNoise = SampleOrder::getBlueNoise();
+	glm::ivec2 tileCount = (m_viewportSize + SampleOrder::tileSize - 1) / SampleOrder::tileSize;
+	touchPages(threadPool);
+	cullLights(raycaster, 1, threadPool);
+	m_areEdgeSegmentsValid = false;
+	if (startRank == 0)
+	{
+		std::size_t rowSize = static_cast<std::size_t>(m_viewportSize.x);
+		m_splatDistances.clear();
+		m_splatDistances.resize(rowSize * m_viewportSize.y);
+		threadPool.parallelFor(m_viewportSize.y,
+			[this, rowSize] (int y)
+			{
+				std::fill_n(m_splatDistances.begin() + y * rowSize, rowSize,
+					std::numeric_limits<std::uint16_t>::max());
+			}
+		);
+	}
+
+	std::atomic<int> rayCount = 0;
+	threadPool.parallelFor(tileCount.y,
+		[this, &raycaster, &blueNoise, &rayCount, tileCount, startRank, endRank] (int tileRow)
+		{
+			int tileRayCount = 0;
+			for (int tileColumn = 0; tileColumn < tileCount.x; ++tileColumn)
+			{
+				glm::ivec2 tileOffset = glm::ivec2{tileColumn, tileRow} * SampleOrder::tileSize;
+				for (int rank = startRank; rank < endRank; ++rank)
+				{
+					glm::ivec2 pos = tileOffset + blueNoise.positions[rank];
+					if (!isInViewport(pos.x, pos.y))
+					{
+						continue;
+					}
+
+					glm::vec2 ndc = toNDC(static_cast<float>(pos.x), static_cast<float>(pos.y));
+					std::optional<glm::ivec3> color = calcColor(raycaster, pos.x, pos.y, ndc);
+					setPixel(pos.x, pos.y, color.value_or(backgroundColor));
+					m_hitMask[pos.y * m_viewportSize.x + pos.x] = color.has_value() ? 1 : 0;
+					++tileRayCount;
+				}
+			}
+			rayCount += tileRayCount;
+		}
+	);
+
+	if (endRank < SampleOrder::rankCount)
+	{
+		threadPool.parallelFor(tileCount.y,
+			[this, startRank, endRank] (int tileRow)
+			{
+				splatSamples(tileRow, startRank, endRank);
+			}
+		);
+	}
+	return rayCount;
+}
+
+void Renderer::splatSamples(int tileRow, int startRank, int endRank)
+{
+	const SampleOrder::BlueNoise& blueNoise = SampleOrder::getBlueNoise();
+	int tileColumnCount = (m_viewportSize.x + SampleOrder::tileSize - 1) / SampleOrder::tileSize;
+	int bandStart = tileRow * SampleOrder::tileSize;
+	int bandEnd = std::min(bandStart + SampleOrder::tileSize, m_viewportSize.y);
+	for (int rank = startRank; rank < endRank; ++rank)
+	{
+		int halfSize = SampleOrder::getSplatHalfSize(rank);
+		for (int sourceRow = std::max(tileRow - 1, 0); sourceRow <= tileRow + 1; ++sourceRow)
+		{
+			for (int tileColumn = 0; tileColumn < tileColumnCount; ++tileColumn)
+			{
+				glm::ivec2 pos = glm::ivec2{tileColumn, sourceRow} * SampleOrder::tileSize +
+					blueNoise.positions[rank];
+				if (!isInViewport(pos.x, pos.y))
+				{
+					continue;
+				}
+
+				glm::ivec3 color = getPixel(pos.x, pos.y);
+				unsigned char isHit = m_hitMask[pos.y * m_viewportSize.x + pos.x];
+				int startY = std::max(pos.y - halfSize, bandStart);
+				int endY = std::min(pos.y + halfSize + 1, bandEnd);
+				int startX = std::max(pos.x - halfSize, 0);
+				int endX = std::min(pos.x + halfSize + 1, m_viewportSize.x);
+				for (int y = startY; y < endY; ++y)
+				{
+					const std::uint16_t* rankRow = blueNoise.ranks.data() +
+						(y % SampleOrder::tileSize) * SampleOrder::tileSize;
+					for (int x = startX; x < endX; ++x)
+					{
+						std::size_t pixel = static_cast<std::size_t>(y) * m_viewportSize.x + x;
+						std::uint16_t distance = static_cast<std::uint16_t>(
+							(x - pos.x) * (x - pos.x) + (y - pos.y) * (y - pos.y));
+						if (rankRow[x % SampleOrder::tileSize] >= endRank &&
+							distance < m_splatDistances[pixel])
+						{
+							setPixel(x, y, color);
+							m_hitMask[pixel] = isHit;
+							m_splatDistances[pixel] = distance;
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+void Renderer::antialias(const Raycaster& raycaster, int samples, ThreadPool& threadPool)
+{
+	touchPages(threadPool);
+	cullLights(raycaster, 1, threadPool);
+	int bandCount = (m_viewportSize.y + edgeScanRowCount - 1) / edgeScanRowCount;
+	if (static_cast<int>(m_bandEdgePixels.size()) < bandCount)
+	{
+		m_bandEdgePixels.resize(bandCount);
+	}
+	threadPool.parallelFor(bandCount,
+		[this] (int band)
+		{
+			std::vector<EdgePixel>& edgePixels = m_bandEdgePixels[band];
+			edgePixels.clear();
+			int endY = std::min((band + 1) * edgeScanRowCount, m_viewportSize.y);
+			for (int y = band * edgeScanRowCount; y < endY; ++y)
+			{
+				for (int x = 0; x < m_viewportSize.x; x += edgeSegmentWidth)
+				{
+					if (m_areEdgeSegmentsValid && !isEdgeSegmentCandidate(x / edgeSegmentWidth, y))
+					{
+						continue;
+					}
+
+					int endX = std::min(x + edgeSegmentWidth, m_viewportSize.x);
+					for (int pixelX = x; pixelX < endX; ++pixelX)
+					{
+						EdgeType edgeType = getEdgeType(pixelX, y);
+						if (edgeType != EdgeType::none)
+						{
+							edgePixels.push_back({{pixelX, y}, edgeType});
+						}
+					}
+				}
+			}
+		}
+	);
+
+	m_edgePixels.clear();
+	for (int band = 0; band < bandCount; ++band)
+	{
+		m_edgePixels.insert(m_edgePixels.end(), m_bandEdgePixels[band].begin(),
+			m_bandEdgePixels[band].end());
+	}
+
+	int edgePixelCount = static_cast<int>(m_edgePixels.size());
+	m_edgeColors.resize(m_edgePixels.size());
+	threadPool.parallelFor((edgePixelCount + edgePixelBatchSize - 1) / edgePixelBatchSize,
+		[this, &raycaster, samples, edgePixelCount] (int batch)
+		{
+			int end = std::min((batch + 1) * edgePixelBatchSize, edgePixelCount);
+			for (int i = batch * edgePixelBatchSize; i < end; ++i)
+			{
+				m_edgeColors[i] = calcEdgeColor(raycaster, samples, m_edgePixels[i]);
+			}
+		}
+	);
+
+	for (int i = 0; i < edgePixelCount; ++i)
+	{
+		setPixel(m_edgePixels[i].pos.x, m_edgePixels[i].pos.y, m_edgeColors[i]);
+	}
+	m_areEdgeSegmentsValid = false;
+}
+
+void Renderer::cullLights(const Raycaster& raycaster, int margin, ThreadPool& threadPool)
+{
+	if (!m_isLightCullingEnabled)
+	{
+		m_lightCulling.clear();
+		return;
+	}
+
+	m_lightCulling.cull(raycaster, m_viewportSize, toNDC(0, 0), 2.0f / glm::vec2{getImageSize()},
+		margin, threadPool);
+}
+
+std::optional<glm::ivec3> Renderer::calcColor(const Raycaster& raycaster, int x, int y,
+	const glm::vec2& ndc) const
+{
+	if (!m_lightCulling.isActive())
+	{
+		return raycaster.calcColor(ndc.x, ndc.y);
+	}
+	return raycaster.calcColor(ndc.x, ndc.y, m_lightCulling.getTileLights(x, y));
+}
+
+bool Renderer::isEdgeSegmentCandidate(int column, int y) const
+{
+	EdgeSegment merged = m_edgeSegments[static_cast<std::size_t>(y) * m_edgeSegmentColumnCount +
+		column];
+	for (const glm::ivec2& offset : neighborOffsets)
+	{
+		int neighborColumn = column + offset.x;
+		int neighborY = y + offset.y;
+		if (neighborColumn < 0 || neighborColumn >= m_edgeSegmentColumnCount || neighborY < 0 ||
+			neighborY >= m_viewportSize.y)
+		{
+			continue;
+		}
+
+		const EdgeSegment& neighbor = m_edgeSegments[static_cast<std::size_t>(neighborY) *
+			m_edgeSegmentColumnCount + neighborColumn];
+		for (int channel = 0; channel < numOfChannels; ++channel)
+		{
+			merged.minColor[channel] = std::min(merged.minColor[channel],
+				neighbor.minColor[channel]);
+			merged.maxColor[channel] = std::max(merged.maxColor[channel],
+				neighbor.maxColor[channel]);
+		}
+		merged.hitFlags |= neighbor.hitFlags;
+	}
+
+	if (merged.hitFlags != edgeSegmentHitFlag)
+	{
+		return merged.hitFlags != edgeSegmentMissFlag;
+	}
+	for (int channel = 0; channel < numOfChannels; ++channel)
+	{
+		if (merged.maxColor[channel] - merged.minColor[channel] > edgeColorThreshold)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+Renderer::EdgeType Renderer::getEdgeType(int x, int y) const
+{
+	unsigned char isHit = m_hitMask[y * m_viewportSize.x + x];
+	glm::ivec3 color = getPixel(x, y);
+	EdgeType edgeType = EdgeType::none;
+	for (const glm::ivec2& offset : neighborOffsets)
+	{
+		int neighborX = x + offset.x;
+		int neighborY = y + offset.y;
+		if (!isInViewport(neighborX, neighborY))
+		{
+			continue;
+		}
+
+		if (m_hitMask[neighborY * m_viewportSize.x + neighborX] != isHit)
+		{
+			return EdgeType::silhouette;
+		}
+
+		glm::ivec3 colorDiff = glm::abs(getPixel(neighborX, neighborY) - color);
+		if (isHit && std::max({colorDiff.r, colorDiff.g, colorDiff.b}) > edgeColorThreshold)
+		{
+			edgeType = EdgeType::shading;
+		}
+	}
+	return edgeType;
+}
+
+glm::ivec3 Renderer::calcEdgeColor(const Raycaster& raycaster, int samples,
+	const EdgePixel& edgePixel) const
+{
+	if (edgePixel.type == EdgeType::silhouette)
+	{
+		std::optional<glm::ivec3> color =
+			calcSilhouetteColor(raycaster, edgePixel.pos.x, edgePixel.pos.y);
+		if (color.has_value())
+		{
+			return *color;
+		}
+	}
+	return supersample(raycaster, samples, edgePixel.pos.x, edgePixel.pos.y);
+}
+
+std::optional<glm::ivec3> Renderer::calcSilhouetteColor(const Raycaster& raycaster, int x,
+	int y) const
+{
+	glm::vec2 ndc = toNDC(static_cast<float>(x), static_cast<float>(y));
+	float halfPixelWidth = 1.0f / getImageSize().x;
+	float halfPixelHeight = 1.0f / getImageSize().y;
+
+	float delta = raycaster.calcDelta(ndc.x, ndc.y);
+	glm::vec2 deltaGradient
+	{
+		raycaster.calcDelta(ndc.x + halfPixelWidth, ndc.y) -
+			raycaster.calcDelta(ndc.x - halfPixelWidth, ndc.y),
+		raycaster.calcDelta(ndc.x, ndc.y + halfPixelHeight) -
+			raycaster.calcDelta(ndc.x, ndc.y - halfPixelHeight)
+	};
+	float deltaGradientLength = glm::length(deltaGradient);
+	if (deltaGradientLength == 0)
+	{
+		return std::nullopt;
+	}
+
+	float distance = delta / deltaGradientLength;
+	if (std::abs(distance) > 1)
+	{
+		return std::nullopt;
+	}
+
+	glm::ivec3 hitColor{};
+	if (m_hitMask[y * m_viewportSize.x + x])
+	{
+		hitColor = getPixel(x, y);
+	}
+	else
+	{
+		int hitNeighbors = 0;
+		for (const glm::ivec2& offset : neighborOffsets)
+		{
+			int neighborX = x + offset.x;
+			int neighborY = y + offset.y;
+			if (isInViewport(neighborX, neighborY) &&
+				m_hitMask[neighborY * m_viewportSize.x + neighborX])
+			{
+				hitColor += getPixel(neighborX, neighborY);
+				++hitNeighbors;
+			}
+		}
+		if (hitNeighbors == 0)
+		{
+			return std::nullopt;
+		}
+		hitColor /= hitNeighbors;
+	}
+
+	float coverage = std::clamp(0.5f + distance, 0.0f, 1.0f);
+	return glm::ivec3{glm::mix(glm::vec3{backgroundColor}, glm::vec3{hitColor}, coverage)};
+}
+
+glm::ivec3 Renderer::supersample(const Raycaster& raycaster, int samples, int x, int y) const
+{
+	glm::vec2 ndc = toNDC(static_cast<float>(x), static_cast<float>(y));
+	float pixelWidth = 2.0f / getImageSize().x;
+	float pixelHeight = 2.0f / getImageSize().y;
+
+	glm::ivec3 colorSum{};
+	for (int sampleY = 0; sampleY < samples; ++sampleY)
+	{
+		float offsetY = (sampleY + 0.5f) / samples - 0.5f;
+		for (int sampleX = 0; sampleX < samples; ++sampleX)
+		{
+			float offsetX = (sampleX + 0.5f) / samples - 0.5f;
+			glm::vec2 sampleNdc{ndc.x + offsetX * pixelWidth, ndc.y + offsetY * pixelHeight};
+			colorSum += calcColor(raycaster, x, y, sampleNdc).value_or(backgroundColor);
+		}
+	}
+	return colorSum / (samples * samples);
+}
+
+glm::ivec2 Renderer::getImageSize() const
+{
+	return m_imageSize.x > 0 ? m_imageSize : m_viewportSize;
+}
+
+glm::vec2 Renderer::toNDC(float x, float y) const
+{
+	glm::ivec2 imageSize = getImageSize();
+	return
+	{
+		2 * (x + m_regionOffset.x) / imageSize.x - 1,
+		2 * (y + m_regionOffset.y) / imageSize.y - 1
+	};
+}
+
+bool Renderer::isInViewport(int x, int y) const
+{
+	return x >= 0 && x < m_viewportSize.x && y >= 0 && y < m_viewportSize.y;
+}
+
+glm::ivec3 Renderer::getPixel(int x, int y) const
+{
+	std::size_t index = (static_cast<std::size_t>(y) * m_viewportSize.x + x) * numOfChannels;
+	return {m_cpuTexture[index], m_cpuTexture[index + 1], m_cpuTexture[index + 2]};
+}
+
+void Renderer::setPixel(int x, int y, const glm::ivec3& color)
+{
+	std::size_t index = (static_cast<std::size_t>(y) * m_viewportSize.x + x) * numOfChannels;
+	for (int channel = 0; channel < numOfChannels; ++channel)
+	{
+		m_cpuTexture[index + channel] = static_cast<unsigned char>(color[channel]);
+	}
+}
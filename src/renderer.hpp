@@ -0,0 +1,125 @@
+#pragma once
+
+#include "framebufferAllocator.hpp"
+#include "lightCulling.hpp"
+#include "raycaster.hpp"
+#include "threadPool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+class Renderer
+{
+public:
+	static constexpr int numOfChannels = 3;
+	static constexpr glm::ivec3 backgroundColor{30, 30, 30};
+	static constexpr int traversalTileSize = 64;
+	static constexpr int minTileSize = 32;
+	static constexpr int maxTileSize = 4096;
+
+	enum class Traversal
+	{
+		rowMajor,
+		morton
+	};
+
+	Renderer(const glm::ivec2& viewportSize);
+
+	void updateViewportSize();
+	void reserve(const glm::ivec2& maxViewportSize);
+	void setImageRegion(const glm::ivec2& imageSize, const glm::ivec2& regionOffset);
+	std::span<const unsigned char> getCpuTexture() const;
+	std::span<const unsigned char> getHitMask() const;
+	void load(std::span<const unsigned char> cpuTexture, std::span<const unsigned char> hitMask,
+		ThreadPool& threadPool);
+	Traversal getTraversal() const;
+	void setTraversal(Traversal traversal);
+	int getTileSize() const;
+	void setTileSize(int tileSize);
+	static bool isTileSizeValid(int tileSize);
+	bool isLightCullingEnabled() const;
+	void setLightCullingEnabled(bool isLightCullingEnabled);
+	float getMeanTileLightCount() const;
+
+	void touchPages(ThreadPool& threadPool);
+	void resetEdgeSegments();
+	void drawPass(const Raycaster& raycaster, int pixelSize, bool isFirstPass,
+		ThreadPool& threadPool);
+	int getRowCount(int pixelSize) const;
+	void drawRows(const Raycaster& raycaster, int pixelSize, bool isFirstPass, int startRow,
+		int endRow);
+	int drawSamples(const Raycaster& raycaster, int startRank, int endRank,
+		ThreadPool& threadPool);
+	void antialias(const Raycaster& raycaster, int samples, ThreadPool& threadPool);
+
+private:
+	enum class EdgeType
+	{
+		none,
+		silhouette,
+		shading
+	};
+
+	struct EdgePixel
+	{
+		glm::ivec2 pos{};
+		EdgeType type{};
+	};
+
+	struct EdgeSegment
+	{
+		unsigned char hitFlags{};
+		std::array<unsigned char, numOfChannels> minColor{};
+		std::array<unsigned char, numOfChannels> maxColor{};
+	};
+
+	const glm::ivec2& m_viewportSize;
+	glm::ivec2 m_imageSize{};
+	glm::ivec2 m_regionOffset{};
+	FramebufferVector<unsigned char> m_cpuTexture{};
+	FramebufferVector<unsigned char> m_hitMask{};
+	bool m_isTouchPending = true;
+	std::vector<EdgeSegment> m_edgeSegments{};
+	int m_edgeSegmentColumnCount{};
+	bool m_areEdgeSegmentsValid = false;
+	std::vector<std::vector<EdgePixel>> m_bandEdgePixels{};
+	std::vector<EdgePixel> m_edgePixels{};
+	std::vector<glm::ivec3> m_edgeColors{};
+	FramebufferVector<std::uint16_t> m_splatDistances{};
+	Traversal m_traversal = Traversal::rowMajor;
+	int m_tileSize = traversalTileSize;
+	std::vector<glm::ivec2> m_tileOrder{};
+	glm::ivec2 m_tileOrderCount{};
+	LightCulling m_lightCulling{};
+	bool m_isLightCullingEnabled = true;
+
+	void drawRegion(const Raycaster& raycaster, int pixelSize, bool isFirstPass, int startRow,
+		int endRow, int startX, int endX);
+	void fillBlock(const glm::ivec2& start, const glm::ivec2& end, const glm::ivec3& color,
+		unsigned char isHit);
+	void splatSamples(int tileRow, int startRank, int endRank);
+	void updateTileOrder(const glm::ivec2& tileCount);
+	static std::uint32_t calcMortonCode(const glm::ivec2& tile);
+	void cullLights(const Raycaster& raycaster, int margin, ThreadPool& threadPool);
+	std::optional<glm::ivec3> calcColor(const Raycaster& raycaster, int x, int y,
+		const glm::vec2& ndc) const;
+
+	void recordEdgeSample(int x, int y, const glm::ivec3& color, unsigned char isHit);
+	bool isEdgeSegmentCandidate(int column, int y) const;
+	EdgeType getEdgeType(int x, int y) const;
+	glm::ivec3 calcEdgeColor(const Raycaster& raycaster, int samples,
+		const EdgePixel& edgePixel) const;
+	std::optional<glm::ivec3> calcSilhouetteColor(const Raycaster& raycaster, int x, int y) const;
+	glm::ivec3 supersample(const Raycaster& raycaster, int samples, int x, int y) const;
+
+	glm::ivec2 getImageSize() const;
+	glm::vec2 toNDC(float x, float y) const;
+	bool isInViewport(int x, int y) const;
+	glm::ivec3 getPixel(int x, int y) const;
+	void setPixel(int x, int y, const glm::ivec3& color);
+};
@@ -0,0 +1,83 @@
+#include "resizeSweep.hpp"
+
+#include "service/loadTest.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+constexpr float minSizeFraction = 0.5f;
+constexpr int jitterPixels = 3;
+
+ResizeSweep::ResizeSweep(const glm::ivec2& initialSize, int resizeFrameCount,
+	int settleFrameCount) :
+	m_initialSize{initialSize},
+	m_resizeFrameCount{resizeFrameCount},
+	m_settleFrameCount{settleFrameCount}
+{ }
+
+std::optional<glm::ivec2> ResizeSweep::nextFrame(double lastFrameMs, bool isResizePending)
+{
+	if (m_frame > 0 && m_frame <= m_resizeFrameCount)
+	{
+		m_resizeFrameMs.push_back(lastFrameMs);
+	}
+	else if (m_frame > m_resizeFrameCount)
+	{
+		m_settleFrameMs.push_back(lastFrameMs);
+		if (!m_isSettled)
+		{
+			m_settleLatencyMs += lastFrameMs;
+			m_isSettled = !isResizePending;
+		}
+	}
+	if (m_wasResizePending && !isResizePending)
+	{
+		++m_reallocationCount;
+	}
+	m_wasResizePending = isResizePending;
+
+	int frame = m_frame++;
+	if (frame >= m_resizeFrameCount)
+	{
+		return std::nullopt;
+	}
+
+	float progress = static_cast<float>(frame + 1) / m_resizeFrameCount;
+	float fraction = 1 - (1 - minSizeFraction) * std::sin(glm::pi<float>() * progress);
+	int jitter = frame % 2 == 0 ? jitterPixels : -jitterPixels;
+	glm::ivec2 size = glm::ivec2{glm::vec2{m_initialSize} * fraction} + jitter;
+	if (frame == m_resizeFrameCount - 1)
+	{
+		size = m_initialSize;
+	}
+	return glm::max(size, glm::ivec2{1, 1});
+}
+
+bool ResizeSweep::isFinished() const
+{
+	return m_frame > m_resizeFrameCount + m_settleFrameCount;
+}
+
+void ResizeSweep::printReport(std::ostream& output)
+{
+	auto printFrameTimes = [&output] (const char* name, std::vector<double>& frameMs)
+		{
+			double sum = 0;
+			for (double ms : frameMs)
+			{
+				sum += ms;
+			}
+			output << name << " frames: " << frameMs.size() << ", mean " <<
+				sum / std::max<std::size_t>(frameMs.size(), 1) << " ms, p50 " <<
+				LoadTest::percentile(frameMs, 0.5) << " ms, p99 " <<
+				LoadTest::percentile(frameMs, 0.99) << " ms, max " <<
+				LoadTest::percentile(frameMs, 1.0) << " ms\n";
+		};
+
+	printFrameTimes("resize", m_resizeFrameMs);
+	printFrameTimes("settle", m_settleFrameMs);
+	output << "reallocations: " << m_reallocationCount << '\n';
+	output << "last resize to re-render: " << m_settleLatencyMs << " ms\n";
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <optional>
+#include <ostream>
+#include <vector>
+
+class ResizeSweep
+{
+public:
+	ResizeSweep(const glm::ivec2& initialSize, int resizeFrameCount, int settleFrameCount);
+
+	std::optional<glm::ivec2> nextFrame(double lastFrameMs, bool isResizePending);
+	bool isFinished() const;
+	void printReport(std::ostream& output);
+
+private:
+	glm::ivec2 m_initialSize{};
+	int m_resizeFrameCount{};
+	int m_settleFrameCount{};
+	int m_frame{};
+	bool m_wasResizePending = false;
+
+	std::vector<double> m_resizeFrameMs{};
+	std::vector<double> m_settleFrameMs{};
+	int m_reallocationCount{};
+	double m_settleLatencyMs{};
+	bool m_isSettled = false;
+};
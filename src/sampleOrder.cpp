@@ -0,0 +1,77 @@
+#include "sampleOrder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+
+namespace SampleOrder
+{
+	constexpr float energySigma = 1.9f;
+	constexpr float tieBreakJitter = 1e-3f;
+	constexpr unsigned int jitterSeed = 12345;
+
+	BlueNoise createBlueNoise()
+	{
+		std::vector<float> kernel(rankCount);
+		for (int y = 0; y < tileSize; ++y)
+		{
+			for (int x = 0; x < tileSize; ++x)
+			{
+				float dx = static_cast<float>(std::min(x, tileSize - x));
+				float dy = static_cast<float>(std::min(y, tileSize - y));
+				kernel[y * tileSize + x] =
+					std::exp(-(dx * dx + dy * dy) / (2 * energySigma * energySigma));
+			}
+		}
+
+		std::minstd_rand random{jitterSeed};
+		std::uniform_real_distribution<float> jitter{0.0f, tieBreakJitter};
+		std::vector<float> energy(rankCount);
+		for (float& value : energy)
+		{
+			value = jitter(random);
+		}
+
+		BlueNoise blueNoise{};
+		blueNoise.positions.reserve(rankCount);
+		blueNoise.ranks.assign(rankCount, 0);
+		for (int rank = 0; rank < rankCount; ++rank)
+		{
+			int index = static_cast<int>(std::min_element(energy.begin(), energy.end()) -
+				energy.begin());
+			glm::ivec2 position{index % tileSize, index / tileSize};
+			blueNoise.positions.push_back(position);
+			blueNoise.ranks[index] = static_cast<std::uint16_t>(rank);
+
+			for (int y = 0; y < tileSize; ++y)
+			{
+				const float* kernelRow =
+					kernel.data() + ((y - position.y + tileSize) % tileSize) * tileSize;
+				float* energyRow = energy.data() + y * tileSize;
+				for (int x = 0; x < tileSize; ++x)
+				{
+					energyRow[x] += kernelRow[(x - position.x + tileSize) % tileSize];
+				}
+			}
+			energy[index] = std::numeric_limits<float>::infinity();
+		}
+		return blueNoise;
+	}
+
+	const BlueNoise& getBlueNoise()
+	{
+		static const BlueNoise blueNoise = createBlueNoise();
+		return blueNoise;
+	}
+
+	int getSplatHalfSize(int rank)
+	{
+		if (rank == 0)
+		{
+			return tileSize;
+		}
+		return static_cast<int>(std::ceil(tileSize / (2 * std::sqrt(rank + 1.0f))));
+	}
+}
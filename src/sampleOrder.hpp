@@ -0,0 +1,21 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace SampleOrder
+{
+	constexpr int tileSize = 64;
+	constexpr int rankCount = tileSize * tileSize;
+
+	struct BlueNoise
+	{
+		std::vector<glm::ivec2> positions{};
+		std::vector<std::uint16_t> ranks{};
+	};
+
+	const BlueNoise& getBlueNoise();
+	int getSplatHalfSize(int rank);
+}
@@ -1,23 +1,22 @@
 #include "scene.hpp"
 
+#include "frameCache.hpp"
 #include "material.hpp"
-#include "shaderPrograms.hpp"
+#include "raycaster.hpp"
 
 #include <glad/glad.h>
 
 #include <algorithm>
-#include <cmath>
-#include <cstddef>
+#include <optional>
 
-constexpr float nearPlane = 0.0f;
-constexpr float farPlane = 1000.0f;
-constexpr float initViewWidth = 20.0f;
-
-Scene::Scene(const glm::ivec2& viewportSize) :
+Scene::Scene(const glm::ivec2& viewportSize, ThreadPool& threadPool) :
 	m_viewportSize{viewportSize},
-	m_camera{viewportSize, nearPlane, farPlane, initViewWidth},
-	m_texture{viewportSize},
-	m_cpuTexture(m_numOfChannels * viewportSize.x * viewportSize.y, 0)
+	m_camera{viewportSize, Camera::defaultNearPlane, Camera::defaultFarPlane,
+		Camera::defaultViewWidth},
+	m_speculativeCamera{viewportSize, Camera::defaultNearPlane, Camera::defaultFarPlane,
+		Camera::defaultViewWidth},
+	m_cpuBackend{viewportSize, m_quad, threadPool},
+	m_glslBackend{viewportSize, m_quad}
 {
 	glEnable(GL_DEPTH_TEST);
 	glEnable(GL_CULL_FACE);
@@ -26,69 +25,200 @@ Scene::Scene(const glm::ivec2& viewportSize) :
 
 void Scene::render()
 {
-	static constexpr glm::vec3 backgroundColor{0.1f, 0.1f, 0.1f};
-	glClearColor(backgroundColor.r, backgroundColor.g, backgroundColor.b, 1.0f);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	record(InputTrace::EventType::frame);
+	clear();
+	Raycaster raycaster{m_camera, m_ellipsoid, &m_lights};
+	raycaster.setPrecision(m_precision);
+	getActiveBackend().render(raycaster);
+}
+
+void Scene::speculate(std::chrono::steady_clock::time_point deadline,
+	std::chrono::duration<float> frameInterval)
+{
+	using Clock = std::chrono::steady_clock;
 
-	if (m_pixelSize > 0)
+	if (m_backendType != RenderBackend::Type::cpu || !m_isSpeculationEnabled)
 	{
-		draw();
-		m_texture.overwrite(m_cpuTexture);
-		m_pixelSize /= 2;
+		return;
 	}
 
-	m_texture.use();
-	ShaderPrograms::quad->use();
-	m_quad.render();
+	Clock::time_point now = Clock::now();
+	for (int step = 1; step <= speculationDepth && now < deadline; ++step)
+	{
+		std::optional<CameraState> pose = m_motionPredictor.predict(step * frameInterval, now);
+		if (!pose.has_value())
+		{
+			m_cpuBackend.clearSpeculativeFrames();
+			return;
+		}
+
+		m_speculativeCamera.setState(*pose);
+		Raycaster raycaster{m_speculativeCamera, m_ellipsoid, &m_lights};
+		raycaster.setPrecision(m_precision);
+		if (!m_cpuBackend.speculate(raycaster, m_speculativeCamera.getState(), deadline))
+		{
+			return;
+		}
+		now = Clock::now();
+	}
+}
+
+void Scene::present()
+{
+	if (m_backendType == RenderBackend::Type::glsl)
+	{
+		render();
+		return;
+	}
+
+	record(InputTrace::EventType::frame);
+	clear();
+	m_cpuBackend.present();
+}
+
+bool Scene::isConverged() const
+{
+	return getActiveBackend().isConverged();
+}
+
+std::uint64_t Scene::getRevision() const
+{
+	return m_revision;
 }
 
 void Scene::updateViewportSize()
 {
+	record(InputTrace::EventType::resize, m_viewportSize);
 	m_camera.updateViewportSize();
-	m_texture.rescale(m_viewportSize);
-	m_cpuTexture =
-		std::vector<unsigned char>(m_numOfChannels * m_viewportSize.x * m_viewportSize.y, 0);
+	m_cpuBackend.updateViewportSize();
+	m_glslBackend.updateViewportSize();
 	refresh();
 }
 
+bool Scene::isResizePending() const
+{
+	return m_cpuBackend.isResizePending();
+}
+
+void Scene::setRecorder(InputRecorder* recorder)
+{
+	m_recorder = recorder;
+}
+
+void Scene::setFrameCache(FrameCache* frameCache)
+{
+	m_cpuBackend.setFrameCache(frameCache);
+}
+
 void Scene::moveXCamera(float x)
 {
+	record(InputTrace::EventType::moveX, x);
 	m_camera.moveX(x);
+	m_motionPredictor.reset();
 	refresh();
 }
 
 void Scene::moveYCamera(float y)
 {
+	record(InputTrace::EventType::moveY, y);
 	m_camera.moveY(y);
+	m_motionPredictor.reset();
 	refresh();
 }
 
 void Scene::addPitchCamera(float pitchRad)
 {
+	record(InputTrace::EventType::addPitch, pitchRad);
 	m_camera.addPitch(pitchRad);
+	m_motionPredictor.record(m_camera.getState(), MotionPredictor::Clock::now());
 	refresh();
 }
 
 void Scene::addYawCamera(float yawRad)
 {
+	record(InputTrace::EventType::addYaw, yawRad);
 	m_camera.addYaw(yawRad);
+	m_motionPredictor.record(m_camera.getState(), MotionPredictor::Clock::now());
 	refresh();
 }
 
 void Scene::zoomCamera(float zoom)
 {
+	record(InputTrace::EventType::zoom, zoom);
 	m_camera.zoom(zoom);
+	m_motionPredictor.record(m_camera.getState(), MotionPredictor::Clock::now());
 	refresh();
 }
 
+RenderBackend::Type Scene::getBackend() const
+{
+	return m_backendType;
+}
+
+void Scene::setBackend(RenderBackend::Type backend)
+{
+	record(InputTrace::EventType::backend, static_cast<int>(backend));
+	m_backendType = backend;
+	refresh();
+}
+
+float Scene::getFrameTimeMs() const
+{
+	return getActiveBackend().getFrameTimeMs();
+}
+
 int Scene::getAccuracy() const
 {
-	return m_maxPixelSizeExponent;
+	return m_cpuBackend.getAccuracy();
 }
 
 void Scene::setAccuracy(int maxPixelSizeExponent)
 {
-	m_maxPixelSizeExponent = maxPixelSizeExponent;
+	record(InputTrace::EventType::accuracy, maxPixelSizeExponent);
+	m_cpuBackend.setAccuracy(maxPixelSizeExponent);
+	++m_revision;
+}
+
+int Scene::getAntialiasing() const
+{
+	return m_cpuBackend.getAntialiasing();
+}
+
+void Scene::setAntialiasing(int antialiasingSamples)
+{
+	record(InputTrace::EventType::antialiasing, antialiasingSamples);
+	m_cpuBackend.setAntialiasing(antialiasingSamples);
+	++m_revision;
+}
+
+CpuRenderBackend::Refinement Scene::getRefinement() const
+{
+	return m_cpuBackend.getRefinement();
+}
+
+void Scene::setRefinement(CpuRenderBackend::Refinement refinement)
+{
+	record(InputTrace::EventType::refinement, static_cast<int>(refinement));
+	m_cpuBackend.setRefinement(refinement);
+	++m_revision;
+}
+
+int Scene::getSampleBatch() const
+{
+	return m_cpuBackend.getSampleBatch();
+}
+
+void Scene::setSampleBatch(int sampleBatch)
+{
+	record(InputTrace::EventType::sampleBatch, sampleBatch);
+	m_cpuBackend.setSampleBatch(sampleBatch);
+	++m_revision;
+}
+
+void Scene::setRenderProfile(const RenderProfile& profile)
+{
+	m_precision = profile.precision;
+	m_cpuBackend.setTraversal(profile.traversal, profile.tileSize);
 	refresh();
 }
 
@@ -99,6 +229,7 @@ float Scene::getViewWidth() const
 
 void Scene::setViewWidth(float viewWidth)
 {
+	record(InputTrace::EventType::viewWidth, viewWidth);
 	m_camera.setViewWidth(viewWidth);
 	refresh();
 }
@@ -110,6 +241,7 @@ float Scene::getAmbient() const
 
 void Scene::setAmbient(float ambient)
 {
+	record(InputTrace::EventType::ambient, ambient);
 	Material material = m_ellipsoid.getMaterial();
 	material.ambientCoef = ambient;
 	m_ellipsoid.setMaterial(material);
@@ -123,6 +255,7 @@ float Scene::getDiffuse() const
 
 void Scene::setDiffuse(float diffuse)
 {
+	record(InputTrace::EventType::diffuse, diffuse);
 	Material material = m_ellipsoid.getMaterial();
 	material.diffuseCoef = diffuse;
 	m_ellipsoid.setMaterial(material);
@@ -136,6 +269,7 @@ float Scene::getSpecular() const
 
 void Scene::setSpecular(float specular)
 {
+	record(InputTrace::EventType::specular, specular);
 	Material material = m_ellipsoid.getMaterial();
 	material.specularCoef = specular;
 	m_ellipsoid.setMaterial(material);
@@ -149,6 +283,7 @@ float Scene::getShininess() const
 
 void Scene::setShininess(float shininess)
 {
+	record(InputTrace::EventType::shininess, shininess);
 	Material material = m_ellipsoid.getMaterial();
 	material.shininess = shininess;
 	m_ellipsoid.setMaterial(material);
@@ -162,6 +297,7 @@ float Scene::getEllipsoidA() const
 
 void Scene::setEllipsoidA(float a)
 {
+	record(InputTrace::EventType::ellipsoidA, a);
 	m_ellipsoid.setA(a);
 	refresh();
 }
@@ -173,6 +309,7 @@ float Scene::getEllipsoidB() const
 
 void Scene::setEllipsoidB(float b)
 {
+	record(InputTrace::EventType::ellipsoidB, b);
 	m_ellipsoid.setB(b);
 	refresh();
 }
@@ -184,138 +321,99 @@ float Scene::getEllipsoidC() const
 
 void Scene::setEllipsoidC(float c)
 {
+	record(InputTrace::EventType::ellipsoidC, c);
 	m_ellipsoid.setC(c);
 	refresh();
 }
 
-void Scene::refresh()
+const LightList& Scene::getLights() const
 {
-	m_pixelSize = getMaxPixelSize();
+	return m_lights;
 }
 
-void Scene::draw()
+void Scene::setLights(const LightList& lights)
 {
-	glm::vec3 cameraPos = m_camera.getPos();
-	glm::mat4 cameraMatrix = m_camera.getMatrixInverse();
-	glm::mat4 cameraEllipsoidMatrix =
-		glm::transpose(cameraMatrix) * m_ellipsoid.getMatrix() * cameraMatrix;
-
-	const int halfPixelSize = m_pixelSize / 2;
-	bool isRowIndexEven = true;
-	for (int centerY = 0; centerY < m_viewportSize.y + halfPixelSize;
-		centerY += m_pixelSize, isRowIndexEven = !isRowIndexEven)
-	{
-		int start{};
-		int increment{};
-		if (m_pixelSize != getMaxPixelSize() && isRowIndexEven)
-		{
-			start = m_pixelSize;
-			increment = 2 * m_pixelSize;
-		}
-		else
-		{
-			start = 0;
-			increment = m_pixelSize;
-		}
-
-		for (int centerX = start; centerX < m_viewportSize.x + halfPixelSize; centerX += increment)
-		{
-			glm::ivec3 color = calcColor(cameraPos, cameraMatrix, cameraEllipsoidMatrix,
-				2 * static_cast<float>(centerX) / m_viewportSize.x - 1,
-				2 * static_cast<float>(centerY) / m_viewportSize.y - 1);
-
-			int startY = std::max(centerY - halfPixelSize, 0);
-			int endY =
-				std::min(centerY + (halfPixelSize != 0 ? halfPixelSize : 1), m_viewportSize.y);
-			for (std::size_t y = startY; y < endY; ++y)
-			{
-				int startX = std::max(centerX - halfPixelSize, 0);
-				int endX =
-					std::min(centerX + (halfPixelSize != 0 ? halfPixelSize : 1), m_viewportSize.x);
-				for (std::size_t x = startX; x < endX; ++x)
-				{
-					for (int channel = 0; channel < m_numOfChannels; ++channel)
-					{
-						m_cpuTexture[(y * m_viewportSize.x + x) * m_numOfChannels + channel] =
-							static_cast<unsigned char>(color[channel]);
-					}
-				}
-			}
-		}
-	}
+	m_lights = lights;
+	refresh();
 }
 
-glm::ivec3 Scene::calcColor(const glm::vec3& cameraPos, const glm::mat4& cameraMatrix,
-	const glm::mat4& cameraEllipsoidMatrix, float x, float y) const
+int Scene::getLightCount() const
 {
-	std::optional<float> z = calcIntersection(x, y, cameraEllipsoidMatrix);
-	constexpr glm::ivec3 background{30, 30, 30};
-	if (!z.has_value())
-	{
-		return background;
-	}
-
-	return calcPhong(glm::vec3{cameraMatrix * glm::vec4{x, y, *z, 1}}, cameraPos);
+	return m_lights.getCount();
 }
 
-std::optional<float> Scene::calcIntersection(float x, float y,
-	const glm::mat4& cameraEllipsoidMatrix) const
+void Scene::setLightCount(int lightCount)
 {
-	float a = cameraEllipsoidMatrix[2][2];
-	float b = (cameraEllipsoidMatrix[2][0] + cameraEllipsoidMatrix[0][2]) * x +
-		(cameraEllipsoidMatrix[2][1] + cameraEllipsoidMatrix[1][2]) * y +
-		cameraEllipsoidMatrix[2][3] + cameraEllipsoidMatrix[3][2];
-	float c = (cameraEllipsoidMatrix[0][0] * x + cameraEllipsoidMatrix[0][1] * y +
-		cameraEllipsoidMatrix[0][3] + cameraEllipsoidMatrix[3][0]) * x +
-		(cameraEllipsoidMatrix[1][0] * x + cameraEllipsoidMatrix[1][1] * y +
-		cameraEllipsoidMatrix[1][3] + cameraEllipsoidMatrix[3][1]) * y +
-		cameraEllipsoidMatrix[3][3];
+	record(InputTrace::EventType::lightCount, lightCount);
+	m_lights = LightList::createRing(lightCount, LightList::defaultRingRadius);
+	refresh();
+}
 
-	float delta = b * b - 4 * a * c;
+float Scene::getMeanTileLightCount() const
+{
+	return m_cpuBackend.getMeanTileLightCount();
+}
 
-	if (delta <= 0)
-	{
-		return std::nullopt;
-	}
+const PerfCounters::Sample& Scene::getFrameCounters() const
+{
+	return m_cpuBackend.getFrameCounters();
+}
 
-	float z = (-b - std::sqrt(delta)) / (2 * a);
+bool Scene::isSpeculationEnabled() const
+{
+	return m_isSpeculationEnabled;
+}
 
-	if (z < -1 || z > 1)
+void Scene::setSpeculationEnabled(bool isSpeculationEnabled)
+{
+	m_isSpeculationEnabled = isSpeculationEnabled;
+	if (!isSpeculationEnabled)
 	{
-		return std::nullopt;
+		m_cpuBackend.clearSpeculativeFrames();
 	}
-
-	return z;
 }
 
-glm::ivec3 Scene::calcPhong(const glm::vec3& point, const glm::vec3& cameraPos) const
+const SpeculativeFramePool& Scene::getSpeculativeFramePool() const
 {
-	Material material = m_ellipsoid.getMaterial();
+	return m_cpuBackend.getSpeculativeFramePool();
+}
 
-	glm::vec3 normalVector = m_ellipsoid.getNormalVector(point);
-	glm::vec3 viewVector = glm::normalize(cameraPos);
-	glm::vec3 lightVector = viewVector;
+void Scene::resetSpeculationStats()
+{
+	m_cpuBackend.resetSpeculationStats();
+}
 
-	float ambient = material.ambientCoef;
+void Scene::clear()
+{
+	static constexpr glm::vec3 backgroundColor{0.1f, 0.1f, 0.1f};
+	glClearColor(backgroundColor.r, backgroundColor.g, backgroundColor.b, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
 
-	float lightNormalCos = glm::dot(lightVector, normalVector);
-	float diffuse = lightNormalCos > 0 ? material.diffuseCoef * lightNormalCos : 0;
+void Scene::refresh()
+{
+	++m_revision;
+	float boundingRadius = std::max({m_ellipsoid.getA(), m_ellipsoid.getB(), m_ellipsoid.getC()});
+	m_cpuBackend.setPose(m_camera.getState(), calcSpeculationKey(),
+		poseTolerancePx * m_camera.getViewWidth() / (m_viewportSize.x * boundingRadius));
+	m_cpuBackend.refresh();
+	m_glslBackend.refresh();
+}
 
-	glm::vec3 reflectionVector =
-		2 * glm::dot(lightVector, normalVector) * normalVector - lightVector;
-	float reflectionViewCos = glm::dot(reflectionVector, viewVector);
-	float specular = reflectionViewCos > 0 ?
-		material.specularCoef * std::pow(reflectionViewCos, material.shininess) :
-		0;
+std::uint64_t Scene::calcSpeculationKey() const
+{
+	return FrameCache::calcSceneKey(m_ellipsoid, &m_lights, m_precision,
+		m_cpuBackend.isLightCullingEnabled(), m_viewportSize);
+}
 
-	glm::ivec3 color = (ambient + diffuse + specular) * glm::vec3{material.color};
-	color.r = std::clamp(color.r, 0, 255);
-	color.g = std::clamp(color.g, 0, 255);
-	color.b = std::clamp(color.b, 0, 255);
-	return color;
+RenderBackend& Scene::getActiveBackend()
+{
+	return m_backendType == RenderBackend::Type::glsl ?
+		static_cast<RenderBackend&>(m_glslBackend) : m_cpuBackend;
 }
 
-int Scene::getMaxPixelSize() const
+const RenderBackend& Scene::getActiveBackend() const
 {
-	return 1 << m_maxPixelSizeExponent;
+	return m_backendType == RenderBackend::Type::glsl ?
+		static_cast<const RenderBackend&>(m_glslBackend) : m_cpuBackend;
 }
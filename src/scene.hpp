@@ -1,22 +1,43 @@
 #pragma once
 
+#include "backends/cpuRenderBackend.hpp"
+#include "backends/glslRenderBackend.hpp"
+#include "backends/renderBackend.hpp"
 #include "camera.hpp"
 #include "ellipsoid.hpp"
+#include "frameCache.hpp"
+#include "lightList.hpp"
+#include "motionPredictor.hpp"
+#include "perfCounters.hpp"
 #include "quad.hpp"
-#include "texture.hpp"
+#include "speculativeFramePool.hpp"
+#include "threadPool.hpp"
+#include "trace/inputTrace.hpp"
+#include "tuning/renderProfile.hpp"
 
 #include <glm/glm.hpp>
 
-#include <optional>
-#include <vector>
+#include <chrono>
+#include <cstdint>
 
 class Scene
 {
 public:
-	Scene(const glm::ivec2& viewportSize);
+	static constexpr int speculationDepth = 3;
+	static constexpr float poseTolerancePx = 2.0f;
+
+	Scene(const glm::ivec2& viewportSize, ThreadPool& threadPool);
 
 	void render();
+	void speculate(std::chrono::steady_clock::time_point deadline,
+		std::chrono::duration<float> frameInterval);
+	void present();
+	bool isConverged() const;
+	std::uint64_t getRevision() const;
 	void updateViewportSize();
+	bool isResizePending() const;
+	void setRecorder(InputRecorder* recorder);
+	void setFrameCache(FrameCache* frameCache);
 
 	void moveXCamera(float x);
 	void moveYCamera(float y);
@@ -24,8 +45,19 @@ public:
 	void addYawCamera(float yawRad);
 	void zoomCamera(float zoom);
 
+	RenderBackend::Type getBackend() const;
+	void setBackend(RenderBackend::Type backend);
+	float getFrameTimeMs() const;
+
 	int getAccuracy() const;
 	void setAccuracy(int maxPixelSizeExponent);
+	int getAntialiasing() const;
+	void setAntialiasing(int antialiasingSamples);
+	CpuRenderBackend::Refinement getRefinement() const;
+	void setRefinement(CpuRenderBackend::Refinement refinement);
+	int getSampleBatch() const;
+	void setSampleBatch(int sampleBatch);
+	void setRenderProfile(const RenderProfile& profile);
 	float getViewWidth() const;
 	void setViewWidth(float viewWidth);
 
@@ -45,24 +77,49 @@ public:
 	float getEllipsoidC() const;
 	void setEllipsoidC(float c);
 
+	const LightList& getLights() const;
+	void setLights(const LightList& lights);
+	int getLightCount() const;
+	void setLightCount(int lightCount);
+	float getMeanTileLightCount() const;
+	const PerfCounters::Sample& getFrameCounters() const;
+
+	bool isSpeculationEnabled() const;
+	void setSpeculationEnabled(bool isSpeculationEnabled);
+	const SpeculativeFramePool& getSpeculativeFramePool() const;
+	void resetSpeculationStats();
+
 private:
 	const glm::ivec2& m_viewportSize;
 	Camera m_camera;
+	Camera m_speculativeCamera;
 	Ellipsoid m_ellipsoid{4.0f, 2.0f, 8.0f};
+	LightList m_lights{};
 	Quad m_quad{};
-	Texture m_texture;
-
-	static constexpr int m_numOfChannels = 3;
-	int m_maxPixelSizeExponent = 4;
-	int m_pixelSize = getMaxPixelSize();
-	std::vector<unsigned char> m_cpuTexture{};
+	CpuRenderBackend m_cpuBackend;
+	GlslRenderBackend m_glslBackend;
+	RenderBackend::Type m_backendType = RenderBackend::Type::cpu;
+	Raycaster::Precision m_precision = Raycaster::Precision::adaptive;
+	InputRecorder* m_recorder{};
+	std::uint64_t m_revision{};
+	MotionPredictor m_motionPredictor{};
+	bool m_isSpeculationEnabled = true;
 
 	void refresh();
-	void draw();
-	glm::ivec3 calcColor(const glm::vec3& cameraPos, const glm::mat4& cameraMatrix,
-		const glm::mat4& cameraEllipsoidMatrix, float x, float y) const;
-	std::optional<float> calcIntersection(float x, float y,
-		const glm::mat4& cameraEllipsoidMatrix) const;
-	glm::ivec3 calcPhong(const glm::vec3& point, const glm::vec3& cameraPos) const;
-	int getMaxPixelSize() const;
+	std::uint64_t calcSpeculationKey() const;
+	RenderBackend& getActiveBackend();
+	const RenderBackend& getActiveBackend() const;
+	static void clear();
+
+	template <typename... Args>
+	void record(InputTrace::EventType type, Args... args);
 };
+
+template <typename... Args>
+void Scene::record(InputTrace::EventType type, Args... args)
+{
+	if (m_recorder != nullptr)
+	{
+		m_recorder->record(type, args...);
+	}
+}
@@ -0,0 +1,23 @@
+#include "service/clientConnection.hpp"
+
+#include <utility>
+
+ClientConnection::ClientConnection(Socket socket) :
+	m_socket{std::move(socket)}
+{ }
+
+bool ClientConnection::send(const std::vector<unsigned char>& message)
+{
+	std::lock_guard<std::mutex> lock{m_sendMutex};
+	return m_socket.sendMessage(message);
+}
+
+bool ClientConnection::receive(std::vector<unsigned char>& message) const
+{
+	return m_socket.receiveMessage(message);
+}
+
+void ClientConnection::close()
+{
+	m_socket.shutdown();
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "network/socket.hpp"
+
+#include <mutex>
+#include <vector>
+
+class ClientConnection
+{
+public:
+	ClientConnection(Socket socket);
+
+	bool send(const std::vector<unsigned char>& message);
+	bool receive(std::vector<unsigned char>& message) const;
+	void close();
+
+private:
+	Socket m_socket;
+	std::mutex m_sendMutex{};
+};
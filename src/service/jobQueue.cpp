@@ -0,0 +1,93 @@
+#include "service/jobQueue.hpp"
+
+void JobQueue::push(const std::shared_ptr<RenderJob>& job)
+{
+	{
+		std::lock_guard<std::mutex> lock{m_mutex};
+		job->sequenceNumber = m_nextSequenceNumber++;
+		m_queuedJobs.insert(job);
+	}
+	m_jobCondition.notify_one();
+}
+
+std::shared_ptr<RenderJob> JobQueue::pop()
+{
+	std::unique_lock<std::mutex> lock{m_mutex};
+	m_jobCondition.wait(lock, [this] () { return m_stop || !m_queuedJobs.empty(); });
+	if (m_stop)
+	{
+		return nullptr;
+	}
+
+	m_runningJob = *m_queuedJobs.begin();
+	m_queuedJobs.erase(m_queuedJobs.begin());
+	return m_runningJob;
+}
+
+void JobQueue::finish(const std::shared_ptr<RenderJob>& job)
+{
+	std::lock_guard<std::mutex> lock{m_mutex};
+	if (m_runningJob == job)
+	{
+		m_runningJob = nullptr;
+	}
+}
+
+std::shared_ptr<RenderJob> JobQueue::cancel(const ClientConnection* connection,
+	std::uint32_t jobId)
+{
+	std::lock_guard<std::mutex> lock{m_mutex};
+	if (m_runningJob && m_runningJob->connection.get() == connection &&
+		m_runningJob->request.jobId == jobId)
+	{
+		m_runningJob->isCancelled = true;
+		return nullptr;
+	}
+
+	for (auto job = m_queuedJobs.begin(); job != m_queuedJobs.end(); ++job)
+	{
+		if ((*job)->connection.get() == connection && (*job)->request.jobId == jobId)
+		{
+			std::shared_ptr<RenderJob> cancelledJob = *job;
+			cancelledJob->isCancelled = true;
+			m_queuedJobs.erase(job);
+			return cancelledJob;
+		}
+	}
+	return nullptr;
+}
+
+void JobQueue::cancelAll(const ClientConnection* connection)
+{
+	std::lock_guard<std::mutex> lock{m_mutex};
+	if (m_runningJob && m_runningJob->connection.get() == connection)
+	{
+		m_runningJob->isCancelled = true;
+	}
+
+	std::erase_if(m_queuedJobs,
+		[connection] (const std::shared_ptr<RenderJob>& job)
+		{
+			return job->connection.get() == connection;
+		}
+	);
+}
+
+void JobQueue::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock{m_mutex};
+		m_stop = true;
+	}
+	m_jobCondition.notify_all();
+}
+
+bool JobQueue::JobOrder::operator()(const std::shared_ptr<RenderJob>& left,
+	const std::shared_ptr<RenderJob>& right) const
+{
+	if (left->request.priority != right->request.priority)
+	{
+		return left->request.priority > right->request.priority;
+	}
+	return left->sequenceNumber < right->sequenceNumber;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "service/clientConnection.hpp"
+#include "service/protocol.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+
+struct RenderJob
+{
+	Protocol::RenderRequest request{};
+	std::shared_ptr<ClientConnection> connection{};
+	std::uint64_t sequenceNumber{};
+	std::atomic<bool> isCancelled = false;
+};
+
+class JobQueue
+{
+public:
+	void push(const std::shared_ptr<RenderJob>& job);
+	std::shared_ptr<RenderJob> pop();
+	void finish(const std::shared_ptr<RenderJob>& job);
+	std::shared_ptr<RenderJob> cancel(const ClientConnection* connection, std::uint32_t jobId);
+	void cancelAll(const ClientConnection* connection);
+	void stop();
+
+private:
+	struct JobOrder
+	{
+		bool operator()(const std::shared_ptr<RenderJob>& left,
+			const std::shared_ptr<RenderJob>& right) const;
+	};
+
+	std::mutex m_mutex{};
+	std::condition_variable m_jobCondition{};
+	std::set<std::shared_ptr<RenderJob>, JobOrder> m_queuedJobs{};
+	std::shared_ptr<RenderJob> m_runningJob{};
+	std::uint64_t m_nextSequenceNumber{};
+	bool m_stop = false;
+};
@@ -0,0 +1,122 @@
+#include "service/loadTest.hpp"
+
+#include "service/renderClient.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+int LoadTest::run(const CommandLine& commandLine)
+{
+	using Clock = std::chrono::steady_clock;
+
+	const std::string socketPath = commandLine.getString("socket", "ellipsoid-raycasting.sock");
+	const int jobCount = commandLine.getInt("jobs", 200);
+	const int connectionCount = std::max(commandLine.getInt("connections", 4), 1);
+	const int cancelEvery = commandLine.getInt("cancel-every", 0);
+	const Protocol::RenderRequest requestTemplate = RenderClient::parseRequest(commandLine);
+
+	std::atomic<int> nextJob = 0;
+	std::atomic<int> failedJobs = 0;
+	std::atomic<int> cancelledJobs = 0;
+	std::mutex resultsMutex{};
+	std::vector<double> latenciesMs{};
+	std::vector<double> renderTimesMs{};
+
+	Clock::time_point start = Clock::now();
+	std::vector<std::thread> connections{};
+	for (int i = 0; i < connectionCount; ++i)
+	{
+		connections.emplace_back(
+			[&] ()
+			{
+				RenderClient client{socketPath};
+				if (!client.isConnected())
+				{
+					return;
+				}
+
+				for (int job = nextJob++; job < jobCount; job = nextJob++)
+				{
+					Protocol::RenderRequest request = requestTemplate;
+					request.jobId = static_cast<std::uint32_t>(job);
+					request.settings.camera.yawRad += 0.01f * job;
+
+					Clock::time_point submitTime = Clock::now();
+					bool isCancelled = cancelEvery > 0 && job % cancelEvery == 0;
+					if (!client.submit(request) || (isCancelled && !client.cancel(request.jobId)))
+					{
+						++failedJobs;
+						return;
+					}
+
+					std::optional<RenderClient::Response> response = client.receive();
+					double latencyMs = std::chrono::duration<double, std::milli>(
+						Clock::now() - submitTime).count();
+					if (!response.has_value())
+					{
+						++failedJobs;
+						return;
+					}
+
+					if (const Protocol::FrameResponse* frame =
+						std::get_if<Protocol::FrameResponse>(&*response))
+					{
+						std::lock_guard<std::mutex> lock{resultsMutex};
+						latenciesMs.push_back(latencyMs);
+						renderTimesMs.push_back(frame->renderTimeUs / 1000.0);
+					}
+					else if (std::get<Protocol::StatusResponse>(*response).type ==
+						Protocol::MessageType::cancelled)
+					{
+						++cancelledJobs;
+					}
+					else
+					{
+						++failedJobs;
+					}
+				}
+			}
+		);
+	}
+	for (std::thread& connection : connections)
+	{
+		connection.join();
+	}
+	double elapsedS = std::chrono::duration<double>(Clock::now() - start).count();
+
+	int completedJobs = static_cast<int>(latenciesMs.size());
+	double meanRenderTimeMs = 0;
+	for (double renderTimeMs : renderTimesMs)
+	{
+		meanRenderTimeMs += renderTimeMs / std::max(completedJobs, 1);
+	}
+
+	std::cout << "jobs: " << jobCount << " (completed " << completedJobs << ", cancelled " <<
+		cancelledJobs << ", failed " << failedJobs << ")\n";
+	std::cout << "connections: " << connectionCount << '\n';
+	std::cout << "resolution: " << requestTemplate.settings.resolution.x << 'x' <<
+		requestTemplate.settings.resolution.y << '\n';
+	std::cout << "throughput: " << completedJobs / elapsedS << " jobs/s\n";
+	std::cout << "latency p50: " << percentile(latenciesMs, 0.5) << " ms\n";
+	std::cout << "latency p99: " << percentile(latenciesMs, 0.99) << " ms\n";
+	std::cout << "mean render time: " << meanRenderTimeMs << " ms\n";
+	return failedJobs > 0 ? 1 : 0;
+}
+
+double LoadTest::percentile(std::vector<double>& values, double fraction)
+{
+	if (values.empty())
+	{
+		return 0;
+	}
+
+	std::size_t index = static_cast<std::size_t>(std::ceil(fraction * values.size())) - 1;
+	index = std::min(index, values.size() - 1);
+	std::nth_element(values.begin(), values.begin() + index, values.end());
+	return values[index];
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "commandLine.hpp"
+
+#include <vector>
+
+class LoadTest
+{
+public:
+	static int run(const CommandLine& commandLine);
+	static double percentile(std::vector<double>& values, double fraction);
+};
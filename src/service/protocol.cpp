@@ -0,0 +1,427 @@
+#include "service/protocol.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+namespace Protocol
+{
+	class MessageWriter
+	{
+	public:
+		MessageWriter(MessageType type)
+		{
+			writeUint8(static_cast<std::uint8_t>(type));
+		}
+
+		void writeUint8(std::uint8_t value)
+		{
+			m_message.push_back(value);
+		}
+
+		void writeUint32(std::uint32_t value)
+		{
+			for (int byte = 0; byte < 4; ++byte)
+			{
+				m_message.push_back(static_cast<unsigned char>(value >> (8 * byte)));
+			}
+		}
+
+		void writeInt32(std::int32_t value)
+		{
+			writeUint32(static_cast<std::uint32_t>(value));
+		}
+
+		void writeFloat(float value)
+		{
+			std::uint32_t bits{};
+			std::memcpy(&bits, &value, sizeof(bits));
+			writeUint32(bits);
+		}
+
+		void writeBytes(const std::vector<unsigned char>& bytes)
+		{
+			writeUint32(static_cast<std::uint32_t>(bytes.size()));
+			m_message.insert(m_message.end(), bytes.begin(), bytes.end());
+		}
+
+		std::vector<unsigned char>& getMessage()
+		{
+			return m_message;
+		}
+
+	private:
+		std::vector<unsigned char> m_message{};
+	};
+
+	class MessageReader
+	{
+	public:
+		MessageReader(const std::vector<unsigned char>& message, MessageType type) :
+			m_message{message}
+		{
+			m_isValid = !message.empty() && message[0] == static_cast<std::uint8_t>(type);
+			m_offset = 1;
+		}
+
+		bool isValid() const
+		{
+			return m_isValid && m_offset == m_message.size();
+		}
+
+		bool hasRemaining() const
+		{
+			return m_isValid && m_offset < m_message.size();
+		}
+
+		std::uint8_t readUint8()
+		{
+			if (!canRead(1))
+			{
+				return 0;
+			}
+			return m_message[m_offset++];
+		}
+
+		std::uint32_t readUint32()
+		{
+			if (!canRead(4))
+			{
+				return 0;
+			}
+			std::uint32_t value = 0;
+			for (int byte = 0; byte < 4; ++byte)
+			{
+				value |= static_cast<std::uint32_t>(m_message[m_offset++]) << (8 * byte);
+			}
+			return value;
+		}
+
+		std::int32_t readInt32()
+		{
+			return static_cast<std::int32_t>(readUint32());
+		}
+
+		float readFloat()
+		{
+			std::uint32_t bits = readUint32();
+			float value{};
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		std::vector<unsigned char> readBytes()
+		{
+			std::uint32_t size = readUint32();
+			if (!canRead(size))
+			{
+				return {};
+			}
+			std::vector<unsigned char> bytes(m_message.begin() + m_offset,
+				m_message.begin() + m_offset + size);
+			m_offset += size;
+			return bytes;
+		}
+
+	private:
+		const std::vector<unsigned char>& m_message;
+		std::size_t m_offset{};
+		bool m_isValid{};
+
+		bool canRead(std::size_t size)
+		{
+			if (m_message.size() - m_offset < size)
+			{
+				m_isValid = false;
+				return false;
+			}
+			return true;
+		}
+	};
+
+	void writeSettings(MessageWriter& writer, const RenderSettings& settings)
+	{
+		writer.writeInt32(settings.resolution.x);
+		writer.writeInt32(settings.resolution.y);
+		writer.writeFloat(settings.camera.targetPos.x);
+		writer.writeFloat(settings.camera.targetPos.y);
+		writer.writeFloat(settings.camera.targetPos.z);
+		writer.writeFloat(settings.camera.pitchRad);
+		writer.writeFloat(settings.camera.yawRad);
+		writer.writeFloat(settings.camera.viewWidth);
+		writer.writeFloat(settings.radii.x);
+		writer.writeFloat(settings.radii.y);
+		writer.writeFloat(settings.radii.z);
+		writer.writeInt32(settings.material.color.r);
+		writer.writeInt32(settings.material.color.g);
+		writer.writeInt32(settings.material.color.b);
+		writer.writeFloat(settings.material.ambientCoef);
+		writer.writeFloat(settings.material.diffuseCoef);
+		writer.writeFloat(settings.material.specularCoef);
+		writer.writeFloat(settings.material.shininess);
+		writer.writeInt32(settings.antialiasingSamples);
+	}
+
+	RenderSettings readSettings(MessageReader& reader)
+	{
+		RenderSettings settings{};
+		settings.resolution.x = reader.readInt32();
+		settings.resolution.y = reader.readInt32();
+		settings.camera.targetPos.x = reader.readFloat();
+		settings.camera.targetPos.y = reader.readFloat();
+		settings.camera.targetPos.z = reader.readFloat();
+		settings.camera.pitchRad = reader.readFloat();
+		settings.camera.yawRad = reader.readFloat();
+		settings.camera.viewWidth = reader.readFloat();
+		settings.radii.x = reader.readFloat();
+		settings.radii.y = reader.readFloat();
+		settings.radii.z = reader.readFloat();
+		settings.material.color.r = reader.readInt32();
+		settings.material.color.g = reader.readInt32();
+		settings.material.color.b = reader.readInt32();
+		settings.material.ambientCoef = reader.readFloat();
+		settings.material.diffuseCoef = reader.readFloat();
+		settings.material.specularCoef = reader.readFloat();
+		settings.material.shininess = reader.readFloat();
+		settings.antialiasingSamples = reader.readInt32();
+		return settings;
+	}
+
+	std::optional<MessageType> getMessageType(const std::vector<unsigned char>& message)
+	{
+		if (message.empty() || message[0] < static_cast<std::uint8_t>(MessageType::renderRequest) ||
+			message[0] > static_cast<std::uint8_t>(MessageType::frameDelta))
+		{
+			return std::nullopt;
+		}
+		return static_cast<MessageType>(message[0]);
+	}
+
+	std::vector<unsigned char> serialize(const RenderRequest& request)
+	{
+		MessageWriter writer{MessageType::renderRequest};
+		writer.writeUint32(request.jobId);
+		writer.writeInt32(request.priority);
+		writer.writeUint8(static_cast<std::uint8_t>(request.format));
+		writeSettings(writer, request.settings);
+		return std::move(writer.getMessage());
+	}
+
+	std::vector<unsigned char> serialize(const CancelRequest& request)
+	{
+		MessageWriter writer{MessageType::cancelRequest};
+		writer.writeUint32(request.jobId);
+		return std::move(writer.getMessage());
+	}
+
+	std::vector<unsigned char> serialize(const FrameResponse& response)
+	{
+		MessageWriter writer{MessageType::frame};
+		writer.writeUint32(response.jobId);
+		writer.writeUint8(static_cast<std::uint8_t>(response.format));
+		writer.writeInt32(response.resolution.x);
+		writer.writeInt32(response.resolution.y);
+		writer.writeUint32(response.renderTimeUs);
+		writer.writeBytes(response.data);
+		return std::move(writer.getMessage());
+	}
+
+	std::vector<unsigned char> serialize(const StatusResponse& response)
+	{
+		MessageWriter writer{response.type};
+		writer.writeUint32(response.jobId);
+		writer.writeBytes({response.message.begin(), response.message.end()});
+		return std::move(writer.getMessage());
+	}
+
+	std::vector<unsigned char> serialize(const TileRequest& request)
+	{
+		MessageWriter writer{MessageType::tileRequest};
+		writer.writeUint32(request.tileId);
+		writer.writeInt32(request.offset.x);
+		writer.writeInt32(request.offset.y);
+		writer.writeInt32(request.size.x);
+		writer.writeInt32(request.size.y);
+		writeSettings(writer, request.settings);
+		return std::move(writer.getMessage());
+	}
+
+	std::vector<unsigned char> serialize(const TileResponse& response)
+	{
+		MessageWriter writer{MessageType::tile};
+		writer.writeUint32(response.tileId);
+		writer.writeInt32(response.offset.x);
+		writer.writeInt32(response.offset.y);
+		writer.writeInt32(response.size.x);
+		writer.writeInt32(response.size.y);
+		writer.writeUint32(response.renderTimeUs);
+		writer.writeBytes(response.pixels);
+		return std::move(writer.getMessage());
+	}
+
+	std::vector<unsigned char> serialize(const ViewerCommand& command)
+	{
+		MessageWriter writer{MessageType::viewerCommand};
+		writer.writeUint32(command.sequence);
+		writeSettings(writer, command.settings);
+		return std::move(writer.getMessage());
+	}
+
+	std::vector<unsigned char> serialize(const FrameDelta& frame)
+	{
+		MessageWriter writer{MessageType::frameDelta};
+		writer.writeUint32(frame.frameId);
+		writer.writeUint32(frame.commandSequence);
+		writer.writeUint8(frame.isConverged ? 1 : 0);
+		writer.writeInt32(frame.resolution.x);
+		writer.writeInt32(frame.resolution.y);
+		writer.writeInt32(frame.tileSize);
+		writer.writeUint32(static_cast<std::uint32_t>(frame.tiles.size()));
+		for (const DeltaTile& tile : frame.tiles)
+		{
+			writer.writeUint32(tile.index);
+			writer.writeUint8(tile.filter);
+			writer.writeBytes(tile.data);
+		}
+		return std::move(writer.getMessage());
+	}
+
+	std::optional<RenderRequest> parseRenderRequest(const std::vector<unsigned char>& message)
+	{
+		MessageReader reader{message, MessageType::renderRequest};
+		RenderRequest request{};
+		request.jobId = reader.readUint32();
+		request.priority = reader.readInt32();
+		request.format = static_cast<FrameFormat>(reader.readUint8());
+		request.settings = readSettings(reader);
+		if (!reader.isValid())
+		{
+			return std::nullopt;
+		}
+		return request;
+	}
+
+	std::optional<CancelRequest> parseCancelRequest(const std::vector<unsigned char>& message)
+	{
+		MessageReader reader{message, MessageType::cancelRequest};
+		CancelRequest request{};
+		request.jobId = reader.readUint32();
+		if (!reader.isValid())
+		{
+			return std::nullopt;
+		}
+		return request;
+	}
+
+	std::optional<FrameResponse> parseFrameResponse(const std::vector<unsigned char>& message)
+	{
+		MessageReader reader{message, MessageType::frame};
+		FrameResponse response{};
+		response.jobId = reader.readUint32();
+		response.format = static_cast<FrameFormat>(reader.readUint8());
+		response.resolution.x = reader.readInt32();
+		response.resolution.y = reader.readInt32();
+		response.renderTimeUs = reader.readUint32();
+		response.data = reader.readBytes();
+		if (!reader.isValid())
+		{
+			return std::nullopt;
+		}
+		return response;
+	}
+
+	std::optional<StatusResponse> parseStatusResponse(const std::vector<unsigned char>& message)
+	{
+		std::optional<MessageType> type = getMessageType(message);
+		if (type != MessageType::cancelled && type != MessageType::error)
+		{
+			return std::nullopt;
+		}
+
+		MessageReader reader{message, *type};
+		StatusResponse response{};
+		response.type = *type;
+		response.jobId = reader.readUint32();
+		std::vector<unsigned char> text = reader.readBytes();
+		response.message.assign(text.begin(), text.end());
+		if (!reader.isValid())
+		{
+			return std::nullopt;
+		}
+		return response;
+	}
+
+	std::optional<TileRequest> parseTileRequest(const std::vector<unsigned char>& message)
+	{
+		MessageReader reader{message, MessageType::tileRequest};
+		TileRequest request{};
+		request.tileId = reader.readUint32();
+		request.offset.x = reader.readInt32();
+		request.offset.y = reader.readInt32();
+		request.size.x = reader.readInt32();
+		request.size.y = reader.readInt32();
+		request.settings = readSettings(reader);
+		if (!reader.isValid())
+		{
+			return std::nullopt;
+		}
+		return request;
+	}
+
+	std::optional<TileResponse> parseTileResponse(const std::vector<unsigned char>& message)
+	{
+		MessageReader reader{message, MessageType::tile};
+		TileResponse response{};
+		response.tileId = reader.readUint32();
+		response.offset.x = reader.readInt32();
+		response.offset.y = reader.readInt32();
+		response.size.x = reader.readInt32();
+		response.size.y = reader.readInt32();
+		response.renderTimeUs = reader.readUint32();
+		response.pixels = reader.readBytes();
+		if (!reader.isValid())
+		{
+			return std::nullopt;
+		}
+		return response;
+	}
+
+	std::optional<ViewerCommand> parseViewerCommand(const std::vector<unsigned char>& message)
+	{
+		MessageReader reader{message, MessageType::viewerCommand};
+		ViewerCommand command{};
+		command.sequence = reader.readUint32();
+		command.settings = readSettings(reader);
+		if (!reader.isValid())
+		{
+			return std::nullopt;
+		}
+		return command;
+	}
+
+	std::optional<FrameDelta> parseFrameDelta(const std::vector<unsigned char>& message)
+	{
+		MessageReader reader{message, MessageType::frameDelta};
+		FrameDelta frame{};
+		frame.frameId = reader.readUint32();
+		frame.commandSequence = reader.readUint32();
+		frame.isConverged = reader.readUint8() != 0;
+		frame.resolution.x = reader.readInt32();
+		frame.resolution.y = reader.readInt32();
+		frame.tileSize = reader.readInt32();
+		std::uint32_t tileCount = reader.readUint32();
+		for (std::uint32_t i = 0; i < tileCount && reader.hasRemaining(); ++i)
+		{
+			DeltaTile tile{};
+			tile.index = reader.readUint32();
+			tile.filter = reader.readUint8();
+			tile.data = reader.readBytes();
+			frame.tiles.push_back(std::move(tile));
+		}
+		if (!reader.isValid())
+		{
+			return std::nullopt;
+		}
+		return frame;
+	}
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "renderSettings.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Protocol
+{
+	enum class MessageType : std::uint8_t
+	{
+		renderRequest = 1,
+		cancelRequest = 2,
+		frame = 3,
+		cancelled = 4,
+		error = 5,
+		tileRequest = 6,
+		tile = 7,
+		viewerCommand = 8,
+		frameDelta = 9
+	};
+
+	enum class FrameFormat : std::uint8_t
+	{
+		raw = 0,
+		png = 1
+	};
+
+	struct RenderRequest
+	{
+		std::uint32_t jobId{};
+		std::int32_t priority{};
+		FrameFormat format = FrameFormat::raw;
+		RenderSettings settings{};
+	};
+
+	struct CancelRequest
+	{
+		std::uint32_t jobId{};
+	};
+
+	struct FrameResponse
+	{
+		std::uint32_t jobId{};
+		FrameFormat format = FrameFormat::raw;
+		glm::ivec2 resolution{};
+		std::uint32_t renderTimeUs{};
+		std::vector<unsigned char> data{};
+	};
+
+	struct StatusResponse
+	{
+		MessageType type = MessageType::error;
+		std::uint32_t jobId{};
+		std::string message{};
+	};
+
+	struct TileRequest
+	{
+		std::uint32_t tileId{};
+		glm::ivec2 offset{};
+		glm::ivec2 size{};
+		RenderSettings settings{};
+	};
+
+	struct TileResponse
+	{
+		std::uint32_t tileId{};
+		glm::ivec2 offset{};
+		glm::ivec2 size{};
+		std::uint32_t renderTimeUs{};
+		std::vector<unsigned char> pixels{};
+	};
+
+	struct ViewerCommand
+	{
+		std::uint32_t sequence{};
+		RenderSettings settings{};
+	};
+
+	struct DeltaTile
+	{
+		std::uint32_t index{};
+		std::uint8_t filter{};
+		std::vector<unsigned char> data{};
+	};
+
+	struct FrameDelta
+	{
+		std::uint32_t frameId{};
+		std::uint32_t commandSequence{};
+		bool isConverged{};
+		glm::ivec2 resolution{};
+		std::int32_t tileSize{};
+		std::vector<DeltaTile> tiles{};
+	};
+
+	std::optional<MessageType> getMessageType(const std::vector<unsigned char>& message);
+
+	std::vector<unsigned char> serialize(const RenderRequest& request);
+	std::vector<unsigned char> serialize(const CancelRequest& request);
+	std::vector<unsigned char> serialize(const FrameResponse& response);
+	std::vector<unsigned char> serialize(const StatusResponse& response);
+	std::vector<unsigned char> serialize(const TileRequest& request);
+	std::vector<unsigned char> serialize(const TileResponse& response);
+	std::vector<unsigned char> serialize(const ViewerCommand& command);
+	std::vector<unsigned char> serialize(const FrameDelta& frame);
+
+	std::optional<RenderRequest> parseRenderRequest(const std::vector<unsigned char>& message);
+	std::optional<CancelRequest> parseCancelRequest(const std::vector<unsigned char>& message);
+	std::optional<FrameResponse> parseFrameResponse(const std::vector<unsigned char>& message);
+	std::optional<StatusResponse> parseStatusResponse(const std::vector<unsigned char>& message);
+	std::optional<TileRequest> parseTileRequest(const std::vector<unsigned char>& message);
+	std::optional<TileResponse> parseTileResponse(const std::vector<unsigned char>& message);
+	std::optional<ViewerCommand> parseViewerCommand(const std::vector<unsigned char>& message);
+	std::optional<FrameDelta> parseFrameDelta(const std::vector<unsigned char>& message);
+}
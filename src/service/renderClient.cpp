@@ -0,0 +1,99 @@
+#include "service/renderClient.hpp"
+
+#include <fstream>
+#include <iostream>
+
+RenderClient::RenderClient(const std::string& socketPath) :
+	m_socket{Socket::connectUnix(socketPath)}
+{ }
+
+bool RenderClient::isConnected() const
+{
+	return m_socket.isValid();
+}
+
+bool RenderClient::submit(const Protocol::RenderRequest& request) const
+{
+	return m_socket.sendMessage(Protocol::serialize(request));
+}
+
+bool RenderClient::cancel(std::uint32_t jobId) const
+{
+	return m_socket.sendMessage(Protocol::serialize(Protocol::CancelRequest{jobId}));
+}
+
+std::optional<RenderClient::Response> RenderClient::receive() const
+{
+	std::vector<unsigned char> message{};
+	if (!m_socket.receiveMessage(message))
+	{
+		return std::nullopt;
+	}
+
+	if (std::optional<Protocol::FrameResponse> frame = Protocol::parseFrameResponse(message))
+	{
+		return std::move(*frame);
+	}
+	if (std::optional<Protocol::StatusResponse> status = Protocol::parseStatusResponse(message))
+	{
+		return std::move(*status);
+	}
+	return std::nullopt;
+}
+
+Protocol::RenderRequest RenderClient::parseRequest(const CommandLine& commandLine)
+{
+	Protocol::RenderRequest request{};
+	request.jobId = static_cast<std::uint32_t>(commandLine.getInt("job-id", 0));
+	request.priority = commandLine.getInt("priority", 0);
+	request.format = commandLine.getString("format", "png") == "raw" ?
+		Protocol::FrameFormat::raw : Protocol::FrameFormat::png;
+	request.settings = RenderSettings::fromCommandLine(commandLine);
+	return request;
+}
+
+int RenderClient::run(const CommandLine& commandLine)
+{
+	RenderClient client{commandLine.getString("socket", "ellipsoid-raycasting.sock")};
+	if (!client.isConnected())
+	{
+		return 1;
+	}
+
+	Protocol::RenderRequest request = parseRequest(commandLine);
+	if (!client.submit(request))
+	{
+		std::cerr << "Error sending render request\n";
+		return 1;
+	}
+
+	std::optional<Response> response = client.receive();
+	if (!response.has_value())
+	{
+		std::cerr << "Connection closed by render service\n";
+		return 1;
+	}
+	if (const Protocol::StatusResponse* status = std::get_if<Protocol::StatusResponse>(&*response))
+	{
+		std::cerr << "Job " << status->jobId << (status->type == Protocol::MessageType::cancelled ?
+			" cancelled" : " failed: " + status->message) << '\n';
+		return 1;
+	}
+
+	const Protocol::FrameResponse& frame = std::get<Protocol::FrameResponse>(*response);
+	std::string outputPath = commandLine.getString("output",
+		frame.format == Protocol::FrameFormat::png ? "frame.png" : "frame.rgb");
+	std::ofstream file{outputPath, std::ios::binary};
+	file.write(reinterpret_cast<const char*>(frame.data.data()),
+		static_cast<std::streamsize>(frame.data.size()));
+	if (!file)
+	{
+		std::cerr << "Error writing file:\n" << outputPath << '\n';
+		return 1;
+	}
+
+	std::cout << "Job " << frame.jobId << ": " << frame.resolution.x << 'x' <<
+		frame.resolution.y << " rendered in " << frame.renderTimeUs / 1000.0 <<
+		" ms, written to " << outputPath << '\n';
+	return 0;
+}
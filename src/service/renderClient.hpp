@@ -0,0 +1,29 @@
+#pragma once
+
+#include "commandLine.hpp"
+#include "network/socket.hpp"
+#include "service/protocol.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <variant>
+
+class RenderClient
+{
+public:
+	using Response = std::variant<Protocol::FrameResponse, Protocol::StatusResponse>;
+
+	RenderClient(const std::string& socketPath);
+
+	bool isConnected() const;
+	bool submit(const Protocol::RenderRequest& request) const;
+	bool cancel(std::uint32_t jobId) const;
+	std::optional<Response> receive() const;
+
+	static Protocol::RenderRequest parseRequest(const CommandLine& commandLine);
+	static int run(const CommandLine& commandLine);
+
+private:
+	Socket m_socket;
+};
@@ -0,0 +1,259 @@
+#include "service/renderService.hpp"
+
+#include "pngEncoder.hpp"
+#include "raycaster.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <utility>
+
+constexpr int bandRowCount = 16;
+
+static bool isFinite(const glm::vec3& vector)
+{
+	return std::isfinite(vector.x) && std::isfinite(vector.y) && std::isfinite(vector.z);
+}
+
+RenderService::RenderService(const std::string& socketPath, int threadCount,
+	std::size_t frameCacheBytes, const std::filesystem::path& frameCacheDirectory) :
+	m_listenSocket{Socket::listenUnix(socketPath)},
+	m_threadPool{threadCount},
+	m_camera{m_viewportSize, Camera::defaultNearPlane, Camera::defaultFarPlane,
+		Camera::defaultViewWidth},
+	m_renderer{m_viewportSize},
+	m_frameCache{frameCacheBytes, frameCacheDirectory}
+{
+	m_renderThread = std::thread{&RenderService::processJobs, this};
+}
+
+RenderService::~RenderService()
+{
+	m_jobQueue.stop();
+	m_renderThread.join();
+}
+
+int RenderService::run()
+{
+	if (!m_listenSocket.isValid())
+	{
+		return 1;
+	}
+
+	std::cout << "Render service listening with " << m_threadPool.getThreadCount() <<
+		" threads\n";
+	while (true)
+	{
+		Socket socket = m_listenSocket.accept();
+		if (!socket.isValid())
+		{
+			continue;
+		}
+
+		auto connection = std::make_shared<ClientConnection>(std::move(socket));
+		std::thread{&RenderService::serveConnection, this, connection}.detach();
+	}
+}
+
+void RenderService::serveConnection(const std::shared_ptr<ClientConnection>& connection)
+{
+	std::vector<unsigned char> message{};
+	while (connection->receive(message))
+	{
+		std::optional<Protocol::MessageType> type = Protocol::getMessageType(message);
+		if (type == Protocol::MessageType::renderRequest)
+		{
+			std::optional<Protocol::RenderRequest> request = Protocol::parseRenderRequest(message);
+			if (!request.has_value())
+			{
+				connection->send(Protocol::serialize(Protocol::StatusResponse
+					{Protocol::MessageType::error, 0, "malformed render request"}));
+				continue;
+			}
+
+			std::optional<std::string> error = validate(*request);
+			if (error.has_value())
+			{
+				connection->send(Protocol::serialize(Protocol::StatusResponse
+					{Protocol::MessageType::error, request->jobId, *error}));
+				continue;
+			}
+
+			auto job = std::make_shared<RenderJob>();
+			job->request = *request;
+			job->connection = connection;
+			m_jobQueue.push(job);
+		}
+		else if (type == Protocol::MessageType::cancelRequest)
+		{
+			std::optional<Protocol::CancelRequest> request = Protocol::parseCancelRequest(message);
+			if (!request.has_value())
+			{
+				continue;
+			}
+
+			std::shared_ptr<RenderJob> cancelledJob =
+				m_jobQueue.cancel(connection.get(), request->jobId);
+			if (cancelledJob)
+			{
+				connection->send(Protocol::serialize(Protocol::StatusResponse
+					{Protocol::MessageType::cancelled, request->jobId, {}}));
+			}
+		}
+		else
+		{
+			connection->send(Protocol::serialize(Protocol::StatusResponse
+				{Protocol::MessageType::error, 0, "unexpected message"}));
+		}
+	}
+
+	m_jobQueue.cancelAll(connection.get());
+	connection->close();
+}
+
+void RenderService::processJobs()
+{
+	while (std::shared_ptr<RenderJob> job = m_jobQueue.pop())
+	{
+		processJob(*job);
+		m_jobQueue.finish(job);
+	}
+}
+
+void RenderService::processJob(RenderJob& job)
+{
+	using Clock = std::chrono::steady_clock;
+
+	const Protocol::RenderRequest& request = job.request;
+	Clock::time_point start = Clock::now();
+	if (!renderFrame(job))
+	{
+		job.connection->send(Protocol::serialize(Protocol::StatusResponse
+			{Protocol::MessageType::cancelled, request.jobId, {}}));
+		return;
+	}
+
+	Protocol::FrameResponse response{};
+	response.jobId = request.jobId;
+	response.format = request.format;
+	response.resolution = request.settings.resolution;
+	response.data = encodeFrame(request.format);
+	response.renderTimeUs = static_cast<std::uint32_t>(
+		std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+	job.connection->send(Protocol::serialize(response));
+}
+
+bool RenderService::renderFrame(RenderJob& job)
+{
+	const Protocol::RenderRequest& request = job.request;
+
+	if (m_viewportSize != request.settings.resolution)
+	{
+		m_viewportSize = request.settings.resolution;
+		m_renderer.updateViewportSize();
+	}
+	request.settings.apply(m_camera, m_ellipsoid);
+
+	Raycaster raycaster{m_camera, m_ellipsoid};
+	std::uint64_t cacheKey = FrameCache::calcKey(raycaster, m_viewportSize,
+		request.settings.antialiasingSamples, m_renderer.isLightCullingEnabled());
+	std::shared_ptr<const FrameCache::Entry> cachedFrame = m_frameCache.find(cacheKey, true);
+	if (cachedFrame != nullptr && cachedFrame->size == m_viewportSize)
+	{
+		m_renderer.load(cachedFrame->pixels, cachedFrame->hitMask, m_threadPool);
+		return true;
+	}
+
+	constexpr int pixelSize = 1;
+	int rowCount = m_renderer.getRowCount(pixelSize);
+	m_renderer.touchPages(m_threadPool);
+	m_renderer.resetEdgeSegments();
+	m_threadPool.parallelFor((rowCount + bandRowCount - 1) / bandRowCount,
+		[this, &job, &raycaster, rowCount] (int band)
+		{
+			if (job.isCancelled)
+			{
+				return;
+			}
+			m_renderer.drawRows(raycaster, pixelSize, true, band * bandRowCount,
+				std::min((band + 1) * bandRowCount, rowCount));
+		}
+	);
+	if (job.isCancelled)
+	{
+		return false;
+	}
+
+	if (request.settings.antialiasingSamples > 1)
+	{
+		m_renderer.antialias(raycaster, request.settings.antialiasingSamples, m_threadPool);
+	}
+
+	m_frameCache.insert(cacheKey, m_viewportSize, m_renderer.getCpuTexture(),
+		m_renderer.getHitMask());
+	return !job.isCancelled;
+}
+
+std::vector<unsigned char> RenderService::encodeFrame(Protocol::FrameFormat format) const
+{
+	std::span<const unsigned char> cpuTexture = m_renderer.getCpuTexture();
+	if (format == Protocol::FrameFormat::png)
+	{
+		return PngEncoder::encode(cpuTexture.data(), m_viewportSize);
+	}
+
+	std::size_t rowSize = static_cast<std::size_t>(m_viewportSize.x) * Renderer::numOfChannels;
+	std::vector<unsigned char> frame(cpuTexture.size());
+	for (int y = 0; y < m_viewportSize.y; ++y)
+	{
+		std::copy_n(cpuTexture.begin() + y * rowSize, rowSize,
+			frame.begin() + (m_viewportSize.y - 1 - y) * rowSize);
+	}
+	return frame;
+}
+
+std::optional<std::string> RenderService::validate(const RenderSettings& settings)
+{
+	if (settings.resolution.x <= 0 || settings.resolution.y <= 0 ||
+		settings.resolution.x > maxResolution.x || settings.resolution.y > maxResolution.y)
+	{
+		return "invalid resolution";
+	}
+	if (!isFinite(settings.radii) || settings.radii.x <= 0 || settings.radii.y <= 0 ||
+		settings.radii.z <= 0)
+	{
+		return "invalid ellipsoid radii";
+	}
+	if (!isFinite(settings.camera.targetPos) || !std::isfinite(settings.camera.pitchRad) ||
+		!std::isfinite(settings.camera.yawRad))
+	{
+		return "invalid camera";
+	}
+	if (!std::isfinite(settings.camera.viewWidth) || settings.camera.viewWidth <= 0)
+	{
+		return "invalid view width";
+	}
+	if (!settings.material.isValid())
+	{
+		return "invalid material";
+	}
+	if (settings.antialiasingSamples < 1 || settings.antialiasingSamples > maxAntialiasingSamples)
+	{
+		return "invalid antialiasing samples";
+	}
+	return std::nullopt;
+}
+
+std::optional<std::string> RenderService::validate(const Protocol::RenderRequest& request) const
+{
+	if (request.format != Protocol::FrameFormat::raw &&
+		request.format != Protocol::FrameFormat::png)
+	{
+		return "invalid frame format";
+	}
+	return validate(request.settings);
+}
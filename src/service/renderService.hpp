@@ -0,0 +1,58 @@
+#pragma once
+
+#include "camera.hpp"
+#include "ellipsoid.hpp"
+#include "frameCache.hpp"
+#include "network/socket.hpp"
+#include "renderSettings.hpp"
+#include "renderer.hpp"
+#include "service/clientConnection.hpp"
+#include "service/jobQueue.hpp"
+#include "service/protocol.hpp"
+#include "threadPool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <renderSettings.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+class RenderService
+{
+public:
+	static constexpr glm::ivec2 maxResolution{16384, 16384};
+	static constexpr int maxAntialiasingSamples = 8;
+
+	RenderService(const std::string& socketPath, int threadCount,
+		std::size_t frameCacheBytes = FrameCache::defaultCapacityBytes,
+		const std::filesystem::path& frameCacheDirectory = {});
+	~RenderService();
+
+	int run();
+
+	static std::optional<std::string> validate(const RenderSettings& settings);
+
+private:
+	Socket m_listenSocket;
+	ThreadPool m_threadPool;
+	JobQueue m_jobQueue{};
+	std::thread m_renderThread{};
+
+	glm::ivec2 m_viewportSize{1, 1};
+	Camera m_camera;
+	Ellipsoid m_ellipsoid{4.0f, 2.0f, 8.0f};
+	Renderer m_renderer;
+	FrameCache m_frameCache;
+
+	void serveConnection(const std::shared_ptr<ClientConnection>& connection);
+	void processJobs();
+	void processJob(RenderJob& job);
+	bool renderFrame(RenderJob& job);
+	std::vector<unsigned char> encodeFrame(Protocol::FrameFormat format) const;
+	std::optional<std::string> validate(const Protocol::RenderRequest& request) const;
+};
@@ -1,39 +1,62 @@
 #include "shaderProgram.hpp"
 
+#include "userCache.hpp"
+
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <sstream>
+#include <string_view>
+#include <system_error>
 
 static constexpr std::size_t errorLogSize = 512;
+static constexpr std::string_view arraySuffix = "[0]";
+static constexpr std::string_view binaryCacheDirectory = "ellipsoid-raycasting-shader-cache";
+static constexpr std::uint64_t fnvOffsetBasis = 14695981039346656037ull;
+static constexpr std::uint64_t fnvPrime = 1099511628211ull;
+
+static std::uint64_t hashString(std::string_view text, std::uint64_t hash)
+{
+	for (char character : text)
+	{
+		hash = (hash ^ static_cast<unsigned char>(character)) * fnvPrime;
+	}
+	return hash;
+}
 
-ShaderProgram::ShaderProgram(const std::string& vertexShaderPath,
-	const std::string& fragmentShaderPath) :
+ShaderProgram::ShaderProgram(const std::string& name, const std::string& vertexShaderSource,
+	const std::string& fragmentShaderSource) :
 	ShaderProgram
 	{
-		{vertexShaderPath, fragmentShaderPath},
+		name,
+		{vertexShaderSource, fragmentShaderSource},
 		{GL_VERTEX_SHADER, GL_FRAGMENT_SHADER}
 	}
 { }
 
-ShaderProgram::ShaderProgram(const std::string& vertexShaderPath,
-	const std::string& geometryShaderPath, const std::string& fragmentShaderPath) :
+ShaderProgram::ShaderProgram(const std::string& name, const std::string& vertexShaderSource,
+	const std::string& geometryShaderSource, const std::string& fragmentShaderSource) :
 	ShaderProgram
 	{
-		{vertexShaderPath, geometryShaderPath, fragmentShaderPath},
+		name,
+		{vertexShaderSource, geometryShaderSource, fragmentShaderSource},
 		{GL_VERTEX_SHADER, GL_GEOMETRY_SHADER, GL_FRAGMENT_SHADER}
 	}
 { }
 
-ShaderProgram::ShaderProgram(const std::string& vertexShaderPath,
-	const std::string& tessCtrlShaderPath, const std::string& tessEvalShaderPath,
-	const std::string& fragmentShaderPath) :
+ShaderProgram::ShaderProgram(const std::string& name, const std::string& vertexShaderSource,
+	const std::string& tessCtrlShaderSource, const std::string& tessEvalShaderSource,
+	const std::string& fragmentShaderSource) :
 	ShaderProgram
 	{
-		{vertexShaderPath, tessCtrlShaderPath, tessEvalShaderPath, fragmentShaderPath},
+		name,
+		{vertexShaderSource, tessCtrlShaderSource, tessEvalShaderSource, fragmentShaderSource},
 		{GL_VERTEX_SHADER, GL_TESS_CONTROL_SHADER, GL_TESS_EVALUATION_SHADER, GL_FRAGMENT_SHADER}
 	}
 { }
@@ -48,71 +71,128 @@ void ShaderProgram::use() const
 	glUseProgram(m_id);
 }
 
-void ShaderProgram::setUniform(const std::string& name, bool value) const
+bool ShaderProgram::isLoadedFromCache() const
+{
+	return m_isLoadedFromCache;
+}
+
+void ShaderProgram::setUniform(std::string_view name, bool value) const
+{
+	glUniform1i(getUniformLocation(name), static_cast<int>(value));
+}
+
+void ShaderProgram::setUniform(std::string_view name, int value) const
 {
-	glUniform1i(glGetUniformLocation(m_id, name.c_str()), static_cast<int>(value));
+	glUniform1i(getUniformLocation(name), value);
 }
 
-void ShaderProgram::setUniform(const std::string& name, int value) const
+void ShaderProgram::setUniform(std::string_view name, float value) const
 {
-	glUniform1i(glGetUniformLocation(m_id, name.c_str()), value);
+	glUniform1f(getUniformLocation(name), value);
 }
 
-void ShaderProgram::setUniform(const std::string& name, float value) const
+void ShaderProgram::setUniform(std::string_view name, const glm::ivec2& value) const
 {
-	glUniform1f(glGetUniformLocation(m_id, name.c_str()), value);
+	glUniform2iv(getUniformLocation(name), 1, glm::value_ptr(value));
 }
 
-void ShaderProgram::setUniform(const std::string& name, const glm::ivec2& value) const
+void ShaderProgram::setUniform(std::string_view name, const glm::vec2& value) const
 {
-	glUniform2iv(glGetUniformLocation(m_id, name.c_str()), 1, glm::value_ptr(value));
+	glUniform2fv(getUniformLocation(name), 1, glm::value_ptr(value));
 }
 
-void ShaderProgram::setUniform(const std::string& name, const glm::vec2& value) const
+void ShaderProgram::setUniform(std::string_view name, const glm::vec3& value) const
 {
-	glUniform2fv(glGetUniformLocation(m_id, name.c_str()), 1, glm::value_ptr(value));
+	glUniform3fv(getUniformLocation(name), 1, glm::value_ptr(value));
 }
 
-void ShaderProgram::setUniform(const std::string& name, const glm::vec3& value) const
+void ShaderProgram::setUniform(std::string_view name, const glm::vec4& value) const
 {
-	glUniform3fv(glGetUniformLocation(m_id, name.c_str()), 1, glm::value_ptr(value));
+	glUniform4fv(getUniformLocation(name), 1, glm::value_ptr(value));
 }
 
-void ShaderProgram::setUniform(const std::string& name, const glm::vec4& value) const
+void ShaderProgram::setUniform(std::string_view name, const std::vector<glm::vec4>& values) const
 {
-	glUniform4fv(glGetUniformLocation(m_id, name.c_str()), 1, glm::value_ptr(value));
+	if (values.empty())
+	{
+		return;
+	}
+	glUniform4fv(getUniformLocation(name), static_cast<GLsizei>(values.size()),
+		glm::value_ptr(values[0]));
 }
 
-void ShaderProgram::setUniform(const std::string& name, const glm::mat3& value) const
+void ShaderProgram::setUniform(std::string_view name, const glm::mat3& value) const
 {
-	glUniformMatrix3fv(glGetUniformLocation(m_id, name.c_str()), 1, GL_FALSE,
+	glUniformMatrix3fv(getUniformLocation(name), 1, GL_FALSE,
 		glm::value_ptr(value));
 }
 
-void ShaderProgram::setUniform(const std::string& name, const glm::mat4& value) const
+void ShaderProgram::setUniform(std::string_view name, const glm::mat4& value) const
 {
-	glUniformMatrix4fv(glGetUniformLocation(m_id, name.c_str()), 1, GL_FALSE,
+	glUniformMatrix4fv(getUniformLocation(name), 1, GL_FALSE,
 		glm::value_ptr(value));
 }
 
-ShaderProgram::ShaderProgram(const std::vector<std::string>& shaderPaths,
-	const std::vector<GLenum>& shaderTypes)
+ShaderProgram::ShaderProgram(const std::string& name,
+	const std::vector<std::string>& shaderSources, const std::vector<GLenum>& shaderTypes)
 {
-	std::vector<unsigned int> shaders{};
-	for (int i = 0; i < shaderPaths.size(); ++i)
+	std::filesystem::path cachePath = getBinaryCachePath(name, shaderSources);
+	m_id = loadProgramBinary(cachePath);
+	m_isLoadedFromCache = m_id != 0;
+	if (!m_isLoadedFromCache)
 	{
-		shaders.push_back(createShader(shaderPaths[i], shaderTypes[i]));
+		std::vector<unsigned int> shaders{};
+		for (int i = 0; i < shaderSources.size(); ++i)
+		{
+			shaders.push_back(createShader(shaderSources[i], shaderTypes[i]));
+		}
+		m_id = createShaderProgram(shaders);
+		deleteShaders(shaders);
+		saveProgramBinary(m_id, cachePath);
 	}
-	m_id = createShaderProgram(shaders);
-	deleteShaders(shaders);
+	loadUniformLocations();
+}
+
+int ShaderProgram::getUniformLocation(std::string_view name) const
+{
+	auto location = m_uniformLocations.find(name);
+	return location != m_uniformLocations.end() ? location->second : -1;
 }
 
-unsigned int ShaderProgram::createShader(const std::string& shaderPath, GLenum shaderType)
+void ShaderProgram::loadUniformLocations()
 {
-	std::string shaderCode = readShaderFile(shaderPath);
+	int uniformCount{};
+	glGetProgramiv(m_id, GL_ACTIVE_UNIFORMS, &uniformCount);
+	int maxNameLength{};
+	glGetProgramiv(m_id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+	std::vector<char> nameBuffer(std::max(maxNameLength, 1));
+	for (int i = 0; i < uniformCount; ++i)
+	{
+		GLsizei nameLength{};
+		GLint size{};
+		GLenum type{};
+		glGetActiveUniform(m_id, i, static_cast<GLsizei>(nameBuffer.size()), &nameLength, &size,
+			&type, nameBuffer.data());
+		std::string name(nameBuffer.data(), nameLength);
+		int location = glGetUniformLocation(m_id, name.c_str());
+		if (location < 0)
+		{
+			continue;
+		}
+
+		m_uniformLocations[name] = location;
+		if (name.ends_with(arraySuffix))
+		{
+			m_uniformLocations[name.substr(0, name.size() - arraySuffix.size())] = location;
+		}
+	}
+}
 
+unsigned int ShaderProgram::createShader(const std::string& shaderSource, GLenum shaderType)
+{
 	unsigned int shader = glCreateShader(shaderType);
-	const char* shaderCodeCStr = shaderCode.c_str();
+	const char* shaderCodeCStr = shaderSource.c_str();
 	glShaderSource(shader, 1, &shaderCodeCStr, NULL);
 	glCompileShader(shader);
 	int success{};
@@ -131,6 +211,7 @@ unsigned int ShaderProgram::createShaderProgram(const std::vector<unsigned int>&
 	{
 		glAttachShader(shaderProgram, shader);
 	}
+	glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 	glLinkProgram(shaderProgram);
 	int success{};
 	glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
@@ -149,26 +230,84 @@ void ShaderProgram::deleteShaders(const std::vector<unsigned int>& shaders)
 	}
 }
 
-std::string ShaderProgram::readShaderFile(const std::string& shaderPath)
+std::filesystem::path ShaderProgram::getBinaryCachePath(const std::string& name,
+	const std::vector<std::string>& shaderSources)
 {
-	std::string shaderCode{};
+	std::uint64_t hash = fnvOffsetBasis;
+	for (GLenum property : {GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION})
+	{
+		const GLubyte* value = glGetString(property);
+		hash = hashString(value != nullptr ? reinterpret_cast<const char*>(value) : "", hash);
+	}
+	for (const std::string& shaderSource : shaderSources)
+	{
+		hash = hashString(shaderSource, hash);
+	}
+
+	std::ostringstream fileName{};
+	fileName << name << '-' << std::hex << hash << ".bin";
+	return UserCache::getDirectory(binaryCacheDirectory) / fileName.str();
+}
+
+unsigned int ShaderProgram::loadProgramBinary(const std::filesystem::path& cachePath)
+{
+	std::ifstream file{cachePath, std::ios::binary};
+	std::uint32_t binaryFormat{};
+	if (!file.read(reinterpret_cast<char*>(&binaryFormat), sizeof(binaryFormat)))
+	{
+		return 0;
+	}
+	std::vector<char> binary{std::istreambuf_iterator<char>{file}, {}};
+	if (binary.empty())
+	{
+		return 0;
+	}
 
-	try
+	unsigned int programId = glCreateProgram();
+	glProgramBinary(programId, binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+	int success{};
+	glGetProgramiv(programId, GL_LINK_STATUS, &success);
+	if (!success)
 	{
-		std::ifstream file{};
-		file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-		std::stringstream stream{};
-		file.open(shaderPath);
-		stream << file.rdbuf();
-		file.close();
-		shaderCode = stream.str();
+		glDeleteProgram(programId);
+		return 0;
 	}
-	catch (std::ifstream::failure)
+	return programId;
+}
+
+void ShaderProgram::saveProgramBinary(unsigned int programId,
+	const std::filesystem::path& cachePath)
+{
+	int success{};
+	glGetProgramiv(programId, GL_LINK_STATUS, &success);
+	int binaryLength{};
+	glGetProgramiv(programId, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+	if (!success || binaryLength <= 0)
 	{
-		std::cerr << "Error reading file:\n" << shaderPath << '\n';
+		return;
 	}
 
-	return shaderCode;
+	std::vector<char> binary(binaryLength);
+	GLenum binaryFormat{};
+	glGetProgramBinary(programId, binaryLength, nullptr, &binaryFormat, binary.data());
+
+	std::error_code error{};
+	std::filesystem::create_directories(cachePath.parent_path(), error);
+	std::filesystem::path tempPath = cachePath;
+	tempPath += ".tmp";
+	{
+		std::ofstream file{tempPath, std::ios::binary | std::ios::trunc};
+		std::uint32_t format = binaryFormat;
+		file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+		file.write(binary.data(), binary.size());
+		if (!file.good())
+		{
+			file.close();
+			std::filesystem::remove(tempPath, error);
+			return;
+		}
+	}
+	std::filesystem::rename(tempPath, cachePath, error);
 }
 
 void ShaderProgram::printCompilationError(unsigned int shader, GLenum shaderType)
@@ -3,17 +3,24 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include <cstddef>
+#include <filesystem>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 class ShaderProgram
 {
 public:
-	ShaderProgram(const std::string& vertexShaderPath, const std::string& fragmentShaderPath);
-	ShaderProgram(const std::string& vertexShaderPath, const std::string& geometryShaderPath,
-		const std::string& fragmentShaderPath);
-	ShaderProgram(const std::string& vertexShaderPath, const std::string& tessCtrlShaderPath,
-		const std::string& tessEvalShaderPath, const std::string& fragmentShaderPath);
+	ShaderProgram(const std::string& name, const std::string& vertexShaderSource,
+		const std::string& fragmentShaderSource);
+	ShaderProgram(const std::string& name, const std::string& vertexShaderSource,
+		const std::string& geometryShaderSource, const std::string& fragmentShaderSource);
+	ShaderProgram(const std::string& name, const std::string& vertexShaderSource,
+		const std::string& tessCtrlShaderSource, const std::string& tessEvalShaderSource,
+		const std::string& fragmentShaderSource);
 	ShaderProgram(const ShaderProgram&) = delete;
 	ShaderProgram(ShaderProgram&&) = delete;
 	~ShaderProgram();
@@ -22,28 +29,49 @@ public:
 	ShaderProgram& operator=(ShaderProgram&&) = delete;
 
 	void use() const;
+	bool isLoadedFromCache() const;
 
-	void setUniform(const std::string& name, bool value) const;
-	void setUniform(const std::string& name, int value) const;
-	void setUniform(const std::string& name, float value) const;
-	void setUniform(const std::string& name, const glm::ivec2& value) const;
-	void setUniform(const std::string& name, const glm::vec2& value) const;
-	void setUniform(const std::string& name, const glm::vec3& value) const;
-	void setUniform(const std::string& name, const glm::vec4& value) const;
-	void setUniform(const std::string& name, const glm::mat3& value) const;
-	void setUniform(const std::string& name, const glm::mat4& value) const;
+	void setUniform(std::string_view name, bool value) const;
+	void setUniform(std::string_view name, int value) const;
+	void setUniform(std::string_view name, float value) const;
+	void setUniform(std::string_view name, const glm::ivec2& value) const;
+	void setUniform(std::string_view name, const glm::vec2& value) const;
+	void setUniform(std::string_view name, const glm::vec3& value) const;
+	void setUniform(std::string_view name, const glm::vec4& value) const;
+	void setUniform(std::string_view name, const std::vector<glm::vec4>& values) const;
+	void setUniform(std::string_view name, const glm::mat3& value) const;
+	void setUniform(std::string_view name, const glm::mat4& value) const;
 
 private:
+	struct StringHash
+	{
+		using is_transparent = void;
+
+		std::size_t operator()(std::string_view value) const
+		{
+			return std::hash<std::string_view>{}(value);
+		}
+	};
+
 	unsigned int m_id{};
+	bool m_isLoadedFromCache = false;
+	std::unordered_map<std::string, int, StringHash, std::equal_to<>> m_uniformLocations{};
 
-	ShaderProgram(const std::vector<std::string>& shaderPaths,
+	ShaderProgram(const std::string& name, const std::vector<std::string>& shaderSources,
 		const std::vector<GLenum>& shaderTypes);
 
-	static unsigned int createShader(const std::string& shaderPath, GLenum shaderType);
+	int getUniformLocation(std::string_view name) const;
+	void loadUniformLocations();
+
+	static unsigned int createShader(const std::string& shaderSource, GLenum shaderType);
 	static unsigned int createShaderProgram(const std::vector<unsigned int>& shaders);
 	static void deleteShaders(const std::vector<unsigned int>& shaders);
 
-	static std::string readShaderFile(const std::string& shaderPath);
+	static std::filesystem::path getBinaryCachePath(const std::string& name,
+		const std::vector<std::string>& shaderSources);
+	static unsigned int loadProgramBinary(const std::filesystem::path& cachePath);
+	static void saveProgramBinary(unsigned int programId, const std::filesystem::path& cachePath);
+
 	static void printCompilationError(unsigned int shaderId, GLenum shaderType);
 	static void printLinkingError(unsigned int programId);
 };
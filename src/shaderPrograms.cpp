@@ -4,17 +4,27 @@
 
 namespace ShaderPrograms
 {
-	std::string path(const std::string& shaderName);
+	const std::string quadVS =
+#include "shaders/quadVS.inc"
+		;
+	const std::string quadFS =
+#include "shaders/quadFS.inc"
+		;
+	const std::string raycastFS =
+#include "shaders/raycastFS.inc"
+		;
 
 	std::unique_ptr<const ShaderProgram> quad{};
+	std::unique_ptr<const ShaderProgram> raycast{};
 
 	void init()
 	{
-		quad = std::make_unique<const ShaderProgram>(path("quadVS"), path("quadFS"));
+		quad = std::make_unique<const ShaderProgram>("quad", quadVS, quadFS);
+		raycast = std::make_unique<const ShaderProgram>("raycast", quadVS, raycastFS);
 	}
 
-	std::string path(const std::string& shaderName)
+	bool areLoadedFromCache()
 	{
-		return "src/shaders/" + shaderName + ".glsl";
+		return quad->isLoadedFromCache() && raycast->isLoadedFromCache();
 	}
 }
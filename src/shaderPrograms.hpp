@@ -7,6 +7,8 @@
 namespace ShaderPrograms
 {
 	void init();
+	bool areLoadedFromCache();
 
 	extern std::unique_ptr<const ShaderProgram> quad;
+	extern std::unique_ptr<const ShaderProgram> raycast;
 }
@@ -3,10 +3,11 @@
 in vec2 texturePos;
 
 uniform sampler2D textureSampler;
+uniform vec2 textureScale;
 
 out vec4 outColor;
 
 void main()
 {
-	outColor = vec4(texture(textureSampler, texturePos).xyz, 1);
+	outColor = vec4(texture(textureSampler, texturePos * textureScale).xyz, 1);
 }
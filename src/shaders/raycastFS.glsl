@@ -0,0 +1,96 @@
+#version 420 core
+
+struct Material
+{
+	vec3 color;
+	float ambientCoef;
+	float diffuseCoef;
+	float specularCoef;
+	float shininess;
+};
+
+const int maxLightCount = 64;
+
+in vec2 texturePos;
+
+uniform mat4 cameraEllipsoidMatrix;
+uniform mat4 cameraMatrix;
+uniform mat4 ellipsoidMatrix;
+uniform vec3 viewVector;
+uniform vec2 viewportSize;
+uniform vec3 backgroundColor;
+uniform Material material;
+uniform int lightCount;
+uniform vec4 lightVectors[maxLightCount];
+uniform vec4 lightColors[maxLightCount];
+
+out vec4 outColor;
+
+vec3 calcPhong(vec3 normalVector)
+{
+	vec3 lightVector = viewVector;
+	float lightNormalCos = dot(lightVector, normalVector);
+	vec3 reflectionVector = 2 * lightNormalCos * normalVector - lightVector;
+	float reflectionViewCos = dot(reflectionVector, viewVector);
+
+	float ambient = material.ambientCoef;
+	float diffuse = lightNormalCos > 0 ? material.diffuseCoef * lightNormalCos : 0;
+	float specular = reflectionViewCos > 0 ?
+		material.specularCoef * pow(reflectionViewCos, material.shininess) : 0;
+	return clamp(trunc((ambient + diffuse + specular) * material.color), 0, 255);
+}
+
+vec3 calcLighting(vec3 point, vec3 normalVector)
+{
+	vec3 intensity = vec3(material.ambientCoef);
+	for (int i = 0; i < lightCount; ++i)
+	{
+		vec3 lightVector = lightVectors[i].xyz - lightVectors[i].w * point;
+		float distanceSquared = dot(lightVector, lightVector);
+		float falloff = 1 - distanceSquared * lightColors[i].w;
+		if (falloff <= 0)
+		{
+			continue;
+		}
+
+		lightVector /= sqrt(distanceSquared);
+		float lightNormalCos = dot(lightVector, normalVector);
+		if (lightNormalCos <= 0)
+		{
+			continue;
+		}
+
+		vec3 reflectionVector = 2 * lightNormalCos * normalVector - lightVector;
+		float reflectionViewCos = dot(reflectionVector, viewVector);
+		float diffuse = material.diffuseCoef * lightNormalCos;
+		float specular = reflectionViewCos > 0 ?
+			material.specularCoef * pow(reflectionViewCos, material.shininess) : 0;
+		intensity += (diffuse + specular) * falloff * falloff * lightColors[i].rgb;
+	}
+	return clamp(trunc(intensity * material.color), 0, 255);
+}
+
+void main()
+{
+	vec2 pos = 2 * texturePos - 1 - 1 / viewportSize;
+	mat4 m = cameraEllipsoidMatrix;
+	float a = m[2][2];
+	float b = (m[2][0] + m[0][2]) * pos.x + (m[2][1] + m[1][2]) * pos.y + m[2][3] + m[3][2];
+	float c = (m[0][0] * pos.x + m[0][1] * pos.y + m[0][3] + m[3][0]) * pos.x +
+		(m[1][0] * pos.x + m[1][1] * pos.y + m[1][3] + m[3][1]) * pos.y + m[3][3];
+
+	float delta = b * b - 4 * a * c;
+	float q = b >= 0 ? -(b + sqrt(max(delta, 0))) / 2 : (sqrt(max(delta, 0)) - b) / 2;
+	float z = b >= 0 ? q / a : c / q;
+	if (delta <= 0 || z < -1 || z > 1)
+	{
+		outColor = vec4(backgroundColor / 255, 1);
+		return;
+	}
+
+	vec3 point = vec3(cameraMatrix * vec4(pos, z, 1));
+	vec3 normalVector = normalize(vec3(ellipsoidMatrix[0][0] * point.x,
+		ellipsoidMatrix[1][1] * point.y, ellipsoidMatrix[2][2] * point.z));
+	vec3 color = lightCount > 0 ? calcLighting(point, normalVector) : calcPhong(normalVector);
+	outColor = vec4(color / 255, 1);
+}
@@ -0,0 +1,141 @@
+#include "speculativeFramePool.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+SpeculativeFramePool::SpeculativeFramePool(int capacity) :
+	m_frames(std::max(capacity, 1))
+{ }
+
+SpeculativeFramePool::Frame* SpeculativeFramePool::find(const CameraState& pose,
+	std::uint64_t sceneKey)
+{
+	for (Frame& frame : m_frames)
+	{
+		if (frame.isValid && frame.sceneKey == sceneKey && frame.pose == pose)
+		{
+			return &frame;
+		}
+	}
+	return nullptr;
+}
+
+const SpeculativeFramePool::Frame* SpeculativeFramePool::findNearest(const CameraState& pose,
+	std::uint64_t sceneKey, float toleranceRad)
+{
+	Frame* nearest{};
+	float nearestError{};
+	bool hasCandidates = false;
+	for (Frame& frame : m_frames)
+	{
+		if (!frame.isValid || frame.pixelSize == 0 || frame.sceneKey != sceneKey ||
+			frame.pose.targetPos != pose.targetPos)
+		{
+			continue;
+		}
+		hasCandidates = true;
+
+		float zoomRatio = frame.pose.viewWidth / pose.viewWidth;
+		float error = std::max(std::abs(frame.pose.pitchRad - pose.pitchRad),
+			std::abs(std::remainder(frame.pose.yawRad - pose.yawRad, 2 * glm::pi<float>())));
+		if (std::max(zoomRatio, 1 / zoomRatio) > maxZoomRatio || error > toleranceRad)
+		{
+			continue;
+		}
+		if (nearest == nullptr || error < nearestError ||
+			(error == nearestError && frame.pixelSize < nearest->pixelSize))
+		{
+			nearest = &frame;
+			nearestError = error;
+		}
+	}
+
+	if (nearest == nullptr)
+	{
+		if (hasCandidates)
+		{
+			++m_stats.missCount;
+		}
+		return nullptr;
+	}
+	++m_stats.hitCount;
+	nearest->isShown = true;
+	nearest->lastUse = ++m_useCount;
+	return nearest;
+}
+
+SpeculativeFramePool::Frame& SpeculativeFramePool::acquire(const CameraState& pose,
+	std::uint64_t sceneKey, const glm::ivec2& size)
+{
+	Frame& frame = *std::min_element(m_frames.begin(), m_frames.end(),
+		[] (const Frame& left, const Frame& right)
+		{
+			return (!left.isValid && right.isValid) ||
+				(left.isValid == right.isValid && left.lastUse < right.lastUse);
+		}
+	);
+	release(frame);
+
+	frame.pose = pose;
+	frame.sceneKey = sceneKey;
+	frame.size = size;
+	frame.pixelSize = 0;
+	frame.renderMs = 0;
+	frame.lastUse = ++m_useCount;
+	frame.isValid = true;
+	frame.isShown = false;
+	++m_stats.frameCount;
+	return frame;
+}
+
+void SpeculativeFramePool::store(Frame& frame, std::span<const unsigned char> pixels,
+	std::span<const unsigned char> hitMask, int pixelSize, double renderMs)
+{
+	frame.pixels.assign(pixels.begin(), pixels.end());
+	frame.hitMask.assign(hitMask.begin(), hitMask.end());
+	frame.pixelSize = pixelSize;
+	frame.renderMs += renderMs;
+	frame.lastUse = ++m_useCount;
+	m_stats.renderMs += renderMs;
+}
+
+void SpeculativeFramePool::clear()
+{
+	for (Frame& frame : m_frames)
+	{
+		release(frame);
+	}
+}
+
+const SpeculativeFramePool::Stats& SpeculativeFramePool::getStats() const
+{
+	return m_stats;
+}
+
+void SpeculativeFramePool::resetStats()
+{
+	m_stats = {};
+}
+
+double SpeculativeFramePool::getHitRate() const
+{
+	std::uint64_t lookupCount = m_stats.hitCount + m_stats.missCount;
+	return lookupCount > 0 ? static_cast<double>(m_stats.hitCount) / lookupCount : 0;
+}
+
+double SpeculativeFramePool::getWastedFraction() const
+{
+	return m_stats.renderMs > 0 ? m_stats.wastedMs / m_stats.renderMs : 0;
+}
+
+void SpeculativeFramePool::release(Frame& frame)
+{
+	if (frame.isValid && !frame.isShown && frame.renderMs > 0)
+	{
+		++m_stats.wastedCount;
+		m_stats.wastedMs += frame.renderMs;
+	}
+	frame.isValid = false;
+}
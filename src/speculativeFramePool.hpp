@@ -0,0 +1,61 @@
+#pragma once
+
+#include "camera.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class SpeculativeFramePool
+{
+public:
+	struct Frame
+	{
+		CameraState pose{};
+		std::uint64_t sceneKey{};
+		glm::ivec2 size{};
+		int pixelSize{};
+		std::vector<unsigned char> pixels{};
+		std::vector<unsigned char> hitMask{};
+		double renderMs{};
+		std::uint64_t lastUse{};
+		bool isValid = false;
+		bool isShown = false;
+	};
+
+	struct Stats
+	{
+		std::uint64_t frameCount{};
+		std::uint64_t hitCount{};
+		std::uint64_t missCount{};
+		std::uint64_t wastedCount{};
+		double renderMs{};
+		double wastedMs{};
+	};
+
+	static constexpr int defaultCapacity = 4;
+	static constexpr float maxZoomRatio = 1.1f;
+
+	SpeculativeFramePool(int capacity = defaultCapacity);
+
+	Frame* find(const CameraState& pose, std::uint64_t sceneKey);
+	const Frame* findNearest(const CameraState& pose, std::uint64_t sceneKey, float toleranceRad);
+	Frame& acquire(const CameraState& pose, std::uint64_t sceneKey, const glm::ivec2& size);
+	void store(Frame& frame, std::span<const unsigned char> pixels,
+		std::span<const unsigned char> hitMask, int pixelSize, double renderMs);
+	void clear();
+
+	const Stats& getStats() const;
+	void resetStats();
+	double getHitRate() const;
+	double getWastedFraction() const;
+
+private:
+	std::vector<Frame> m_frames;
+	std::uint64_t m_useCount{};
+	Stats m_stats{};
+
+	void release(Frame& frame);
+};
@@ -0,0 +1,246 @@
+#include "splitView.hpp"
+
+#include "gui/leftPanel.hpp"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cmath>
+
+constexpr glm::vec3 gapColor{0.05f, 0.05f, 0.05f};
+constexpr glm::vec3 focusColor{0.8f, 0.6f, 0.2f};
+
+SplitView::View::View(const glm::ivec2& viewSize, ThreadPool& threadPool) :
+	size{viewSize},
+	scene{size, threadPool}
+{ }
+
+SplitView::SplitView(const glm::ivec2& viewportSize) :
+	m_viewportSize{viewportSize}
+{
+	setViewCount(1);
+}
+
+void SplitView::render()
+{
+	using Clock = std::chrono::steady_clock;
+
+	Clock::time_point start = Clock::now();
+	if (start - m_lastFrameTime < maxFrameInterval)
+	{
+		m_frameInterval += frameIntervalSmoothing *
+			(std::chrono::duration<float>(start - m_lastFrameTime) - m_frameInterval);
+	}
+	m_lastFrameTime = start;
+
+	glDisable(GL_SCISSOR_TEST);
+	glClearColor(gapColor.r, gapColor.g, gapColor.b, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	glEnable(GL_SCISSOR_TEST);
+
+	View& focusedView = *m_views[m_focus];
+	if (getViewCount() > 1)
+	{
+		setScissor(focusedView.offset - viewGap, focusedView.size + 2 * viewGap);
+		glClearColor(focusColor.r, focusColor.g, focusColor.b, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+	}
+	bindView(focusedView);
+	focusedView.scene.render();
+
+	int viewCount = getViewCount();
+	int firstBackgroundView = m_nextBackgroundView;
+	for (int i = 0; i < viewCount; ++i)
+	{
+		int view = (firstBackgroundView + i) % viewCount;
+		if (view == m_focus)
+		{
+			continue;
+		}
+
+		Scene& scene = m_views[view]->scene;
+		bindView(*m_views[view]);
+		if (!scene.isConverged() && Clock::now() - start < frameBudget)
+		{
+			scene.render();
+			m_nextBackgroundView = (view + 1) % viewCount;
+		}
+		else
+		{
+			scene.present();
+		}
+	}
+	if (Clock::now() - start < frameBudget)
+	{
+		focusedView.scene.speculate(start + frameBudget, m_frameInterval);
+	}
+
+	glDisable(GL_SCISSOR_TEST);
+	glViewport(LeftPanel::width, 0, m_viewportSize.x, m_viewportSize.y);
+}
+
+void SplitView::updateViewportSize()
+{
+	int viewCount = getViewCount();
+	for (int view = 0; view < viewCount; ++view)
+	{
+		View& currentView = *m_views[view];
+		glm::ivec2 size{};
+		calcViewRect(view, viewCount, currentView.offset, size);
+		if (size != currentView.size)
+		{
+			currentView.size = size;
+			currentView.scene.updateViewportSize();
+		}
+	}
+}
+
+bool SplitView::isResizePending() const
+{
+	return std::any_of(m_views.begin(), m_views.end(),
+		[] (const std::unique_ptr<View>& view) { return view->scene.isResizePending(); });
+}
+
+void SplitView::setRecorder(InputRecorder* recorder)
+{
+	m_recorder = recorder;
+	m_views.front()->scene.setRecorder(recorder);
+}
+
+const FrameCache* SplitView::getFrameCache() const
+{
+	return m_frameCache;
+}
+
+void SplitView::setFrameCache(FrameCache* frameCache)
+{
+	m_frameCache = frameCache;
+	for (const std::unique_ptr<View>& view : m_views)
+	{
+		view->scene.setFrameCache(frameCache);
+	}
+}
+
+const RenderProfile& SplitView::getRenderProfile() const
+{
+	return m_renderProfile;
+}
+
+void SplitView::setRenderProfile(const RenderProfile& profile)
+{
+	m_renderProfile = profile;
+	m_threadPool.setActiveThreadCount(profile.threadCount);
+	for (const std::unique_ptr<View>& view : m_views)
+	{
+		view->scene.setRenderProfile(profile);
+	}
+}
+
+int SplitView::getViewCount() const
+{
+	return static_cast<int>(m_views.size());
+}
+
+void SplitView::setViewCount(int viewCount)
+{
+	viewCount = std::clamp(viewCount, 1, maxViewCount);
+	m_views.resize(std::min(getViewCount(), viewCount));
+	for (int view = getViewCount(); view < viewCount; ++view)
+	{
+		glm::ivec2 offset{};
+		glm::ivec2 size{};
+		calcViewRect(view, viewCount, offset, size);
+		m_views.push_back(std::make_unique<View>(size, m_threadPool));
+		m_views.back()->scene.setFrameCache(m_frameCache);
+		m_views.back()->scene.setRenderProfile(m_renderProfile);
+		m_views.back()->offset = offset;
+	}
+	m_views.front()->scene.setRecorder(m_recorder);
+
+	updateViewportSize();
+	++m_layoutRevision;
+	m_focus = std::min(m_focus, viewCount - 1);
+	m_nextBackgroundView = 0;
+}
+
+int SplitView::getFocus() const
+{
+	return m_focus;
+}
+
+void SplitView::setFocus(int view)
+{
+	m_focus = std::clamp(view, 0, getViewCount() - 1);
+}
+
+void SplitView::focusAt(const glm::vec2& viewportPos)
+{
+	for (int view = 0; view < getViewCount(); ++view)
+	{
+		const View& currentView = *m_views[view];
+		if (viewportPos.x >= currentView.offset.x && viewportPos.y >= currentView.offset.y &&
+			viewportPos.x < currentView.offset.x + currentView.size.x &&
+			viewportPos.y < currentView.offset.y + currentView.size.y)
+		{
+			m_focus = view;
+			return;
+		}
+	}
+}
+
+Scene& SplitView::getFocusedScene()
+{
+	return m_views[m_focus]->scene;
+}
+
+ThreadPool& SplitView::getThreadPool()
+{
+	return m_threadPool;
+}
+
+int SplitView::getConvergedViewCount() const
+{
+	return static_cast<int>(std::count_if(m_views.begin(), m_views.end(),
+		[] (const std::unique_ptr<View>& view) { return view->scene.isConverged(); }));
+}
+
+bool SplitView::isConverged() const
+{
+	return getConvergedViewCount() == getViewCount();
+}
+
+std::uint64_t SplitView::getRevision() const
+{
+	std::uint64_t revision = m_layoutRevision;
+	for (const std::unique_ptr<View>& view : m_views)
+	{
+		revision += view->scene.getRevision();
+	}
+	return revision;
+}
+
+void SplitView::calcViewRect(int view, int viewCount, glm::ivec2& offset, glm::ivec2& size)
+	const
+{
+	int columnCount = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(viewCount))));
+	int rowCount = (viewCount + columnCount - 1) / columnCount;
+	glm::ivec2 gridSize{columnCount, rowCount};
+	glm::ivec2 cell{view % columnCount, view / columnCount};
+
+	glm::ivec2 cellSize = glm::max((m_viewportSize - (gridSize - 1) * viewGap) / gridSize,
+		glm::ivec2{1});
+	offset = cell * (cellSize + viewGap);
+	size = glm::max(glm::min(cellSize, m_viewportSize - offset), glm::ivec2{1});
+}
+
+void SplitView::setScissor(const glm::ivec2& offset, const glm::ivec2& size) const
+{
+	glScissor(LeftPanel::width + offset.x, m_viewportSize.y - offset.y - size.y, size.x, size.y);
+}
+
+void SplitView::bindView(const View& view) const
+{
+	setScissor(view.offset, view.size);
+	glViewport(LeftPanel::width + view.offset.x,
+		m_viewportSize.y - view.offset.y - view.size.y, view.size.x, view.size.y);
+}
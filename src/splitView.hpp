@@ -0,0 +1,73 @@
+#pragma once
+
+#include "frameCache.hpp"
+#include "scene.hpp"
+#include "threadPool.hpp"
+#include "trace/inputTrace.hpp"
+#include "tuning/renderProfile.hpp"
+
+#include <glm/glm.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class SplitView
+{
+public:
+	static constexpr int maxViewCount = 4;
+	static constexpr int viewGap = 2;
+	static constexpr std::chrono::milliseconds frameBudget{12};
+	static constexpr std::chrono::duration<float> defaultFrameInterval{1.0f / 60};
+	static constexpr std::chrono::milliseconds maxFrameInterval{100};
+	static constexpr float frameIntervalSmoothing = 0.1f;
+
+	SplitView(const glm::ivec2& viewportSize);
+
+	void render();
+	void updateViewportSize();
+	bool isResizePending() const;
+	void setRecorder(InputRecorder* recorder);
+	const FrameCache* getFrameCache() const;
+	void setFrameCache(FrameCache* frameCache);
+	const RenderProfile& getRenderProfile() const;
+	void setRenderProfile(const RenderProfile& profile);
+
+	int getViewCount() const;
+	void setViewCount(int viewCount);
+	int getFocus() const;
+	void setFocus(int view);
+	void focusAt(const glm::vec2& viewportPos);
+	Scene& getFocusedScene();
+	ThreadPool& getThreadPool();
+	int getConvergedViewCount() const;
+	bool isConverged() const;
+	std::uint64_t getRevision() const;
+
+private:
+	struct View
+	{
+		glm::ivec2 offset{};
+		glm::ivec2 size{};
+		Scene scene;
+
+		View(const glm::ivec2& viewSize, ThreadPool& threadPool);
+	};
+
+	const glm::ivec2& m_viewportSize;
+	ThreadPool m_threadPool{};
+	std::vector<std::unique_ptr<View>> m_views{};
+	int m_focus = 0;
+	int m_nextBackgroundView = 0;
+	std::uint64_t m_layoutRevision{};
+	std::chrono::steady_clock::time_point m_lastFrameTime{};
+	std::chrono::duration<float> m_frameInterval{defaultFrameInterval};
+	InputRecorder* m_recorder{};
+	FrameCache* m_frameCache{};
+	RenderProfile m_renderProfile{};
+
+	void calcViewRect(int view, int viewCount, glm::ivec2& offset, glm::ivec2& size) const;
+	void setScissor(const glm::ivec2& offset, const glm::ivec2& size) const;
+	void bindView(const View& view) const;
+};
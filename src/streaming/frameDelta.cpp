@@ -0,0 +1,248 @@
+#include "streaming/frameDelta.hpp"
+
+#include "renderer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+constexpr int maxRunLength = 128;
+constexpr unsigned char repeatFlag = 0x80;
+constexpr int maxResolution = 16384;
+
+glm::ivec2 getDeltaTileCount(const glm::ivec2& resolution, int tileSize)
+{
+	return (resolution + tileSize - 1) / tileSize;
+}
+
+FrameDeltaEncoder::FrameDeltaEncoder(int tileSize) :
+	m_tileSize{tileSize}
+{ }
+
+void FrameDeltaEncoder::reset(const glm::ivec2& resolution)
+{
+	m_resolution = resolution;
+	m_lastFrame.assign(static_cast<std::size_t>(resolution.x) * resolution.y *
+		Renderer::numOfChannels, 0);
+}
+
+std::vector<Protocol::DeltaTile> FrameDeltaEncoder::encode(
+	std::span<const unsigned char> frame)
+{
+	std::vector<Protocol::DeltaTile> tiles{};
+	glm::ivec2 tileCount = getDeltaTileCount(m_resolution, m_tileSize);
+	for (int tileY = 0; tileY < tileCount.y; ++tileY)
+	{
+		for (int tileX = 0; tileX < tileCount.x; ++tileX)
+		{
+			glm::ivec2 offset{tileX * m_tileSize, tileY * m_tileSize};
+			glm::ivec2 size = glm::min(offset + m_tileSize, m_resolution) - offset;
+			if (!isTileDirty(frame, offset, size))
+			{
+				continue;
+			}
+
+			filterTile(frame, offset, size, DeltaFilter::temporal);
+			m_temporalData.clear();
+			appendRunLength(m_residual, m_temporalData);
+			filterTile(frame, offset, size, DeltaFilter::spatial);
+			m_spatialData.clear();
+			appendRunLength(m_residual, m_spatialData);
+
+			Protocol::DeltaTile tile{};
+			tile.index = static_cast<std::uint32_t>(tileY * tileCount.x + tileX);
+			bool isSpatial = m_spatialData.size() < m_temporalData.size();
+			tile.filter = static_cast<std::uint8_t>(isSpatial ? DeltaFilter::spatial :
+				DeltaFilter::temporal);
+			tile.data = isSpatial ? m_spatialData : m_temporalData;
+			tiles.push_back(std::move(tile));
+
+			std::size_t rowSize = static_cast<std::size_t>(size.x) * Renderer::numOfChannels;
+			for (int y = offset.y; y < offset.y + size.y; ++y)
+			{
+				std::size_t index = (static_cast<std::size_t>(y) * m_resolution.x + offset.x) *
+					Renderer::numOfChannels;
+				std::memcpy(m_lastFrame.data() + index, frame.data() + index, rowSize);
+			}
+		}
+	}
+	return tiles;
+}
+
+int FrameDeltaEncoder::getTileSize() const
+{
+	return m_tileSize;
+}
+
+bool FrameDeltaEncoder::isTileDirty(std::span<const unsigned char> frame,
+	const glm::ivec2& offset, const glm::ivec2& size) const
+{
+	std::size_t rowSize = static_cast<std::size_t>(size.x) * Renderer::numOfChannels;
+	for (int y = offset.y; y < offset.y + size.y; ++y)
+	{
+		std::size_t index = (static_cast<std::size_t>(y) * m_resolution.x + offset.x) *
+			Renderer::numOfChannels;
+		if (std::memcmp(m_lastFrame.data() + index, frame.data() + index, rowSize) != 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FrameDeltaEncoder::filterTile(std::span<const unsigned char> frame,
+	const glm::ivec2& offset, const glm::ivec2& size, DeltaFilter filter)
+{
+	m_residual.resize(static_cast<std::size_t>(size.x) * size.y * Renderer::numOfChannels);
+	std::size_t rowSize = static_cast<std::size_t>(size.x) * Renderer::numOfChannels;
+	for (int y = 0; y < size.y; ++y)
+	{
+		std::size_t index = (static_cast<std::size_t>(offset.y + y) * m_resolution.x +
+			offset.x) * Renderer::numOfChannels;
+		const unsigned char* row = frame.data() + index;
+		const unsigned char* reference = m_lastFrame.data() + index;
+		unsigned char* residualRow = m_residual.data() + y * rowSize;
+		for (std::size_t i = 0; i < rowSize; ++i)
+		{
+			unsigned char predicted = filter == DeltaFilter::temporal ? reference[i] :
+				i >= Renderer::numOfChannels ? row[i - Renderer::numOfChannels] : 0;
+			residualRow[i] = static_cast<unsigned char>(row[i] - predicted);
+		}
+	}
+}
+
+void FrameDeltaEncoder::appendRunLength(const std::vector<unsigned char>& pixels,
+	std::vector<unsigned char>& output)
+{
+	constexpr std::size_t pixelSize = Renderer::numOfChannels;
+	std::size_t pixelCount = pixels.size() / pixelSize;
+	auto isRepeated = [&] (std::size_t pixel)
+		{
+			return pixel + 1 < pixelCount && std::memcmp(pixels.data() + pixel * pixelSize,
+				pixels.data() + (pixel + 1) * pixelSize, pixelSize) == 0;
+		};
+
+	std::size_t pixel = 0;
+	while (pixel < pixelCount)
+	{
+		std::size_t runLength = 1;
+		while (runLength < maxRunLength && isRepeated(pixel + runLength - 1))
+		{
+			++runLength;
+		}
+
+		if (runLength > 1)
+		{
+			output.push_back(static_cast<unsigned char>(repeatFlag | (runLength - 1)));
+			output.insert(output.end(), pixels.begin() + pixel * pixelSize,
+				pixels.begin() + (pixel + 1) * pixelSize);
+			pixel += runLength;
+			continue;
+		}
+
+		std::size_t literalLength = 1;
+		while (literalLength < maxRunLength && pixel + literalLength < pixelCount &&
+			!isRepeated(pixel + literalLength))
+		{
+			++literalLength;
+		}
+		output.push_back(static_cast<unsigned char>(literalLength - 1));
+		output.insert(output.end(), pixels.begin() + pixel * pixelSize,
+			pixels.begin() + (pixel + literalLength) * pixelSize);
+		pixel += literalLength;
+	}
+}
+
+bool FrameDeltaDecoder::apply(const Protocol::FrameDelta& frame)
+{
+	if (frame.tileSize <= 0 || frame.resolution.x <= 0 || frame.resolution.y <= 0 ||
+		frame.resolution.x > maxResolution || frame.resolution.y > maxResolution)
+	{
+		return false;
+	}
+
+	if (frame.resolution != m_resolution)
+	{
+		m_resolution = frame.resolution;
+		m_frame.assign(static_cast<std::size_t>(m_resolution.x) * m_resolution.y *
+			Renderer::numOfChannels, 0);
+	}
+
+	glm::ivec2 tileCount = getDeltaTileCount(m_resolution, frame.tileSize);
+	for (const Protocol::DeltaTile& tile : frame.tiles)
+	{
+		if (tile.index >= static_cast<std::uint32_t>(tileCount.x * tileCount.y) ||
+			tile.filter > static_cast<std::uint8_t>(DeltaFilter::spatial))
+		{
+			return false;
+		}
+
+		glm::ivec2 offset = glm::ivec2{static_cast<int>(tile.index) % tileCount.x,
+			static_cast<int>(tile.index) / tileCount.x} * frame.tileSize;
+		glm::ivec2 size = glm::min(offset + frame.tileSize, m_resolution) - offset;
+		if (!expandRunLength(tile.data, static_cast<std::size_t>(size.x) * size.y, m_residual))
+		{
+			return false;
+		}
+
+		std::size_t rowSize = static_cast<std::size_t>(size.x) * Renderer::numOfChannels;
+		for (int y = 0; y < size.y; ++y)
+		{
+			unsigned char* row = m_frame.data() + (static_cast<std::size_t>(offset.y + y) *
+				m_resolution.x + offset.x) * Renderer::numOfChannels;
+			const unsigned char* residualRow = m_residual.data() + y * rowSize;
+			for (std::size_t i = 0; i < rowSize; ++i)
+			{
+				unsigned char predicted = tile.filter ==
+					static_cast<std::uint8_t>(DeltaFilter::temporal) ? row[i] :
+					i >= Renderer::numOfChannels ? row[i - Renderer::numOfChannels] : 0;
+				row[i] = static_cast<unsigned char>(residualRow[i] + predicted);
+			}
+		}
+	}
+	return true;
+}
+
+const std::vector<unsigned char>& FrameDeltaDecoder::getFrame() const
+{
+	return m_frame;
+}
+
+const glm::ivec2& FrameDeltaDecoder::getResolution() const
+{
+	return m_resolution;
+}
+
+bool FrameDeltaDecoder::expandRunLength(const std::vector<unsigned char>& input,
+	std::size_t pixelCount, std::vector<unsigned char>& pixels)
+{
+	constexpr std::size_t pixelSize = Renderer::numOfChannels;
+	pixels.clear();
+	std::size_t offset = 0;
+	while (offset < input.size())
+	{
+		unsigned char header = input[offset++];
+		std::size_t length = (header & ~repeatFlag) + 1u;
+		bool isRepeat = (header & repeatFlag) != 0;
+		std::size_t byteCount = isRepeat ? pixelSize : length * pixelSize;
+		if (input.size() - offset < byteCount || pixels.size() / pixelSize + length > pixelCount)
+		{
+			return false;
+		}
+
+		if (isRepeat)
+		{
+			for (std::size_t i = 0; i < length; ++i)
+			{
+				pixels.insert(pixels.end(), input.begin() + offset,
+					input.begin() + offset + pixelSize);
+			}
+		}
+		else
+		{
+			pixels.insert(pixels.end(), input.begin() + offset, input.begin() + offset + byteCount);
+		}
+		offset += byteCount;
+	}
+	return pixels.size() == pixelCount * pixelSize;
+}
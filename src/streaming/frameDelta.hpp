@@ -0,0 +1,60 @@
+#pragma once
+
+#include "service/protocol.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+enum class DeltaFilter : std::uint8_t
+{
+	temporal,
+	spatial
+};
+
+class FrameDeltaEncoder
+{
+public:
+	FrameDeltaEncoder(int tileSize);
+
+	void reset(const glm::ivec2& resolution);
+	std::vector<Protocol::DeltaTile> encode(std::span<const unsigned char> frame);
+	int getTileSize() const;
+
+private:
+	int m_tileSize{};
+	glm::ivec2 m_resolution{};
+	std::vector<unsigned char> m_lastFrame{};
+	std::vector<unsigned char> m_residual{};
+	std::vector<unsigned char> m_temporalData{};
+	std::vector<unsigned char> m_spatialData{};
+
+	bool isTileDirty(std::span<const unsigned char> frame, const glm::ivec2& offset,
+		const glm::ivec2& size) const;
+	void filterTile(std::span<const unsigned char> frame, const glm::ivec2& offset,
+		const glm::ivec2& size, DeltaFilter filter);
+
+	static void appendRunLength(const std::vector<unsigned char>& pixels,
+		std::vector<unsigned char>& output);
+};
+
+class FrameDeltaDecoder
+{
+public:
+	bool apply(const Protocol::FrameDelta& frame);
+	const std::vector<unsigned char>& getFrame() const;
+	const glm::ivec2& getResolution() const;
+
+private:
+	glm::ivec2 m_resolution{};
+	std::vector<unsigned char> m_frame{};
+	std::vector<unsigned char> m_residual{};
+
+	static bool expandRunLength(const std::vector<unsigned char>& input, std::size_t pixelCount,
+		std::vector<unsigned char>& pixels);
+};
+
+glm::ivec2 getDeltaTileCount(const glm::ivec2& resolution, int tileSize);
@@ -0,0 +1,148 @@
+#include "streaming/streamServer.hpp"
+
+#include "raycaster.hpp"
+#include "service/renderService.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+StreamServer::StreamServer(int threadCount, int tileSize, int maxPixelSizeExponent) :
+	m_threadPool{threadCount},
+	m_encoder{tileSize},
+	m_maxPixelSize{1 << maxPixelSizeExponent},
+	m_camera{m_viewportSize, Camera::defaultNearPlane, Camera::defaultFarPlane,
+		Camera::defaultViewWidth},
+	m_renderer{m_viewportSize}
+{ }
+
+bool StreamServer::serve(const Socket& client)
+{
+	m_pendingCommand.reset();
+	m_isConnected = true;
+	m_pixelSize = 0;
+	m_isAntialiased = true;
+	m_encoder.reset(m_viewportSize);
+
+	std::thread receiver{&StreamServer::receiveCommands, this, std::cref(client)};
+	Protocol::FrameDelta frame{};
+	frame.tileSize = m_encoder.getTileSize();
+	bool isSent = true;
+	while (isSent)
+	{
+		std::optional<Protocol::ViewerCommand> command{};
+		{
+			std::unique_lock<std::mutex> lock{m_commandMutex};
+			m_commandCondition.wait(lock,
+				[this] () { return m_pendingCommand.has_value() || !m_isConnected ||
+					!isConverged(); });
+			if (!m_isConnected)
+			{
+				break;
+			}
+			command.swap(m_pendingCommand);
+		}
+
+		if (command.has_value())
+		{
+			applySettings(command->settings);
+			frame.commandSequence = command->sequence;
+		}
+
+		renderPass();
+		++frame.frameId;
+		frame.isConverged = isConverged();
+		frame.resolution = m_viewportSize;
+		frame.tiles = m_encoder.encode(m_renderer.getCpuTexture());
+		isSent = client.sendMessage(Protocol::serialize(frame));
+	}
+
+	client.shutdown();
+	receiver.join();
+	return isSent;
+}
+
+int StreamServer::run(const CommandLine& commandLine)
+{
+	Socket listenSocket = Socket::listen(commandLine.getString("listen",
+		"ellipsoid-raycasting-stream.sock"));
+	if (!listenSocket.isValid())
+	{
+		return 1;
+	}
+
+	StreamServer server{commandLine.getInt("threads", ThreadPool::defaultThreadCount()),
+		std::max(commandLine.getInt("tile", 32), 1),
+		std::clamp(commandLine.getInt("accuracy", 4), 0, 8)};
+	int sessionCount = commandLine.getInt("sessions", std::numeric_limits<int>::max());
+	std::cout << "Stream server listening with " << server.m_threadPool.getThreadCount() <<
+		" threads\n";
+	for (int session = 0; session < sessionCount; ++session)
+	{
+		Socket client = listenSocket.accept();
+		if (client.isValid())
+		{
+			server.serve(client);
+		}
+	}
+	return 0;
+}
+
+void StreamServer::receiveCommands(const Socket& client)
+{
+	std::vector<unsigned char> message{};
+	while (client.receiveMessage(message))
+	{
+		std::optional<Protocol::ViewerCommand> command = Protocol::parseViewerCommand(message);
+		if (!command.has_value() || RenderService::validate(command->settings).has_value())
+		{
+			break;
+		}
+
+		std::lock_guard<std::mutex> lock{m_commandMutex};
+		m_pendingCommand = std::move(command);
+		m_commandCondition.notify_one();
+	}
+
+	std::lock_guard<std::mutex> lock{m_commandMutex};
+	m_isConnected = false;
+	m_commandCondition.notify_one();
+}
+
+void StreamServer::applySettings(const RenderSettings& settings)
+{
+	if (m_viewportSize != settings.resolution)
+	{
+		m_viewportSize = settings.resolution;
+		m_renderer.updateViewportSize();
+		m_encoder.reset(m_viewportSize);
+	}
+	settings.apply(m_camera, m_ellipsoid);
+	m_settings = settings;
+	m_pixelSize = m_maxPixelSize;
+	m_isAntialiased = false;
+}
+
+void StreamServer::renderPass()
+{
+	Raycaster raycaster{m_camera, m_ellipsoid};
+	if (m_pixelSize > 0)
+	{
+		m_renderer.drawPass(raycaster, m_pixelSize, m_pixelSize == m_maxPixelSize,
+			m_threadPool);
+		m_pixelSize /= 2;
+	}
+	else
+	{
+		m_renderer.antialias(raycaster, m_settings.antialiasingSamples, m_threadPool);
+		m_isAntialiased = true;
+	}
+}
+
+bool StreamServer::isConverged() const
+{
+	return m_pixelSize == 0 && (m_isAntialiased || m_settings.antialiasingSamples <= 1);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "camera.hpp"
+#include "commandLine.hpp"
+#include "ellipsoid.hpp"
+#include "network/socket.hpp"
+#include "renderSettings.hpp"
+#include "renderer.hpp"
+#include "service/protocol.hpp"
+#include "streaming/frameDelta.hpp"
+#include "threadPool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+class StreamServer
+{
+public:
+	StreamServer(int threadCount, int tileSize, int maxPixelSizeExponent);
+
+	bool serve(const Socket& client);
+
+	static int run(const CommandLine& commandLine);
+
+private:
+	ThreadPool m_threadPool;
+	FrameDeltaEncoder m_encoder;
+	int m_maxPixelSize{};
+
+	glm::ivec2 m_viewportSize{1, 1};
+	Camera m_camera;
+	Ellipsoid m_ellipsoid{4.0f, 2.0f, 8.0f};
+	Renderer m_renderer;
+	RenderSettings m_settings{};
+	int m_pixelSize{};
+	bool m_isAntialiased{};
+
+	std::optional<Protocol::ViewerCommand> m_pendingCommand{};
+	bool m_isConnected{};
+	std::mutex m_commandMutex{};
+	std::condition_variable m_commandCondition{};
+
+	void receiveCommands(const Socket& client);
+	void applySettings(const RenderSettings& settings);
+	void renderPass();
+	bool isConverged() const;
+};
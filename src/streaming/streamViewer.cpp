@@ -0,0 +1,174 @@
+#include "streaming/streamViewer.hpp"
+
+#include "pngEncoder.hpp"
+#include "renderer.hpp"
+#include "service/loadTest.hpp"
+#include "service/protocol.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+
+StreamViewer::StreamViewer(Socket socket) :
+	m_socket{std::move(socket)}
+{ }
+
+std::optional<StreamViewer::Stats> StreamViewer::orbit(const RenderSettings& settings,
+	int commandCount, std::chrono::milliseconds interval, float yawStepRad)
+{
+	m_sendTimes.clear();
+	m_displayedSequence = 0;
+	m_isFinished = false;
+	m_isFailed = false;
+	m_stats = Stats{};
+	m_stats.commandCount = commandCount;
+
+	std::thread receiver{&StreamViewer::receiveFrames, this};
+	Clock::time_point start = Clock::now();
+	Protocol::ViewerCommand command{0, settings};
+	for (int i = 0; i < commandCount; ++i)
+	{
+		++command.sequence;
+		command.settings.camera.yawRad += yawStepRad;
+		{
+			std::lock_guard<std::mutex> lock{m_mutex};
+			m_sendTimes.push_back(Clock::now());
+		}
+		if (!m_socket.sendMessage(Protocol::serialize(command)))
+		{
+			break;
+		}
+		std::this_thread::sleep_until(start + interval * (i + 1));
+	}
+
+	{
+		std::unique_lock<std::mutex> lock{m_mutex};
+		m_condition.wait(lock, [this] () { return m_isFinished || m_isFailed; });
+	}
+	m_stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	m_socket.shutdown();
+	receiver.join();
+
+	if (m_isFailed)
+	{
+		return std::nullopt;
+	}
+	return std::move(m_stats);
+}
+
+const FrameDeltaDecoder& StreamViewer::getDecoder() const
+{
+	return m_decoder;
+}
+
+int StreamViewer::run(const CommandLine& commandLine)
+{
+	Socket socket = Socket::connect(commandLine.getString("connect",
+		"ellipsoid-raycasting-stream.sock"));
+	if (!socket.isValid())
+	{
+		return 1;
+	}
+
+	RenderSettings settings = RenderSettings::fromCommandLine(commandLine);
+	int commandCount = std::max(commandLine.getInt("commands", 120), 1);
+	std::chrono::milliseconds interval{std::max(commandLine.getInt("interval", 16), 0)};
+	float yawStepRad = commandLine.getFloat("yaw-step", 0.02f);
+
+	StreamViewer viewer{std::move(socket)};
+	std::optional<Stats> stats = viewer.orbit(settings, commandCount, interval, yawStepRad);
+	if (!stats.has_value())
+	{
+		std::cerr << "Stream session failed\n";
+		return 1;
+	}
+
+	double rawFrameBytes = static_cast<double>(settings.resolution.x) * settings.resolution.y *
+		Renderer::numOfChannels;
+	double totalBytes = 0;
+	double totalTiles = 0;
+	for (std::size_t i = 0; i < stats->frameBytes.size(); ++i)
+	{
+		totalBytes += stats->frameBytes[i];
+		totalTiles += stats->frameTileCounts[i];
+	}
+	double frameCount = std::max(stats->frameCount, 1);
+	std::cout << "session: " << stats->commandCount << " orbit commands every " <<
+		interval.count() << " ms at " << settings.resolution.x << 'x' << settings.resolution.y <<
+		'\n';
+	std::cout << "frames: " << stats->frameCount << " (" << stats->convergedFrameCount <<
+		" converged), " << stats->frameCount / stats->seconds << " frames/s\n";
+	std::cout << "bytes per frame: mean " << totalBytes / frameCount << ", p50 " <<
+		LoadTest::percentile(stats->frameBytes, 0.5) << ", max " <<
+		LoadTest::percentile(stats->frameBytes, 1.0) << " (raw " << rawFrameBytes << ", ratio " <<
+		rawFrameBytes * frameCount / std::max(totalBytes, 1.0) << ":1)\n";
+	std::cout << "dirty tiles per frame: " << totalTiles / frameCount << '\n';
+	std::cout << "bandwidth: " << totalBytes / stats->seconds / 1e6 << " MB/s\n";
+	std::cout << "command to first frame p50: " <<
+		LoadTest::percentile(stats->firstFrameLatenciesMs, 0.5) << " ms, p99: " <<
+		LoadTest::percentile(stats->firstFrameLatenciesMs, 0.99) << " ms\n";
+	std::cout << "last command to converged frame: " << stats->convergedLatencyMs << " ms\n";
+
+	std::string outputPath = commandLine.getString("output", "");
+	if (!outputPath.empty())
+	{
+		const FrameDeltaDecoder& decoder = viewer.getDecoder();
+		std::vector<unsigned char> png = PngEncoder::encode(decoder.getFrame().data(),
+			decoder.getResolution());
+		std::ofstream file{outputPath, std::ios::binary};
+		file.write(reinterpret_cast<const char*>(png.data()),
+			static_cast<std::streamsize>(png.size()));
+		return file.good() ? 0 : 1;
+	}
+	return 0;
+}
+
+void StreamViewer::receiveFrames()
+{
+	std::vector<unsigned char> message{};
+	while (m_socket.receiveMessage(message))
+	{
+		std::optional<Protocol::FrameDelta> frame = Protocol::parseFrameDelta(message);
+		if (!frame.has_value() || !m_decoder.apply(*frame))
+		{
+			break;
+		}
+
+		Clock::time_point now = Clock::now();
+		std::lock_guard<std::mutex> lock{m_mutex};
+		if (frame->commandSequence > m_sendTimes.size())
+		{
+			break;
+		}
+		++m_stats.frameCount;
+		m_stats.frameBytes.push_back(static_cast<double>(message.size() + sizeof(std::uint32_t)));
+		m_stats.frameTileCounts.push_back(static_cast<double>(frame->tiles.size()));
+		for (std::uint32_t sequence = m_displayedSequence + 1; sequence <= frame->commandSequence;
+			++sequence)
+		{
+			m_stats.firstFrameLatenciesMs.push_back(std::chrono::duration<double, std::milli>(
+				now - m_sendTimes[sequence - 1]).count());
+		}
+		m_displayedSequence = std::max(m_displayedSequence, frame->commandSequence);
+
+		if (frame->isConverged)
+		{
+			++m_stats.convergedFrameCount;
+			if (frame->commandSequence == static_cast<std::uint32_t>(m_stats.commandCount))
+			{
+				m_stats.convergedLatencyMs = std::chrono::duration<double, std::milli>(
+					now - m_sendTimes.back()).count();
+				m_isFinished = true;
+				m_condition.notify_one();
+				return;
+			}
+		}
+	}
+
+	std::lock_guard<std::mutex> lock{m_mutex};
+	m_isFailed = !m_isFinished;
+	m_condition.notify_one();
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "commandLine.hpp"
+#include "network/socket.hpp"
+#include "renderSettings.hpp"
+#include "streaming/frameDelta.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+class StreamViewer
+{
+public:
+	struct Stats
+	{
+		int commandCount{};
+		int frameCount{};
+		int convergedFrameCount{};
+		double seconds{};
+		std::vector<double> frameBytes{};
+		std::vector<double> frameTileCounts{};
+		std::vector<double> firstFrameLatenciesMs{};
+		double convergedLatencyMs{};
+	};
+
+	StreamViewer(Socket socket);
+
+	std::optional<Stats> orbit(const RenderSettings& settings, int commandCount,
+		std::chrono::milliseconds interval, float yawStepRad);
+	const FrameDeltaDecoder& getDecoder() const;
+
+	static int run(const CommandLine& commandLine);
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	Socket m_socket;
+	FrameDeltaDecoder m_decoder{};
+
+	std::vector<Clock::time_point> m_sendTimes{};
+	std::uint32_t m_displayedSequence{};
+	bool m_isFinished{};
+	bool m_isFailed{};
+	Stats m_stats{};
+	std::mutex m_mutex{};
+	std::condition_variable m_condition{};
+
+	void receiveFrames();
+};
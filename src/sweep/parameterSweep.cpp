@@ -0,0 +1,202 @@
+#include "sweep/parameterSweep.hpp"
+
+#include "ellipsoid.hpp"
+#include "pngEncoder.hpp"
+#include "raycaster.hpp"
+#include "renderer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <tuple>
+
+constexpr std::size_t shadingChunkSize = 1024;
+
+ParameterSweep::ParameterSweep(ThreadPool& threadPool) :
+	m_threadPool{threadPool}
+{ }
+
+std::vector<std::vector<unsigned char>> ParameterSweep::render(
+	const std::vector<RenderSettings>& jobs)
+{
+	using Clock = std::chrono::steady_clock;
+
+	Clock::time_point start = Clock::now();
+
+	std::map<GeometryKey, std::vector<std::size_t>> groups{};
+	for (std::size_t i = 0; i < jobs.size(); ++i)
+	{
+		groups[{jobs[i].resolution, jobs[i].camera, jobs[i].radii}].push_back(i);
+	}
+
+	std::vector<std::vector<unsigned char>> frames(jobs.size());
+	for (const auto& [key, jobIndices] : groups)
+	{
+		renderGroup(key, jobs, jobIndices, frames);
+	}
+
+	m_stats.variantCount = static_cast<int>(jobs.size());
+	m_stats.geometryGroupCount = static_cast<int>(groups.size());
+	m_stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	m_stats.variantsPerSecond = m_stats.seconds > 0 ? jobs.size() / m_stats.seconds : 0;
+	return frames;
+}
+
+const ParameterSweep::Stats& ParameterSweep::getStats() const
+{
+	return m_stats;
+}
+
+int ParameterSweep::run(const CommandLine& commandLine)
+{
+	std::vector<RenderSettings> jobs = createGrid(commandLine);
+	ThreadPool threadPool{commandLine.getInt("threads", ThreadPool::defaultThreadCount())};
+	ParameterSweep sweep{threadPool};
+	std::vector<std::vector<unsigned char>> frames = sweep.render(jobs);
+	const Stats& stats = sweep.getStats();
+
+	std::cout << "variants: " << stats.variantCount << " in " << stats.geometryGroupCount <<
+		" geometry groups\n";
+	std::cout << "resolution: " << jobs.front().resolution.x << 'x' <<
+		jobs.front().resolution.y << '\n';
+	std::cout << "shared geometry: " << stats.seconds << " s, " << stats.variantsPerSecond <<
+		" variants/s\n";
+
+	if (commandLine.hasOption("compare"))
+	{
+		double seconds = renderSeparately(jobs, threadPool);
+		std::cout << "separate renders: " << seconds << " s, " << jobs.size() / seconds <<
+			" variants/s\n";
+	}
+
+	if (commandLine.hasOption("output-dir"))
+	{
+		std::filesystem::path outputDir = commandLine.getString("output-dir", ".");
+		std::filesystem::create_directories(outputDir);
+		for (std::size_t i = 0; i < frames.size(); ++i)
+		{
+			std::vector<unsigned char> png = PngEncoder::encode(frames[i].data(),
+				jobs[i].resolution);
+			std::ofstream file{outputDir / ("variant" + std::to_string(i) + ".png"),
+				std::ios::binary};
+			file.write(reinterpret_cast<const char*>(png.data()),
+				static_cast<std::streamsize>(png.size()));
+		}
+	}
+	return 0;
+}
+
+bool ParameterSweep::GeometryKey::operator<(const GeometryKey& key) const
+{
+	return std::tie(resolution.x, resolution.y, camera.targetPos.x, camera.targetPos.y,
+		camera.targetPos.z, camera.pitchRad, camera.yawRad, camera.viewWidth, radii.x, radii.y,
+		radii.z) <
+		std::tie(key.resolution.x, key.resolution.y, key.camera.targetPos.x,
+		key.camera.targetPos.y, key.camera.targetPos.z, key.camera.pitchRad, key.camera.yawRad,
+		key.camera.viewWidth, key.radii.x, key.radii.y, key.radii.z);
+}
+
+void ParameterSweep::renderGroup(const GeometryKey& key, const std::vector<RenderSettings>& jobs,
+	const std::vector<std::size_t>& jobIndices,
+	std::vector<std::vector<unsigned char>>& frames)
+{
+	glm::ivec2 viewportSize = key.resolution;
+	Camera camera{viewportSize, Camera::defaultNearPlane, Camera::defaultFarPlane,
+		key.camera.viewWidth};
+	camera.setState(key.camera);
+	Ellipsoid ellipsoid{key.radii.x, key.radii.y, key.radii.z};
+	Raycaster raycaster{camera, ellipsoid};
+
+	m_gBuffer.resize(viewportSize);
+	m_gBuffer.draw(raycaster, m_threadPool);
+
+	std::size_t pixelCount = m_gBuffer.getPixelCount();
+	for (std::size_t jobIndex : jobIndices)
+	{
+		frames[jobIndex].resize(pixelCount * Renderer::numOfChannels);
+	}
+
+	int chunkCount = static_cast<int>((pixelCount + shadingChunkSize - 1) / shadingChunkSize);
+	m_threadPool.parallelFor(chunkCount,
+		[this, &raycaster, &jobs, &jobIndices, &frames, pixelCount] (int chunk)
+		{
+			std::size_t begin = chunk * shadingChunkSize;
+			std::size_t end = std::min(begin + shadingChunkSize, pixelCount);
+
+			std::array<Raycaster::ShadingTerms, shadingChunkSize> shadingTerms{};
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				if (m_gBuffer.isHit(i))
+				{
+					shadingTerms[i - begin] = raycaster.calcShadingTerms(m_gBuffer.getNormal(i));
+				}
+			}
+
+			for (std::size_t jobIndex : jobIndices)
+			{
+				const Material& material = jobs[jobIndex].material;
+				unsigned char* frame = frames[jobIndex].data();
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					glm::ivec3 color = m_gBuffer.isHit(i) ?
+						Raycaster::calcPhong(shadingTerms[i - begin], material) :
+						Renderer::backgroundColor;
+					for (int channel = 0; channel < Renderer::numOfChannels; ++channel)
+					{
+						frame[i * Renderer::numOfChannels + channel] =
+							static_cast<unsigned char>(color[channel]);
+					}
+				}
+			}
+		}
+	);
+}
+
+std::vector<RenderSettings> ParameterSweep::createGrid(const CommandLine& commandLine)
+{
+	const int shapeCount = std::max(commandLine.getInt("shapes", 4), 1);
+	const int variantCount = std::max(commandLine.getInt("variants", 16), 1);
+	const float minShininess = commandLine.getFloat("min-shininess", 1.0f);
+	const float maxShininess = commandLine.getFloat("max-shininess", 100.0f);
+
+	RenderSettings baseJob = RenderSettings::fromCommandLine(commandLine);
+
+	std::vector<RenderSettings> jobs{};
+	for (int shape = 0; shape < shapeCount; ++shape)
+	{
+		for (int variant = 0; variant < variantCount; ++variant)
+		{
+			RenderSettings job = baseJob;
+			job.radii.z += shape;
+			float t = variantCount > 1 ? static_cast<float>(variant) / (variantCount - 1) : 0;
+			job.material.shininess = minShininess + t * (maxShininess - minShininess);
+			job.material.specularCoef = 0.5f + 0.5f * t;
+			jobs.push_back(job);
+		}
+	}
+	return jobs;
+}
+
+double ParameterSweep::renderSeparately(const std::vector<RenderSettings>& jobs,
+	ThreadPool& threadPool)
+{
+	using Clock = std::chrono::steady_clock;
+
+	Clock::time_point start = Clock::now();
+	for (const RenderSettings& job : jobs)
+	{
+		glm::ivec2 viewportSize = job.resolution;
+		Camera camera{viewportSize, Camera::defaultNearPlane, Camera::defaultFarPlane,
+			job.camera.viewWidth};
+		Ellipsoid ellipsoid{job.radii.x, job.radii.y, job.radii.z};
+		job.apply(camera, ellipsoid);
+		Renderer renderer{viewportSize};
+		renderer.drawPass(Raycaster{camera, ellipsoid}, 1, true, threadPool);
+	}
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "camera.hpp"
+#include "commandLine.hpp"
+#include "gBuffer.hpp"
+#include "renderSettings.hpp"
+#include "threadPool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+class ParameterSweep
+{
+public:
+	struct Stats
+	{
+		int variantCount{};
+		int geometryGroupCount{};
+		double seconds{};
+		double variantsPerSecond{};
+	};
+
+	ParameterSweep(ThreadPool& threadPool);
+
+	std::vector<std::vector<unsigned char>> render(const std::vector<RenderSettings>& jobs);
+	const Stats& getStats() const;
+
+	static int run(const CommandLine& commandLine);
+
+private:
+	struct GeometryKey
+	{
+		glm::ivec2 resolution{};
+		CameraState camera{};
+		glm::vec3 radii{};
+
+		bool operator<(const GeometryKey& key) const;
+	};
+
+	ThreadPool& m_threadPool;
+	GBuffer m_gBuffer{};
+	Stats m_stats{};
+
+	void renderGroup(const GeometryKey& key, const std::vector<RenderSettings>& jobs,
+		const std::vector<std::size_t>& jobIndices,
+		std::vector<std::vector<unsigned char>>& frames);
+
+	static std::vector<RenderSettings> createGrid(const CommandLine& commandLine);
+	static double renderSeparately(const std::vector<RenderSettings>& jobs, ThreadPool& threadPool);
+};
@@ -3,7 +3,8 @@
 #include <glad/glad.h>
 
 Texture::Texture(const glm::ivec2& size) :
-	m_size{size}
+	m_size{size},
+	m_capacity{size}
 {
 	create();
 }
@@ -13,7 +14,7 @@ void Texture::use() const
 	glBindTexture(GL_TEXTURE_2D, m_id);
 }
 
-void Texture::overwrite(const std::vector<unsigned char>& cpuTexture) const
+void Texture::overwrite(std::span<const unsigned char> cpuTexture) const
 {
 	use();
 	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_size.x, m_size.y, GL_RGB, GL_UNSIGNED_BYTE,
@@ -23,10 +24,20 @@ void Texture::overwrite(const std::vector<unsigned char>& cpuTexture) const
 void Texture::rescale(const glm::ivec2& size)
 {
 	m_size = size;
-	destroy();
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 	glPixelStorei(GL_PACK_ALIGNMENT, 1);
-	create();
+	if (size.x <= m_capacity.x && size.y <= m_capacity.y)
+	{
+		return;
+	}
+
+	m_capacity = glm::max(m_capacity, size);
+	allocateStorage();
+}
+
+glm::vec2 Texture::getScale() const
+{
+	return glm::vec2{m_size} / glm::vec2{m_capacity};
 }
 
 Texture::~Texture()
@@ -37,13 +48,18 @@ Texture::~Texture()
 void Texture::create()
 {
 	glGenTextures(1, &m_id);
-	use();
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, m_size.x, m_size.y, 0, GL_RGB, GL_UNSIGNED_BYTE,
-		nullptr);
+	allocateStorage();
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 }
 
+void Texture::allocateStorage() const
+{
+	use();
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, m_capacity.x, m_capacity.y, 0, GL_RGB,
+		GL_UNSIGNED_BYTE, nullptr);
+}
+
 void Texture::destroy() const
 {
 	glDeleteTextures(1, &m_id);
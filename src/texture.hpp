@@ -2,21 +2,24 @@
 
 #include <glm/glm.hpp>
 
-#include <vector>
+#include <span>
 
 class Texture
 {
 public:
 	Texture(const glm::ivec2& size);
 	void use() const;
-	void overwrite(const std::vector<unsigned char>& cpuTexture) const;
+	void overwrite(std::span<const unsigned char> cpuTexture) const;
 	void rescale(const glm::ivec2& size);
+	glm::vec2 getScale() const;
 	~Texture();
 
 private:
 	unsigned int m_id{};
 	glm::ivec2 m_size{};
+	glm::ivec2 m_capacity{};
 
 	void create();
+	void allocateStorage() const;
 	void destroy() const;
 };
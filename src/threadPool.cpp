@@ -0,0 +1,208 @@
+#include "threadPool.hpp"
+
+#include <algorithm>
+#include <optional>
+
+ThreadPool::ThreadPool(int threadCount) :
+	m_chunkCursors(std::max(threadCount, 1)),
+	m_activeThreadCount{std::max(threadCount, 1)},
+	m_workerCounters(std::max(threadCount, 1) - 1)
+{
+	for (int i = 1; i < std::max(threadCount, 1); ++i)
+	{
+		m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock{m_mutex};
+		m_stop = true;
+	}
+	m_taskCondition.notify_all();
+	for (std::thread& worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+int ThreadPool::getThreadCount() const
+{
+	return static_cast<int>(m_workers.size()) + 1;
+}
+
+int ThreadPool::getActiveThreadCount() const
+{
+	return m_activeThreadCount;
+}
+
+void ThreadPool::setActiveThreadCount(int activeThreadCount)
+{
+	std::lock_guard<std::mutex> parallelForLock{m_parallelForMutex};
+	m_activeThreadCount = std::clamp(activeThreadCount, 1, getThreadCount());
+}
+
+ThreadPool::Scheduling ThreadPool::getScheduling() const
+{
+	return m_scheduling;
+}
+
+void ThreadPool::setScheduling(Scheduling scheduling)
+{
+	std::lock_guard<std::mutex> parallelForLock{m_parallelForMutex};
+	m_scheduling = scheduling;
+}
+
+bool ThreadPool::pinToNodes(const NumaTopology& topology)
+{
+	int threadCount = getThreadCount();
+	bool isPinned = topology.pinThread(NumaTopology::getCurrentThread(),
+		topology.getThreadNode(0, threadCount));
+	for (int i = 1; i < threadCount; ++i)
+	{
+		isPinned = topology.pinThread(m_workers[i - 1].native_handle(),
+			topology.getThreadNode(i, threadCount)) && isPinned;
+	}
+	return isPinned;
+}
+
+bool ThreadPool::areCountersEnabled() const
+{
+	return m_areCountersEnabled;
+}
+
+void ThreadPool::setCountersEnabled(bool areCountersEnabled)
+{
+	std::lock_guard<std::mutex> parallelForLock{m_parallelForMutex};
+	m_areCountersEnabled = areCountersEnabled;
+}
+
+void ThreadPool::resetCounters()
+{
+	std::lock_guard<std::mutex> parallelForLock{m_parallelForMutex};
+	std::fill(m_workerCounters.begin(), m_workerCounters.end(), PerfCounters::Sample{});
+}
+
+const std::vector<PerfCounters::Sample>& ThreadPool::getWorkerCounters() const
+{
+	return m_workerCounters;
+}
+
+void ThreadPool::run(int taskCount, const TaskRef& task)
+{
+	std::lock_guard<std::mutex> parallelForLock{m_parallelForMutex};
+	if (m_activeThreadCount == 1 || taskCount <= 1)
+	{
+		for (int i = 0; i < taskCount; ++i)
+		{
+			task(i);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock{m_mutex};
+		m_task = &task;
+		m_taskCount = taskCount;
+		m_taskThreadCount = m_activeThreadCount;
+		m_nextTaskIndex = 0;
+		for (int chunk = 0; chunk < m_taskThreadCount; ++chunk)
+		{
+			m_chunkCursors[chunk].next = calcChunkStart(chunk, taskCount, m_taskThreadCount);
+		}
+		m_busyWorkers = m_taskThreadCount - 1;
+		++m_generation;
+	}
+	m_taskCondition.notify_all();
+
+	runTasks(task, taskCount, m_taskThreadCount, 0);
+
+	std::unique_lock<std::mutex> lock{m_mutex};
+	m_doneCondition.wait(lock, [this] () { return m_busyWorkers == 0; });
+	m_task = nullptr;
+}
+
+int ThreadPool::defaultThreadCount()
+{
+	return std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+}
+
+void ThreadPool::workerLoop(int threadIndex)
+{
+	std::uint64_t generation = 0;
+	std::optional<PerfCounters> counters{};
+	while (true)
+	{
+		const TaskRef* task{};
+		int taskCount{};
+		int taskThreadCount{};
+		{
+			std::unique_lock<std::mutex> lock{m_mutex};
+			m_taskCondition.wait(lock,
+				[this, generation] () { return m_stop || m_generation != generation; });
+			if (m_stop)
+			{
+				return;
+			}
+			generation = m_generation;
+			task = m_task;
+			taskCount = m_taskCount;
+			taskThreadCount = m_taskThreadCount;
+		}
+		if (threadIndex >= taskThreadCount)
+		{
+			continue;
+		}
+
+		if (m_areCountersEnabled)
+		{
+			if (!counters.has_value())
+			{
+				counters.emplace();
+			}
+			counters->start();
+			runTasks(*task, taskCount, taskThreadCount, threadIndex);
+			m_workerCounters[threadIndex - 1].add(counters->stop());
+		}
+		else
+		{
+			runTasks(*task, taskCount, taskThreadCount, threadIndex);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock{m_mutex};
+			--m_busyWorkers;
+		}
+		m_doneCondition.notify_one();
+	}
+}
+
+void ThreadPool::runTasks(const TaskRef& task, int taskCount, int threadCount,
+	int threadIndex)
+{
+	if (m_scheduling == Scheduling::dynamic)
+	{
+		for (int i = m_nextTaskIndex++; i < taskCount; i = m_nextTaskIndex++)
+		{
+			task(i);
+		}
+		return;
+	}
+
+	for (int offset = 0; offset < threadCount; ++offset)
+	{
+		int chunk = (threadIndex + offset) % threadCount;
+		int end = calcChunkStart(chunk + 1, taskCount, threadCount);
+		std::atomic<int>& next = m_chunkCursors[chunk].next;
+		for (int i = next++; i < end; i = next++)
+		{
+			task(i);
+		}
+	}
+}
+
+int ThreadPool::calcChunkStart(int chunk, int taskCount, int threadCount)
+{
+	return static_cast<int>(static_cast<std::int64_t>(chunk) * taskCount / threadCount);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "numaTopology.hpp"
+#include "perfCounters.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+	enum class Scheduling
+	{
+		dynamic,
+		affinity
+	};
+
+	ThreadPool(int threadCount = defaultThreadCount());
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool(ThreadPool&&) = delete;
+	~ThreadPool();
+
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	ThreadPool& operator=(ThreadPool&&) = delete;
+
+	int getThreadCount() const;
+	int getActiveThreadCount() const;
+	void setActiveThreadCount(int activeThreadCount);
+	Scheduling getScheduling() const;
+	void setScheduling(Scheduling scheduling);
+	bool pinToNodes(const NumaTopology& topology);
+	bool areCountersEnabled() const;
+	void setCountersEnabled(bool areCountersEnabled);
+	void resetCounters();
+	const std::vector<PerfCounters::Sample>& getWorkerCounters() const;
+
+	template <typename Task>
+	void parallelFor(int taskCount, const Task& task)
+	{
+		run(taskCount, TaskRef{&task,
+			[] (const void* context, int index) { (*static_cast<const Task*>(context))(index); }});
+	}
+
+	static int defaultThreadCount();
+
+private:
+	struct TaskRef
+	{
+		const void* context{};
+		void (*invoke)(const void*, int){};
+
+		void operator()(int index) const
+		{
+			invoke(context, index);
+		}
+	};
+
+	struct alignas(64) ChunkCursor
+	{
+		std::atomic<int> next{};
+	};
+
+	std::vector<std::thread> m_workers{};
+	std::vector<ChunkCursor> m_chunkCursors{};
+	Scheduling m_scheduling = Scheduling::dynamic;
+	int m_activeThreadCount{};
+	bool m_areCountersEnabled = false;
+	std::vector<PerfCounters::Sample> m_workerCounters{};
+	std::mutex m_parallelForMutex{};
+	std::mutex m_mutex{};
+	std::condition_variable m_taskCondition{};
+	std::condition_variable m_doneCondition{};
+
+	const TaskRef* m_task{};
+	int m_taskCount{};
+	int m_taskThreadCount{};
+	std::atomic<int> m_nextTaskIndex{};
+	int m_busyWorkers{};
+	std::uint64_t m_generation{};
+	bool m_stop = false;
+
+	void run(int taskCount, const TaskRef& task);
+	void workerLoop(int threadIndex);
+	void runTasks(const TaskRef& task, int taskCount, int threadCount, int threadIndex);
+	static int calcChunkStart(int chunk, int taskCount, int threadCount);
+};
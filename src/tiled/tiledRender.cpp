@@ -0,0 +1,202 @@
+#include "tiled/tiledRender.hpp"
+
+#include "camera.hpp"
+#include "ellipsoid.hpp"
+#include "raycaster.hpp"
+#include "renderer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <sstream>
+
+constexpr int apronRows = 1;
+
+TiledRender::TiledRender(const RenderSettings& settings, int bandRows, ThreadPool& threadPool) :
+	m_settings{settings},
+	m_bandRows{bandRows},
+	m_threadPool{threadPool}
+{ }
+
+bool TiledRender::render(const std::filesystem::path& outputPath, bool shouldResume)
+{
+	using Clock = std::chrono::steady_clock;
+
+	std::filesystem::path checkpointPath = outputPath;
+	checkpointPath += ".checkpoint";
+
+	ImageStream stream{outputPath, m_settings.resolution,
+		ImageStream::formatFromPath(outputPath)};
+	std::optional<ImageStream::Checkpoint> checkpoint =
+		shouldResume ? loadCheckpoint(checkpointPath) : std::nullopt;
+	if (checkpoint && !stream.resume(*checkpoint))
+	{
+		std::cerr << "Cannot resume " << outputPath << ", starting over\n";
+		checkpoint.reset();
+	}
+	if (!checkpoint && !stream.open())
+	{
+		std::cerr << "Cannot open " << outputPath << '\n';
+		return false;
+	}
+
+	Clock::time_point start = Clock::now();
+	m_stats = {};
+	m_stats.resumedRow = stream.getCheckpoint().nextRow;
+
+	const int height = m_settings.resolution.y;
+	for (int row = stream.getCheckpoint().nextRow; row < height; row += m_bandRows)
+	{
+		int rowCount = std::min(m_bandRows, height - row);
+		renderBand(row, rowCount);
+		if (!stream.writeRows(m_bandPixels.data(), rowCount) ||
+			!saveCheckpoint(checkpointPath, stream.getCheckpoint()))
+		{
+			std::cerr << "Cannot write " << outputPath << '\n';
+			return false;
+		}
+		++m_stats.bandCount;
+	}
+
+	if (!stream.finish())
+	{
+		std::cerr << "Cannot write " << outputPath << '\n';
+		return false;
+	}
+	std::error_code error{};
+	std::filesystem::remove(checkpointPath, error);
+
+	double renderedPixels = static_cast<double>(m_settings.resolution.x) *
+		(height - m_stats.resumedRow);
+	m_stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	m_stats.megapixelsPerSecond =
+		m_stats.seconds > 0 ? renderedPixels / m_stats.seconds / 1e6 : 0;
+	return true;
+}
+
+const TiledRender::Stats& TiledRender::getStats() const
+{
+	return m_stats;
+}
+
+int TiledRender::run(const CommandLine& commandLine)
+{
+	RenderSettings settings = RenderSettings::fromCommandLine(commandLine);
+	int bandRows = std::max(commandLine.getInt("band-rows", 256), 1);
+	std::filesystem::path outputPath = commandLine.getString("output", "render.png");
+
+	ThreadPool threadPool{commandLine.getInt("threads", ThreadPool::defaultThreadCount())};
+	TiledRender tiledRender{settings, bandRows, threadPool};
+	if (!tiledRender.render(outputPath, commandLine.hasOption("resume")))
+	{
+		return 1;
+	}
+
+	const Stats& stats = tiledRender.getStats();
+	std::cout << "resolution: " << settings.resolution.x << 'x' << settings.resolution.y <<
+		", " << stats.bandCount << " bands of " << bandRows << " rows\n";
+	if (stats.resumedRow > 0)
+	{
+		std::cout << "resumed at row " << stats.resumedRow << '\n';
+	}
+	std::cout << "time: " << stats.seconds << " s, " << stats.megapixelsPerSecond <<
+		" Mpixels/s\n";
+	std::cout << "peak band buffers: " << stats.peakBufferBytes / 1024 << " KiB\n";
+	return 0;
+}
+
+void TiledRender::renderBand(int firstRow, int rowCount)
+{
+	const glm::ivec2& imageSize = m_settings.resolution;
+	int bottom = std::max(imageSize.y - firstRow - rowCount - apronRows, 0);
+	int top = std::min(imageSize.y - firstRow + apronRows, imageSize.y);
+
+	glm::ivec2 bandSize{imageSize.x, top - bottom};
+	Camera camera{imageSize, Camera::defaultNearPlane, Camera::defaultFarPlane,
+		m_settings.camera.viewWidth};
+	Ellipsoid ellipsoid{m_settings.radii.x, m_settings.radii.y, m_settings.radii.z};
+	m_settings.apply(camera, ellipsoid);
+	Raycaster raycaster{camera, ellipsoid};
+
+	Renderer renderer{bandSize};
+	renderer.setImageRegion(imageSize, {0, bottom});
+	renderer.drawPass(raycaster, 1, true, m_threadPool);
+	if (m_settings.antialiasingSamples > 1)
+	{
+		renderer.antialias(raycaster, m_settings.antialiasingSamples, m_threadPool);
+	}
+
+	std::size_t rowSize = static_cast<std::size_t>(imageSize.x) * Renderer::numOfChannels;
+	m_bandPixels.resize(rowSize * rowCount);
+	std::span<const unsigned char> bandTexture = renderer.getCpuTexture();
+	for (int row = 0; row < rowCount; ++row)
+	{
+		int localY = imageSize.y - 1 - (firstRow + row) - bottom;
+		std::memcpy(m_bandPixels.data() + row * rowSize, bandTexture.data() + localY * rowSize,
+			rowSize);
+	}
+
+	std::size_t bufferBytes = bandTexture.size() + bandTexture.size() / Renderer::numOfChannels +
+		m_bandPixels.capacity();
+	m_stats.peakBufferBytes = std::max(m_stats.peakBufferBytes, bufferBytes);
+}
+
+std::string TiledRender::getFingerprint() const
+{
+	const RenderSettings& settings = m_settings;
+	std::ostringstream fingerprint{};
+	fingerprint << std::hexfloat << settings.resolution.x << ' ' << settings.resolution.y <<
+		' ' << m_bandRows << ' ' << settings.camera.targetPos.x << ' ' <<
+		settings.camera.targetPos.y << ' ' << settings.camera.targetPos.z << ' ' <<
+		settings.camera.pitchRad << ' ' << settings.camera.yawRad << ' ' <<
+		settings.camera.viewWidth << ' ' << settings.radii.x << ' ' << settings.radii.y << ' ' <<
+		settings.radii.z << ' ' << settings.material.color.r << ' ' <<
+		settings.material.color.g << ' ' << settings.material.color.b << ' ' <<
+		settings.material.ambientCoef << ' ' << settings.material.diffuseCoef << ' ' <<
+		settings.material.specularCoef << ' ' << settings.material.shininess << ' ' <<
+		settings.antialiasingSamples;
+	return fingerprint.str();
+}
+
+std::optional<ImageStream::Checkpoint> TiledRender::loadCheckpoint(
+	const std::filesystem::path& path) const
+{
+	std::ifstream file{path};
+	std::string fingerprint{};
+	ImageStream::Checkpoint checkpoint{};
+	if (!std::getline(file, fingerprint) ||
+		!(file >> checkpoint.nextRow >> checkpoint.fileOffset >> checkpoint.adler))
+	{
+		return std::nullopt;
+	}
+	if (fingerprint != getFingerprint())
+	{
+		std::cerr << "Checkpoint " << path << " was written for different settings\n";
+		return std::nullopt;
+	}
+	return checkpoint;
+}
+
+bool TiledRender::saveCheckpoint(const std::filesystem::path& path,
+	const ImageStream::Checkpoint& checkpoint) const
+{
+	std::filesystem::path tempPath = path;
+	tempPath += ".tmp";
+	{
+		std::ofstream file{tempPath, std::ios::trunc};
+		file << getFingerprint() << '\n' << checkpoint.nextRow << ' ' << checkpoint.fileOffset <<
+			' ' << checkpoint.adler << '\n';
+		if (!file.good())
+		{
+			return false;
+		}
+	}
+
+	std::error_code error{};
+	std::filesystem::rename(tempPath, path, error);
+	return !error;
+}
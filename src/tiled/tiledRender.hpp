@@ -0,0 +1,47 @@
+#pragma once
+
+#include "commandLine.hpp"
+#include "imageStream.hpp"
+#include "renderSettings.hpp"
+#include "threadPool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+class TiledRender
+{
+public:
+	struct Stats
+	{
+		int bandCount{};
+		int resumedRow{};
+		double seconds{};
+		double megapixelsPerSecond{};
+		std::size_t peakBufferBytes{};
+	};
+
+	TiledRender(const RenderSettings& settings, int bandRows, ThreadPool& threadPool);
+
+	bool render(const std::filesystem::path& outputPath, bool shouldResume);
+	const Stats& getStats() const;
+
+	static int run(const CommandLine& commandLine);
+
+private:
+	RenderSettings m_settings{};
+	int m_bandRows{};
+	ThreadPool& m_threadPool;
+	std::vector<unsigned char> m_bandPixels{};
+	Stats m_stats{};
+
+	void renderBand(int firstRow, int rowCount);
+	std::string getFingerprint() const;
+	std::optional<ImageStream::Checkpoint> loadCheckpoint(const std::filesystem::path& path) const;
+	bool saveCheckpoint(const std::filesystem::path& path,
+		const ImageStream::Checkpoint& checkpoint) const;
+};
@@ -0,0 +1,195 @@
+#include "trace/inputTrace.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+
+std::optional<InputTrace> InputTrace::load(const std::filesystem::path& path)
+{
+	std::ifstream file{path, std::ios::binary};
+	std::vector<unsigned char> data{std::istreambuf_iterator<char>{file}, {}};
+
+	std::size_t offset = 0;
+	auto readUint32 = [&data, &offset] (std::uint32_t& value)
+		{
+			if (data.size() - offset < 4)
+			{
+				return false;
+			}
+			value = 0;
+			for (int byte = 0; byte < 4; ++byte)
+			{
+				value |= static_cast<std::uint32_t>(data[offset++]) << (8 * byte);
+			}
+			return true;
+		};
+	auto readInt32 = [&readUint32] (std::int32_t& value)
+		{
+			std::uint32_t bits{};
+			bool isRead = readUint32(bits);
+			value = static_cast<std::int32_t>(bits);
+			return isRead;
+		};
+
+	std::uint32_t fileMagic{};
+	if (!readUint32(fileMagic) || fileMagic != magic || offset == data.size() ||
+		data[offset++] != version)
+	{
+		return std::nullopt;
+	}
+
+	InputTrace trace{};
+	if (!readInt32(trace.m_initialViewportSize.x) || !readInt32(trace.m_initialViewportSize.y) ||
+		trace.m_initialViewportSize.x <= 0 || trace.m_initialViewportSize.y <= 0)
+	{
+		return std::nullopt;
+	}
+
+	std::int64_t timeUs = 0;
+	while (offset < data.size())
+	{
+		Event event{};
+		std::uint8_t type = data[offset++];
+		if (type > static_cast<std::uint8_t>(EventType::lightCount))
+		{
+			return std::nullopt;
+		}
+		event.type = static_cast<EventType>(type);
+
+		std::uint32_t deltaUs{};
+		if (!readUint32(deltaUs))
+		{
+			return std::nullopt;
+		}
+		timeUs += deltaUs;
+		event.timeUs = timeUs;
+
+		bool isRead = true;
+		if (event.type == EventType::resize)
+		{
+			isRead = readInt32(event.size.x) && readInt32(event.size.y) && event.size.x > 0 &&
+				event.size.y > 0;
+		}
+		else if (hasIntValue(event.type))
+		{
+			isRead = readInt32(event.intValue);
+		}
+		else if (hasFloatValue(event.type))
+		{
+			std::uint32_t bits{};
+			isRead = readUint32(bits);
+			event.floatValue = std::bit_cast<float>(bits);
+		}
+		if (!isRead)
+		{
+			return std::nullopt;
+		}
+		trace.m_events.push_back(event);
+	}
+	return trace;
+}
+
+const glm::ivec2& InputTrace::getInitialViewportSize() const
+{
+	return m_initialViewportSize;
+}
+
+const std::vector<InputTrace::Event>& InputTrace::getEvents() const
+{
+	return m_events;
+}
+
+int InputTrace::getFrameCount() const
+{
+	return static_cast<int>(std::count_if(m_events.begin(), m_events.end(),
+		[] (const Event& event)
+		{
+			return event.type == EventType::frame;
+		}));
+}
+
+bool InputTrace::hasIntValue(EventType type)
+{
+	switch (type)
+	{
+		case EventType::backend:
+		case EventType::accuracy:
+		case EventType::antialiasing:
+		case EventType::refinement:
+		case EventType::sampleBatch:
+		case EventType::lightCount:
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool InputTrace::hasFloatValue(EventType type)
+{
+	return type != EventType::frame && type != EventType::resize && !hasIntValue(type);
+}
+
+InputRecorder::InputRecorder(const std::filesystem::path& path,
+	const glm::ivec2& initialViewportSize) :
+	m_file{path, std::ios::binary | std::ios::trunc}
+{
+	writeUint32(InputTrace::magic);
+	m_file.put(static_cast<char>(InputTrace::version));
+	writeUint32(static_cast<std::uint32_t>(initialViewportSize.x));
+	writeUint32(static_cast<std::uint32_t>(initialViewportSize.y));
+}
+
+bool InputRecorder::isGood() const
+{
+	return m_file.good();
+}
+
+int InputRecorder::getEventCount() const
+{
+	return m_eventCount;
+}
+
+void InputRecorder::record(InputTrace::EventType type)
+{
+	writeHeader(type);
+}
+
+void InputRecorder::record(InputTrace::EventType type, int value)
+{
+	writeHeader(type);
+	writeUint32(static_cast<std::uint32_t>(value));
+}
+
+void InputRecorder::record(InputTrace::EventType type, float value)
+{
+	writeHeader(type);
+	writeUint32(std::bit_cast<std::uint32_t>(value));
+}
+
+void InputRecorder::record(InputTrace::EventType type, const glm::ivec2& viewportSize)
+{
+	writeHeader(type);
+	writeUint32(static_cast<std::uint32_t>(viewportSize.x));
+	writeUint32(static_cast<std::uint32_t>(viewportSize.y));
+}
+
+void InputRecorder::writeHeader(InputTrace::EventType type)
+{
+	Clock::time_point now = Clock::now();
+	std::int64_t deltaUs =
+		std::chrono::duration_cast<std::chrono::microseconds>(now - m_lastEventTime).count();
+	m_lastEventTime += std::chrono::microseconds{deltaUs};
+	++m_eventCount;
+
+	m_file.put(static_cast<char>(type));
+	writeUint32(static_cast<std::uint32_t>(std::clamp<std::int64_t>(deltaUs, 0, UINT32_MAX)));
+}
+
+void InputRecorder::writeUint32(std::uint32_t value)
+{
+	for (int byte = 0; byte < 4; ++byte)
+	{
+		m_file.put(static_cast<char>(value >> (8 * byte)));
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <vector>
+
+class InputTrace
+{
+public:
+	enum class EventType : std::uint8_t
+	{
+		frame,
+		resize,
+		moveX,
+		moveY,
+		addPitch,
+		addYaw,
+		zoom,
+		backend,
+		accuracy,
+		antialiasing,
+		refinement,
+		sampleBatch,
+		viewWidth,
+		ambient,
+		diffuse,
+		specular,
+		shininess,
+		ellipsoidA,
+		ellipsoidB,
+		ellipsoidC,
+		lightCount
+	};
+
+	struct Event
+	{
+		std::int64_t timeUs{};
+		EventType type = EventType::frame;
+		glm::ivec2 size{};
+		std::int32_t intValue{};
+		float floatValue{};
+	};
+
+	static constexpr const char* defaultPath = "ellipsoid-raycasting.trace";
+
+	static std::optional<InputTrace> load(const std::filesystem::path& path);
+
+	const glm::ivec2& getInitialViewportSize() const;
+	const std::vector<Event>& getEvents() const;
+	int getFrameCount() const;
+
+private:
+	glm::ivec2 m_initialViewportSize{};
+	std::vector<Event> m_events{};
+
+	friend class InputRecorder;
+
+	static constexpr std::uint32_t magic = 0x54524945;
+	static constexpr std::uint8_t version = 1;
+
+	static bool hasIntValue(EventType type);
+	static bool hasFloatValue(EventType type);
+};
+
+class InputRecorder
+{
+public:
+	InputRecorder(const std::filesystem::path& path, const glm::ivec2& initialViewportSize);
+
+	bool isGood() const;
+	int getEventCount() const;
+
+	void record(InputTrace::EventType type);
+	void record(InputTrace::EventType type, int value);
+	void record(InputTrace::EventType type, float value);
+	void record(InputTrace::EventType type, const glm::ivec2& viewportSize);
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	std::ofstream m_file{};
+	Clock::time_point m_lastEventTime = Clock::now();
+	int m_eventCount{};
+
+	void writeHeader(InputTrace::EventType type);
+	void writeUint32(std::uint32_t value);
+};
@@ -0,0 +1,308 @@
+#include "trace/traceReplay.hpp"
+
+#include "service/loadTest.hpp"
+#include "shaderPrograms.hpp"
+#include "splitView.hpp"
+
+#include <glad/glad.h>
+#include <glfw/glfw3.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+
+TraceReplay::TraceReplay(const InputTrace& trace, GLFWwindow* window) :
+	m_trace{trace},
+	m_window{window}
+{ }
+
+TraceReplay::Stats TraceReplay::replay(bool isRealTime)
+{
+	using Clock = std::chrono::steady_clock;
+
+	resize(m_trace.getInitialViewportSize());
+	m_latencyTracker.reset();
+	Stats stats{};
+	{
+		Scene scene{m_viewportSize, m_threadPool};
+		std::chrono::duration<float> frameInterval{SplitView::defaultFrameInterval};
+		std::int64_t lastFrameUs = -1;
+		Clock::time_point start = Clock::now();
+		for (const InputTrace::Event& event : m_trace.getEvents())
+		{
+			Clock::time_point scheduledTime = start + std::chrono::microseconds{event.timeUs};
+			if (isRealTime)
+			{
+				std::this_thread::sleep_until(scheduledTime);
+			}
+
+			if (event.type != InputTrace::EventType::frame)
+			{
+				m_latencyTracker.recordInput(isRealTime ? scheduledTime : Clock::now());
+				apply(scene, event);
+				++stats.inputCount;
+				continue;
+			}
+
+			Clock::time_point frameStart = Clock::now();
+			scene.render();
+			m_latencyTracker.submitFrame(scene.isConverged());
+			glFinish();
+			Clock::time_point frameEnd = Clock::now();
+			m_latencyTracker.update();
+			if (lastFrameUs >= 0)
+			{
+				frameInterval = std::chrono::microseconds{event.timeUs - lastFrameUs};
+			}
+			lastFrameUs = event.timeUs;
+			if (isRealTime)
+			{
+				scene.speculate(frameStart + SplitView::frameBudget, frameInterval);
+			}
+
+			stats.frameMs.push_back(
+				std::chrono::duration<double, std::milli>(frameEnd - frameStart).count());
+			if (isRealTime)
+			{
+				stats.scheduleLagMs.push_back(
+					std::chrono::duration<double, std::milli>(frameStart - scheduledTime).count());
+			}
+			++stats.frameCount;
+		}
+		m_latencyTracker.flush();
+		scene.setSpeculationEnabled(false);
+		stats.speculation = scene.getSpeculativeFramePool().getStats();
+		stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	}
+	return stats;
+}
+
+const LatencyTracker& TraceReplay::getLatencyTracker() const
+{
+	return m_latencyTracker;
+}
+
+int TraceReplay::run(const CommandLine& commandLine)
+{
+	std::string tracePath = commandLine.getString("trace", InputTrace::defaultPath);
+	std::string speed = commandLine.getString("speed", "recorded");
+	int repeatCount = std::max(commandLine.getInt("repeat", 1), 1);
+	double latencyFraction = std::clamp(commandLine.getFloat("latency-percentile", 0.99f), 0.0f,
+		1.0f);
+	double maxLatencyMs = commandLine.getFloat("max-latency-ms", 0);
+	double maxConvergedLatencyMs = commandLine.getFloat("max-converged-latency-ms", 0);
+	if (speed != "recorded" && speed != "max")
+	{
+		std::cerr << "Invalid value of --speed: " << speed << '\n';
+		return 1;
+	}
+
+	std::optional<InputTrace> trace = InputTrace::load(tracePath);
+	if (!trace.has_value())
+	{
+		std::cerr << "Cannot read input trace: " << tracePath << '\n';
+		return 1;
+	}
+
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 2);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	const glm::ivec2& initialSize = trace->getInitialViewportSize();
+	GLFWwindow* window = glfwCreateWindow(initialSize.x, initialSize.y, "ellipsoid-raycasting",
+		nullptr, nullptr);
+	if (window == nullptr)
+	{
+		std::cerr << "Cannot create an OpenGL 4.2 context\n";
+		glfwTerminate();
+		return 1;
+	}
+	glfwMakeContextCurrent(window);
+	gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress));
+	ShaderPrograms::init();
+
+	std::vector<double> recordedIntervalsMs{};
+	std::int64_t lastFrameUs = -1;
+	for (const InputTrace::Event& event : trace->getEvents())
+	{
+		if (event.type == InputTrace::EventType::frame)
+		{
+			if (lastFrameUs >= 0)
+			{
+				recordedIntervalsMs.push_back((event.timeUs - lastFrameUs) / 1000.0);
+			}
+			lastFrameUs = event.timeUs;
+		}
+	}
+	double recordedSeconds =
+		trace->getEvents().empty() ? 0 : trace->getEvents().back().timeUs / 1e6;
+	std::cout << "trace: " << trace->getEvents().size() << " events, " <<
+		trace->getFrameCount() << " frames, " << recordedSeconds << " s, initial viewport " <<
+		initialSize.x << 'x' << initialSize.y << '\n';
+	printDistribution(std::cout, "recorded frame interval", recordedIntervalsMs);
+
+	bool isWithinLimits = true;
+	{
+		TraceReplay replay{*trace, window};
+		for (int repeat = 0; repeat < repeatCount; ++repeat)
+		{
+			Stats stats = replay.replay(speed == "recorded");
+			std::cout << "replay " << repeat + 1 << " (" << speed << " speed): " <<
+				stats.frameCount << " frames, " << stats.inputCount << " inputs, " <<
+				stats.seconds << " s, " << stats.frameCount / std::max(stats.seconds, 1e-9) <<
+				" fps\n";
+			printDistribution(std::cout, "frame time", stats.frameMs);
+			if (!stats.scheduleLagMs.empty())
+			{
+				printDistribution(std::cout, "schedule lag", stats.scheduleLagMs);
+			}
+			if (stats.speculation.frameCount > 0)
+			{
+				printSpeculation(std::cout, stats.speculation);
+			}
+			const LatencyTracker& latencyTracker = replay.getLatencyTracker();
+			latencyTracker.printReport(std::cout);
+			isWithinLimits = checkLatency(std::cout, latencyTracker,
+				LatencyTracker::Stage::firstEffect, latencyFraction, maxLatencyMs) &&
+				isWithinLimits;
+			isWithinLimits = checkLatency(std::cout, latencyTracker,
+				LatencyTracker::Stage::converged, latencyFraction, maxConvergedLatencyMs) &&
+				isWithinLimits;
+		}
+	}
+
+	glfwTerminate();
+	return isWithinLimits ? 0 : 1;
+}
+
+void TraceReplay::apply(Scene& scene, const InputTrace::Event& event)
+{
+	using EventType = InputTrace::EventType;
+
+	switch (event.type)
+	{
+		case EventType::frame:
+			break;
+		case EventType::resize:
+			resize(event.size);
+			scene.updateViewportSize();
+			break;
+		case EventType::moveX:
+			scene.moveXCamera(event.floatValue);
+			break;
+		case EventType::moveY:
+			scene.moveYCamera(event.floatValue);
+			break;
+		case EventType::addPitch:
+			scene.addPitchCamera(event.floatValue);
+			break;
+		case EventType::addYaw:
+			scene.addYawCamera(event.floatValue);
+			break;
+		case EventType::zoom:
+			scene.zoomCamera(event.floatValue);
+			break;
+		case EventType::backend:
+			scene.setBackend(static_cast<RenderBackend::Type>(event.intValue));
+			break;
+		case EventType::accuracy:
+			scene.setAccuracy(event.intValue);
+			break;
+		case EventType::antialiasing:
+			scene.setAntialiasing(event.intValue);
+			break;
+		case EventType::refinement:
+			scene.setRefinement(static_cast<CpuRenderBackend::Refinement>(event.intValue));
+			break;
+		case EventType::sampleBatch:
+			scene.setSampleBatch(event.intValue);
+			break;
+		case EventType::viewWidth:
+			scene.setViewWidth(event.floatValue);
+			break;
+		case EventType::ambient:
+			scene.setAmbient(event.floatValue);
+			break;
+		case EventType::diffuse:
+			scene.setDiffuse(event.floatValue);
+			break;
+		case EventType::specular:
+			scene.setSpecular(event.floatValue);
+			break;
+		case EventType::shininess:
+			scene.setShininess(event.floatValue);
+			break;
+		case EventType::ellipsoidA:
+			scene.setEllipsoidA(event.floatValue);
+			break;
+		case EventType::ellipsoidB:
+			scene.setEllipsoidB(event.floatValue);
+			break;
+		case EventType::ellipsoidC:
+			scene.setEllipsoidC(event.floatValue);
+			break;
+		case EventType::lightCount:
+			scene.setLightCount(event.intValue);
+			break;
+	}
+}
+
+void TraceReplay::resize(const glm::ivec2& viewportSize)
+{
+	m_viewportSize = viewportSize;
+	glfwSetWindowSize(m_window, viewportSize.x, viewportSize.y);
+	glViewport(0, 0, viewportSize.x, viewportSize.y);
+}
+
+void TraceReplay::printDistribution(std::ostream& output, const char* name,
+	std::vector<double>& values)
+{
+	if (values.empty())
+	{
+		output << name << ": no samples\n";
+		return;
+	}
+
+	double sum = 0;
+	for (double value : values)
+	{
+		sum += value;
+	}
+	output << name << ": " << values.size() << " samples, mean " << sum / values.size() <<
+		" ms, p50 " << LoadTest::percentile(values, 0.5) << " ms, p90 " <<
+		LoadTest::percentile(values, 0.9) << " ms, p99 " << LoadTest::percentile(values, 0.99) <<
+		" ms, max " << LoadTest::percentile(values, 1.0) << " ms\n";
+}
+
+void TraceReplay::printSpeculation(std::ostream& output,
+	const SpeculativeFramePool::Stats& stats)
+{
+	std::uint64_t lookupCount = stats.hitCount + stats.missCount;
+	double hitRate = lookupCount > 0 ? static_cast<double>(stats.hitCount) / lookupCount : 0;
+	output << "speculation: " << stats.hitCount << '/' << lookupCount << " poses hit (" <<
+		100 * hitRate << "%), " << stats.wastedCount << '/' << stats.frameCount <<
+		" frames wasted, " << stats.wastedMs << '/' << stats.renderMs << " ms wasted\n";
+}
+
+bool TraceReplay::checkLatency(std::ostream& output, const LatencyTracker& latencyTracker,
+	LatencyTracker::Stage stage, double fraction, double maxMs)
+{
+	if (maxMs <= 0 || latencyTracker.getSampleCount(stage) == 0)
+	{
+		return true;
+	}
+
+	double latencyMs = latencyTracker.getPercentile(stage, fraction);
+	if (latencyMs <= maxMs)
+	{
+		return true;
+	}
+	output << "latency regression: p" << fraction * 100 << " input to " <<
+		LatencyTracker::getStageName(stage) << ' ' << latencyMs << " ms exceeds " << maxMs <<
+		" ms\n";
+	return false;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "commandLine.hpp"
+#include "latencyTracker.hpp"
+#include "scene.hpp"
+#include "speculativeFramePool.hpp"
+#include "threadPool.hpp"
+#include "trace/inputTrace.hpp"
+
+#include <glm/glm.hpp>
+
+#include <ostream>
+#include <vector>
+
+struct GLFWwindow;
+
+class TraceReplay
+{
+public:
+	struct Stats
+	{
+		int frameCount{};
+		int inputCount{};
+		double seconds{};
+		std::vector<double> frameMs{};
+		std::vector<double> scheduleLagMs{};
+		SpeculativeFramePool::Stats speculation{};
+	};
+
+	TraceReplay(const InputTrace& trace, GLFWwindow* window);
+
+	Stats replay(bool isRealTime);
+	const LatencyTracker& getLatencyTracker() const;
+
+	static int run(const CommandLine& commandLine);
+
+private:
+	const InputTrace& m_trace;
+	GLFWwindow* m_window{};
+	glm::ivec2 m_viewportSize{};
+	ThreadPool m_threadPool{};
+	LatencyTracker m_latencyTracker{};
+
+	void apply(Scene& scene, const InputTrace::Event& event);
+	void resize(const glm::ivec2& viewportSize);
+
+	static void printDistribution(std::ostream& output, const char* name,
+		std::vector<double>& values);
+	static void printSpeculation(std::ostream& output,
+		const SpeculativeFramePool::Stats& stats);
+	static bool checkLatency(std::ostream& output, const LatencyTracker& latencyTracker,
+		LatencyTracker::Stage stage, double fraction, double maxMs);
+};
@@ -0,0 +1,227 @@
+#include "tuning/autoTuner.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string>
+
+AutoTuner::AutoTuner(ThreadPool& threadPool, std::chrono::milliseconds budget) :
+	m_threadPool{threadPool},
+	m_budget{budget},
+	m_camera{m_viewportSize, Camera::defaultNearPlane, Camera::defaultFarPlane,
+		m_settings.camera.viewWidth},
+	m_ellipsoid{m_settings.radii.x, m_settings.radii.y, m_settings.radii.z},
+	m_renderer{m_viewportSize}
+{
+	m_settings.resolution = m_viewportSize;
+	m_settings.apply(m_camera, m_ellipsoid);
+}
+
+RenderProfile AutoTuner::tune()
+{
+	start();
+	while (!step())
+	{ }
+	return m_profile;
+}
+
+void AutoTuner::start()
+{
+	const std::vector<int> threadCounts = getThreadCounts(m_threadPool.getThreadCount());
+	m_trials.clear();
+	m_referenceFrame.clear();
+	m_trialBudget = m_budget / static_cast<double>(tunedPrecisions.size() + 1 + tileSizes.size() +
+		threadCounts.size());
+
+	m_profile = {};
+	m_profile.threadCount = m_threadPool.getThreadCount();
+	m_plan.clear();
+	for (Raycaster::Precision precision : tunedPrecisions)
+	{
+		m_profile.precision = precision;
+		m_plan.push_back(m_profile);
+	}
+	m_planIndex = 0;
+	m_phase = Phase::precision;
+	m_phaseTrial = 0;
+}
+
+bool AutoTuner::step()
+{
+	if (!isTuning())
+	{
+		return true;
+	}
+
+	const int activeThreadCount = m_threadPool.getActiveThreadCount();
+	measure(m_plan[m_planIndex++]);
+	m_threadPool.setActiveThreadCount(activeThreadCount);
+	if (m_planIndex == m_plan.size())
+	{
+		finishPhase();
+	}
+	return !isTuning();
+}
+
+bool AutoTuner::isTuning() const
+{
+	return m_phase != Phase::done;
+}
+
+const RenderProfile& AutoTuner::getProfile() const
+{
+	return m_profile;
+}
+
+const std::vector<AutoTuner::Trial>& AutoTuner::getTrials() const
+{
+	return m_trials;
+}
+
+int AutoTuner::run(const CommandLine& commandLine)
+{
+	ThreadPool threadPool{commandLine.getInt("threads", ThreadPool::defaultThreadCount())};
+	int budgetMs = commandLine.getInt("budget-ms", static_cast<int>(defaultBudget.count()));
+	AutoTuner tuner{threadPool, std::chrono::milliseconds{std::max(budgetMs, 1)}};
+
+	using Clock = std::chrono::steady_clock;
+	Clock::time_point start = Clock::now();
+	RenderProfile profile = tuner.tune();
+	double tuneMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+	std::cout << "calibration at " << calibrationResolution.x << 'x' <<
+		calibrationResolution.y << ", " << threadPool.getThreadCount() << " threads available\n";
+	for (const Trial& trial : tuner.getTrials())
+	{
+		std::cout << "  " << trial.profile.getDescription() << ": " << trial.profile.passMs <<
+			" ms per pass" << (trial.isAccurate ? "" : " (inaccurate, skipped)") << '\n';
+	}
+	std::cout << "selected " << profile.getDescription() << ", " << profile.passMs <<
+		" ms per pass, tuned in " << tuneMs << " ms\n";
+
+	std::string profilePath = commandLine.getString("profile",
+		RenderProfile::getDefaultPath().string());
+	if (!profile.save(profilePath))
+	{
+		std::cerr << "Cannot write render profile: " << profilePath << '\n';
+		return 1;
+	}
+	std::cout << "saved " << profilePath << '\n';
+	return 0;
+}
+
+const AutoTuner::Trial& AutoTuner::measure(const RenderProfile& profile)
+{
+	using Clock = std::chrono::steady_clock;
+
+	m_threadPool.setActiveThreadCount(profile.threadCount);
+	m_renderer.setTraversal(profile.traversal);
+	m_renderer.setTileSize(profile.tileSize);
+	Raycaster raycaster{m_camera, m_ellipsoid};
+	raycaster.setPrecision(profile.precision);
+
+	Trial trial{profile};
+	trial.profile.passMs = std::numeric_limits<double>::max();
+	Clock::time_point start = Clock::now();
+	for (int run = 0; run < minRunCount || Clock::now() - start < m_trialBudget; ++run)
+	{
+		Clock::time_point passStart = Clock::now();
+		m_renderer.drawPass(raycaster, 1, true, m_threadPool);
+		trial.profile.passMs = std::min(trial.profile.passMs,
+			std::chrono::duration<double, std::milli>(Clock::now() - passStart).count());
+	}
+
+	std::span<const unsigned char> frame = m_renderer.getCpuTexture();
+	if (m_referenceFrame.empty())
+	{
+		m_referenceFrame.assign(frame.begin(), frame.end());
+	}
+	trial.isAccurate = isAccurate(frame);
+	m_trials.push_back(trial);
+	return m_trials.back();
+}
+
+bool AutoTuner::isAccurate(std::span<const unsigned char> frame) const
+{
+	return std::ranges::equal(frame, m_referenceFrame,
+		[] (unsigned char left, unsigned char right)
+		{
+			return std::abs(left - right) <= maxChannelError;
+		}
+	);
+}
+
+void AutoTuner::finishPhase()
+{
+	const std::size_t phaseTrial = m_phaseTrial;
+	const RenderProfile fastest = findFastest(phaseTrial);
+	m_phaseTrial = m_trials.size();
+	m_plan.clear();
+	m_planIndex = 0;
+	switch (m_phase)
+	{
+		case Phase::precision:
+			m_profile = fastest;
+			m_profile.traversal = Renderer::Traversal::rowMajor;
+			m_plan.push_back(m_profile);
+			m_profile.traversal = Renderer::Traversal::morton;
+			for (int tileSize : tileSizes)
+			{
+				m_profile.tileSize = tileSize;
+				m_plan.push_back(m_profile);
+			}
+			m_phase = Phase::traversal;
+			break;
+
+		case Phase::traversal:
+			m_profile = fastest;
+			for (int threadCount : getThreadCounts(m_threadPool.getThreadCount()))
+			{
+				m_profile.threadCount = threadCount;
+				m_plan.push_back(m_profile);
+			}
+			m_phase = Phase::threadCount;
+			break;
+
+		case Phase::threadCount:
+			for (std::size_t trial = phaseTrial; trial < m_trials.size(); ++trial)
+			{
+				if (m_trials[trial].profile.passMs <= fastest.passMs * threadCountTolerance)
+				{
+					m_profile = m_trials[trial].profile;
+					break;
+				}
+			}
+			m_phase = Phase::done;
+			break;
+
+		case Phase::done:
+			break;
+	}
+}
+
+RenderProfile AutoTuner::findFastest(std::size_t firstTrial) const
+{
+	RenderProfile fastest = m_trials[firstTrial].profile;
+	for (std::size_t trial = firstTrial; trial < m_trials.size(); ++trial)
+	{
+		if (m_trials[trial].isAccurate && m_trials[trial].profile.passMs < fastest.passMs)
+		{
+			fastest = m_trials[trial].profile;
+		}
+	}
+	return fastest;
+}
+
+std::vector<int> AutoTuner::getThreadCounts(int maxThreadCount)
+{
+	std::vector<int> threadCounts{};
+	for (int threadCount = 1; threadCount < maxThreadCount; threadCount *= 2)
+	{
+		threadCounts.push_back(threadCount);
+	}
+	threadCounts.push_back(maxThreadCount);
+	return threadCounts;
+}
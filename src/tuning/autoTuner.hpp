@@ -0,0 +1,78 @@
+#pragma once
+
+#include "camera.hpp"
+#include "commandLine.hpp"
+#include "ellipsoid.hpp"
+#include "renderSettings.hpp"
+#include "renderer.hpp"
+#include "threadPool.hpp"
+#include "tuning/renderProfile.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+class AutoTuner
+{
+public:
+	struct Trial
+	{
+		RenderProfile profile{};
+		bool isAccurate{};
+	};
+
+	static constexpr glm::ivec2 calibrationResolution{960, 540};
+	static constexpr std::chrono::milliseconds defaultBudget{400};
+	static constexpr int minRunCount = 2;
+	static constexpr double threadCountTolerance = 1.05;
+	static constexpr int maxChannelError = 2;
+	static constexpr std::array<int, 3> tileSizes{32, 64, 128};
+	static constexpr std::array<Raycaster::Precision, 2> tunedPrecisions{
+		Raycaster::Precision::fp64, Raycaster::Precision::adaptive};
+
+	AutoTuner(ThreadPool& threadPool, std::chrono::milliseconds budget = defaultBudget);
+
+	RenderProfile tune();
+	void start();
+	bool step();
+	bool isTuning() const;
+	const RenderProfile& getProfile() const;
+	const std::vector<Trial>& getTrials() const;
+
+	static int run(const CommandLine& commandLine);
+
+private:
+	enum class Phase
+	{
+		precision,
+		traversal,
+		threadCount,
+		done
+	};
+
+	ThreadPool& m_threadPool;
+	std::chrono::milliseconds m_budget;
+	glm::ivec2 m_viewportSize{calibrationResolution};
+	RenderSettings m_settings{};
+	Camera m_camera;
+	Ellipsoid m_ellipsoid;
+	Renderer m_renderer;
+	std::vector<unsigned char> m_referenceFrame{};
+	std::vector<Trial> m_trials{};
+	std::chrono::duration<double, std::milli> m_trialBudget{};
+	Phase m_phase = Phase::done;
+	std::vector<RenderProfile> m_plan{};
+	std::size_t m_planIndex{};
+	std::size_t m_phaseTrial{};
+	RenderProfile m_profile{};
+
+	const Trial& measure(const RenderProfile& profile);
+	bool isAccurate(std::span<const unsigned char> frame) const;
+	void finishPhase();
+	RenderProfile findFastest(std::size_t firstTrial) const;
+	static std::vector<int> getThreadCounts(int maxThreadCount);
+};
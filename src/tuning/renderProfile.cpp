@@ -0,0 +1,238 @@
+#include "tuning/renderProfile.hpp"
+
+#include "numaTopology.hpp"
+#include "userCache.hpp"
+
+#ifdef _WIN32
+#include <intrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+
+constexpr std::string_view profileDirectory = "ellipsoid-raycasting-profile";
+constexpr std::uint64_t fnvOffsetBasis = 14695981039346656037ull;
+constexpr std::uint64_t fnvPrime = 1099511628211ull;
+constexpr std::array<Renderer::Traversal, 2> traversals{Renderer::Traversal::rowMajor,
+	Renderer::Traversal::morton};
+constexpr std::array<Raycaster::Precision, 3> precisions{Raycaster::Precision::fp32,
+	Raycaster::Precision::adaptive, Raycaster::Precision::fp64};
+
+bool RenderProfile::save(const std::filesystem::path& path) const
+{
+	std::error_code error{};
+	if (path.has_parent_path())
+	{
+		std::filesystem::create_directories(path.parent_path(), error);
+	}
+	std::filesystem::path tempPath = path;
+	tempPath += ".tmp";
+	{
+		std::ofstream file{tempPath, std::ios::trunc};
+		file << "machine " << getMachineId() << '\n';
+		file << "threads " << threadCount << '\n';
+		file << "traversal " << getTraversalName(traversal) << '\n';
+		file << "tile-size " << tileSize << '\n';
+		file << "precision " << getPrecisionName(precision) << '\n';
+		file << "pass-ms " << passMs << '\n';
+		if (!file.flush())
+		{
+			return false;
+		}
+	}
+	std::filesystem::rename(tempPath, path, error);
+	return !error;
+}
+
+std::string RenderProfile::getDescription() const
+{
+	std::ostringstream description{};
+	description << threadCount << " threads, " << getTraversalName(traversal);
+	if (traversal == Renderer::Traversal::morton)
+	{
+		description << ' ' << tileSize << "px tiles";
+	}
+	description << ", " << getPrecisionName(precision);
+	return description.str();
+}
+
+std::optional<RenderProfile> RenderProfile::load(const std::filesystem::path& path)
+{
+	std::ifstream file{path};
+	if (!file)
+	{
+		return std::nullopt;
+	}
+
+	RenderProfile profile{};
+	bool isMachineMatching = false;
+	std::string line{};
+	while (std::getline(file, line))
+	{
+		std::size_t separator = line.find(' ');
+		if (separator == std::string::npos)
+		{
+			return std::nullopt;
+		}
+		std::string key = line.substr(0, separator);
+		std::string value = line.substr(separator + 1);
+		try
+		{
+			if (key == "machine")
+			{
+				isMachineMatching = value == getMachineId();
+			}
+			else if (key == "threads")
+			{
+				profile.threadCount = std::stoi(value);
+			}
+			else if (key == "traversal")
+			{
+				std::optional<Renderer::Traversal> traversal = parseTraversal(value);
+				if (!traversal.has_value())
+				{
+					return std::nullopt;
+				}
+				profile.traversal = *traversal;
+			}
+			else if (key == "tile-size")
+			{
+				profile.tileSize = std::stoi(value);
+			}
+			else if (key == "precision")
+			{
+				std::optional<Raycaster::Precision> precision = parsePrecision(value);
+				if (!precision.has_value() || *precision == Raycaster::Precision::fp32)
+				{
+					return std::nullopt;
+				}
+				profile.precision = *precision;
+			}
+			else if (key == "pass-ms")
+			{
+				profile.passMs = std::stod(value);
+			}
+		}
+		catch (const std::exception&)
+		{
+			return std::nullopt;
+		}
+	}
+
+	if (!isMachineMatching || profile.threadCount < 1 ||
+		profile.threadCount > ThreadPool::defaultThreadCount() ||
+		!Renderer::isTileSizeValid(profile.tileSize))
+	{
+		return std::nullopt;
+	}
+	return profile;
+}
+
+std::filesystem::path RenderProfile::getDefaultPath()
+{
+	std::uint64_t hash = fnvOffsetBasis;
+	for (char character : getMachineId())
+	{
+		hash = (hash ^ static_cast<unsigned char>(character)) * fnvPrime;
+	}
+
+	std::ostringstream fileName{};
+	fileName << "render-profile-" << std::hex << hash << ".txt";
+	return UserCache::getDirectory(profileDirectory) / fileName.str();
+}
+
+std::string RenderProfile::getMachineId()
+{
+	std::string cpuName{};
+#ifdef _WIN32
+	std::array<int, 4> registers{};
+	__cpuid(registers.data(), 0x80000000);
+	if (static_cast<unsigned int>(registers[0]) >= 0x80000004)
+	{
+		std::array<char, 3 * sizeof(registers) + 1> brand{};
+		for (int leaf = 0; leaf < 3; ++leaf)
+		{
+			__cpuid(registers.data(), 0x80000002 + leaf);
+			std::memcpy(brand.data() + leaf * sizeof(registers), registers.data(),
+				sizeof(registers));
+		}
+		cpuName = brand.data();
+	}
+#else
+	std::ifstream cpuInfo{"/proc/cpuinfo"};
+	std::string line{};
+	while (std::getline(cpuInfo, line))
+	{
+		std::size_t separator = line.find(':');
+		if (line.starts_with("model name") && separator != std::string::npos)
+		{
+			cpuName = line.substr(std::min(separator + 2, line.size()));
+			break;
+		}
+	}
+#endif
+	if (cpuName.empty())
+	{
+		cpuName = "unknown";
+	}
+
+	std::ostringstream machineId{};
+	machineId << cpuName << '/' << ThreadPool::defaultThreadCount() << '/' <<
+		NumaTopology::detect().getNodeCount();
+	return machineId.str();
+}
+
+std::optional<Renderer::Traversal> RenderProfile::parseTraversal(const std::string& name)
+{
+	for (Renderer::Traversal traversal : traversals)
+	{
+		if (name == getTraversalName(traversal))
+		{
+			return traversal;
+		}
+	}
+	return std::nullopt;
+}
+
+std::optional<Raycaster::Precision> RenderProfile::parsePrecision(const std::string& name)
+{
+	for (Raycaster::Precision precision : precisions)
+	{
+		if (name == getPrecisionName(precision))
+		{
+			return precision;
+		}
+	}
+	return std::nullopt;
+}
+
+const char* RenderProfile::getTraversalName(Renderer::Traversal traversal)
+{
+	switch (traversal)
+	{
+		case Renderer::Traversal::rowMajor:
+			return "row-major";
+		case Renderer::Traversal::morton:
+			return "morton";
+	}
+	return "row-major";
+}
+
+const char* RenderProfile::getPrecisionName(Raycaster::Precision precision)
+{
+	switch (precision)
+	{
+		case Raycaster::Precision::fp32:
+			return "fp32";
+		case Raycaster::Precision::adaptive:
+			return "adaptive";
+		case Raycaster::Precision::fp64:
+			return "fp64";
+	}
+	return "adaptive";
+}
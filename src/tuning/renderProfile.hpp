@@ -0,0 +1,29 @@
+#pragma once
+
+#include "raycaster.hpp"
+#include "renderer.hpp"
+#include "threadPool.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+struct RenderProfile
+{
+	int threadCount = ThreadPool::defaultThreadCount();
+	Renderer::Traversal traversal = Renderer::Traversal::rowMajor;
+	int tileSize = Renderer::traversalTileSize;
+	Raycaster::Precision precision = Raycaster::Precision::adaptive;
+	double passMs{};
+
+	bool save(const std::filesystem::path& path) const;
+	std::string getDescription() const;
+
+	static std::optional<RenderProfile> load(const std::filesystem::path& path);
+	static std::filesystem::path getDefaultPath();
+	static std::string getMachineId();
+	static std::optional<Renderer::Traversal> parseTraversal(const std::string& name);
+	static std::optional<Raycaster::Precision> parsePrecision(const std::string& name);
+	static const char* getTraversalName(Renderer::Traversal traversal);
+	static const char* getPrecisionName(Raycaster::Precision precision);
+};
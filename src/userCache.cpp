@@ -0,0 +1,46 @@
+#include "userCache.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <system_error>
+
+namespace UserCache
+{
+	static std::filesystem::path getEnvironmentPath(const char* name)
+	{
+#ifdef _WIN32
+		char* value{};
+		std::size_t size{};
+		std::filesystem::path path{};
+		if (_dupenv_s(&value, &size, name) == 0 && value != nullptr)
+		{
+			path = value;
+		}
+		std::free(value);
+		return path;
+#else
+		const char* value = std::getenv(name);
+		return value != nullptr ? std::filesystem::path{value} : std::filesystem::path{};
+#endif
+	}
+
+	std::filesystem::path getDirectory(std::string_view name)
+	{
+#ifdef _WIN32
+		std::filesystem::path root = getEnvironmentPath("LOCALAPPDATA");
+#else
+		std::filesystem::path root = getEnvironmentPath("XDG_CACHE_HOME");
+		if (!root.is_absolute())
+		{
+			root = getEnvironmentPath("HOME");
+			root = root.is_absolute() ? root / ".cache" : std::filesystem::path{};
+		}
+#endif
+		if (!root.is_absolute())
+		{
+			std::error_code error{};
+			root = std::filesystem::temp_directory_path(error);
+		}
+		return root / name;
+	}
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+namespace UserCache
+{
+	std::filesystem::path getDirectory(std::string_view name);
+}
@@ -21,6 +21,7 @@ Window::Window()
 
 	glfwSetFramebufferSizeCallback(m_windowPtr, callbackWrapper<&Window::resizeCallback>);
 	glfwSetCursorPosCallback(m_windowPtr, callbackWrapper<&Window::cursorMovementCallback>);
+	glfwSetMouseButtonCallback(m_windowPtr, callbackWrapper<&Window::mouseButtonCallback>);
 	glfwSetScrollCallback(m_windowPtr, callbackWrapper<&Window::scrollCallback>);
 
 	gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress));
@@ -34,9 +35,10 @@ Window::~Window()
 	glfwTerminate();
 }
 
-void Window::init(Scene& scene)
+void Window::init(SplitView& splitView, LatencyTracker& latencyTracker)
 {
-	m_scene = &scene;
+	m_splitView = &splitView;
+	m_latencyTracker = &latencyTracker;
 }
 
 bool Window::shouldClose() const
@@ -59,6 +61,11 @@ const glm::ivec2& Window::viewportSize() const
 	return m_viewportSize;
 }
 
+void Window::setViewportSize(const glm::ivec2& viewportSize)
+{
+	glfwSetWindowSize(m_windowPtr, viewportSize.x + LeftPanel::width, viewportSize.y);
+}
+
 GLFWwindow* Window::getPtr()
 {
 	return m_windowPtr;
@@ -72,15 +79,18 @@ void Window::resizeCallback(int width, int height)
 	}
 
 	m_viewportSize = {width - LeftPanel::width, height};
-	m_scene->updateViewportSize();
+	m_splitView->updateViewportSize();
 	updateViewport();
 }
 
 void Window::cursorMovementCallback(double x, double y)
 {
+	LatencyTracker::Clock::time_point time = LatencyTracker::Clock::now();
 	glm::vec2 currPos{static_cast<float>(x), static_cast<float>(y)};
 	glm::vec2 offset = currPos - m_lastCursorPos;
 	m_lastCursorPos = currPos;
+	Scene& scene = m_splitView->getFocusedScene();
+	bool isCameraMoved = false;
 
 	if ((!isKeyPressed(GLFW_KEY_LEFT_SHIFT) &&
 		isButtonPressed(GLFW_MOUSE_BUTTON_MIDDLE))
@@ -89,8 +99,9 @@ void Window::cursorMovementCallback(double x, double y)
 		isButtonPressed(GLFW_MOUSE_BUTTON_LEFT)))
 	{
 		static constexpr float sensitivity = 0.002f;
-		m_scene->addPitchCamera(-sensitivity * offset.y);
-		m_scene->addYawCamera(sensitivity * offset.x);
+		scene.addPitchCamera(-sensitivity * offset.y);
+		scene.addYawCamera(sensitivity * offset.x);
+		isCameraMoved = true;
 	}
 
 	if ((isKeyPressed(GLFW_KEY_LEFT_SHIFT) &&
@@ -100,27 +111,45 @@ void Window::cursorMovementCallback(double x, double y)
 		isButtonPressed(GLFW_MOUSE_BUTTON_LEFT)))
 	{
 		static constexpr float sensitivity = 0.001f;
-		m_scene->moveXCamera(-sensitivity * offset.x);
-		m_scene->moveYCamera(sensitivity * offset.y);
+		scene.moveXCamera(-sensitivity * offset.x);
+		scene.moveYCamera(sensitivity * offset.y);
+		isCameraMoved = true;
 	}
 
 	if (isKeyPressed(GLFW_KEY_RIGHT_ALT) &&
 		isButtonPressed(GLFW_MOUSE_BUTTON_LEFT))
 	{
 		static constexpr float sensitivity = 1.005f;
-		m_scene->zoomCamera(std::pow(sensitivity, -offset.y));
+		scene.zoomCamera(std::pow(sensitivity, -offset.y));
+		isCameraMoved = true;
+	}
+
+	if (isCameraMoved)
+	{
+		recordInput(time);
+	}
+}
+
+void Window::mouseButtonCallback(int button, int action, int)
+{
+	if (action == GLFW_PRESS && button != GLFW_MOUSE_BUTTON_RIGHT && !isCursorInGUI())
+	{
+		focusViewAtCursor();
 	}
 }
 
 void Window::scrollCallback(double, double yOffset)
 {
+	LatencyTracker::Clock::time_point time = LatencyTracker::Clock::now();
 	if (isCursorInGUI())
 	{
 		return;
 	}
 
+	focusViewAtCursor();
 	static constexpr float sensitivity = 1.1f;
-	m_scene->zoomCamera(std::pow(sensitivity, static_cast<float>(yOffset)));
+	m_splitView->getFocusedScene().zoomCamera(std::pow(sensitivity, static_cast<float>(yOffset)));
+	recordInput(time);
 }
 
 void Window::updateViewport() const
@@ -151,3 +180,16 @@ bool Window::isCursorInGUI()
 	glm::vec2 cursorPos = getCursorPos();
 	return cursorPos.x <= LeftPanel::width;
 }
+
+void Window::focusViewAtCursor()
+{
+	m_splitView->focusAt(getCursorPos() - glm::vec2{LeftPanel::width, 0});
+}
+
+void Window::recordInput(LatencyTracker::Clock::time_point time)
+{
+	if (m_latencyTracker != nullptr)
+	{
+		m_latencyTracker->recordInput(time);
+	}
+}
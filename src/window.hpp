@@ -1,7 +1,8 @@
 #pragma once
 
 #include "gui/leftPanel.hpp"
-#include "scene.hpp"
+#include "latencyTracker.hpp"
+#include "splitView.hpp"
 
 #include <glad/glad.h>
 #include <glfw/glfw3.h>
@@ -13,12 +14,13 @@ public:
 	Window();
 	~Window();
 
-	void init(Scene& scene);
+	void init(SplitView& splitView, LatencyTracker& latencyTracker);
 	bool shouldClose() const;
 	void swapBuffers() const;
 	void pollEvents() const;
 
 	const glm::ivec2& viewportSize() const;
+	void setViewportSize(const glm::ivec2& viewportSize);
 	GLFWwindow* getPtr();
 
 private:
@@ -26,12 +28,14 @@ private:
 
 	GLFWwindow* m_windowPtr{};
 	glm::ivec2 m_viewportSize{m_initialSize - glm::ivec2{LeftPanel::width, 0}};
-	Scene* m_scene{};
+	SplitView* m_splitView{};
+	LatencyTracker* m_latencyTracker{};
 
 	glm::vec2 m_lastCursorPos{};
 
 	void resizeCallback(int width, int height);
 	void cursorMovementCallback(double x, double y);
+	void mouseButtonCallback(int button, int action, int);
 	void scrollCallback(double, double yOffset);
 
 	void updateViewport() const;
@@ -39,6 +43,8 @@ private:
 	bool isButtonPressed(int button);
 	bool isKeyPressed(int key);
 	bool isCursorInGUI();
+	void focusViewAtCursor();
+	void recordInput(LatencyTracker::Clock::time_point time);
 
 	template <auto callback, typename... Args>
 	static void callbackWrapper(GLFWwindow* windowPtr, Args... args);